@@ -0,0 +1,41 @@
+# coding: utf-8
+#
+# Objects allocated by enum getters and flag operators. Each returns an
+# interned frozen instance, so the counts should stay at about zero.
+#
+#   ruby -Ilib bench/enum_alloc.rb [times]
+#
+require 'gdiplus'
+require 'benchmark'
+
+include Gdiplus
+
+times = (ARGV[0] || 100_000).to_i
+
+bmp = Bitmap.new(16, 16)
+pen = Pen.new(Color.Red, 2)
+style = FontStyle.Bold
+
+allocated = lambda {|&block|
+  block.call # warm up: the first call of a value interns it
+  GC.disable
+  before = GC.stat(:total_allocated_objects)
+  t = Benchmark.realtime { times.times { block.call } }
+  n = GC.stat(:total_allocated_objects) - before
+  GC.enable
+  [n, t]
+}
+
+bmp.draw(keep_graphics: true) {|g|
+  g.SmoothingMode = SmoothingMode.AntiAlias
+  {
+    "Graphics#SmoothingMode" => lambda { g.SmoothingMode },
+    "Image#PixelFormat" => lambda { bmp.PixelFormat },
+    "Pen#LineJoin" => lambda { pen.LineJoin },
+    "FontStyle#|" => lambda { style | FontStyle.Italic },
+    "FontStyle#&" => lambda { style & FontStyle.Bold },
+  }.each {|name, getter|
+    n, t = allocated.call(&getter)
+    printf("%-24s %8d objects / %d calls  %.1f ns/call\n", name, n, times, t * 1e9 / times)
+  }
+}
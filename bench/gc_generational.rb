@@ -0,0 +1,51 @@
+# coding: utf-8
+#
+# Minor GC cost with many long-lived EncoderParameters, PathData and
+# ImageCodecInfo objects. Write-barrier unprotected (shady) objects stay in the
+# remembered set and are marked again in every minor GC; the count is shown
+# as remembered_wb_unprotected_objects.
+#
+#   ruby -Ilib bench/gc_generational.rb [objects] [minor_gcs]
+#
+require 'gdiplus'
+require 'benchmark'
+
+include Gdiplus
+
+count = (ARGV[0] || 100_000).to_i
+rounds = (ARGV[1] || 50).to_i
+
+path = GraphicsPath.new
+path.AddRectangle(Rectangle.new(0, 0, 10, 10))
+
+kept = Array.new(count) {|i|
+  case i % 3
+  when 0
+    prms = EncoderParameters.new
+    prms.add(EncoderParameter.new(Encoder.Quality, i % 100))
+    prms
+  when 1
+    path.PathData
+  else
+    codec = ImageCodecInfo.GetImageEncoders.first
+    codec.FilenameExtension
+    codec
+  end
+}
+3.times { GC.start }
+
+stat = GC.stat
+puts "old_objects:                        #{stat[:old_objects]}"
+puts "remembered_wb_unprotected_objects:  #{stat[:remembered_wb_unprotected_objects]}"
+
+GC::Profiler.enable
+GC::Profiler.clear
+t = Benchmark.realtime {
+  rounds.times {
+    GC.start(full_mark: false)
+  }
+}
+total = GC::Profiler.total_time
+GC::Profiler.disable
+printf("minor GC: %.3f ms/GC (wall %.3f ms/GC)\n", total * 1000 / rounds, t * 1000 / rounds)
+kept.size
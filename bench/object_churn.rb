@@ -0,0 +1,47 @@
+# coding: utf-8
+#
+# Create-and-dispose throughput of small GDI+ objects, to compare a release
+# build with a debug or trace build (rake compile -- --enable-debug).
+# With LIBDIRs, each is run in its own process, e.g. two copies of lib/
+# compiled with different options; otherwise the current build is measured.
+# A trace build is measured with the trace points off and on.
+#
+#   ruby -Ilib bench/object_churn.rb [times] [LIBDIR ...]
+#
+require 'rbconfig'
+
+times = (ARGV.shift || 100_000).to_i
+
+unless ARGV.empty?
+  ruby = File.join(RbConfig::CONFIG['bindir'], RbConfig::CONFIG['ruby_install_name'])
+  ARGV.each {|libdir|
+    puts "== #{libdir}"
+    system(ruby, '-I', libdir, __FILE__, times.to_s)
+  }
+  exit
+end
+
+require 'gdiplus'
+require 'benchmark'
+
+include Gdiplus
+
+churn = lambda {
+  times.times {
+    Pen.new(Color.Red, 1.0).dispose
+    Matrix.new.dispose
+    PointF.new(1.0, 2.0)
+    GraphicsPath.new.dispose
+  }
+}
+
+churn.call # warm up: starts GDI+
+build = Gdiplus::DEBUG_BUILD ? "debug" : Gdiplus::TRACE_BUILD ? "trace" : "release"
+modes = Gdiplus::TRACE_BUILD ? [false, true] : [false]
+modes.each {|trace|
+  Gdiplus.trace = trace
+  GC.start
+  t = Benchmark.realtime { churn.call }
+  Gdiplus.trace = false
+  printf("%-8s trace %-5s %8.3f s  %10.0f objects/s\n", build, trace, t, times * 4 / t)
+}
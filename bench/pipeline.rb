@@ -0,0 +1,54 @@
+# coding: utf-8
+#
+# Thumbnails of many files with Pipeline.thumbnail compared with the same
+# decode, DrawImage and save sequence written in Ruby on one thread.
+#
+#   ruby -Ilib bench/pipeline.rb [files] [threads]
+#
+require 'gdiplus'
+require 'benchmark'
+require 'tmpdir'
+
+include Gdiplus
+
+files = (ARGV[0] || 32).to_i
+threads = ARGV[1] && ARGV[1].to_i
+
+Dir.mktmpdir {|dir|
+  src = Bitmap.new(2400, 1600)
+  src.draw {|g|
+    g.Clear(Color.White)
+    0.step(2400, 40) {|x| g.DrawLine(Pen.new(Color.Blue, 3), x, 0, 2400 - x, 1600) }
+  }
+  inputs = Array.new(files) {|i|
+    path = File.join(dir, "src#{i}.jpg")
+    src.save(path)
+    [path, File.join(dir, "thumb#{i}.jpg")]
+  }
+
+  encprms = EncoderParameters.new
+  encprms.add(EncoderParameter.new(Encoder.Quality, 80))
+  t_ruby = Benchmark.realtime {
+    inputs.each {|path, out|
+      bmp = Bitmap.new(path)
+      dst = Bitmap.new(240, 160)
+      dst.draw {|g|
+        g.InterpolationMode = InterpolationMode.HighQualityBicubic
+        g.DrawImage(bmp, Rectangle.new(0, 0, 240, 160), Rectangle.new(0, 0, bmp.Width, bmp.Height), GraphicsUnit.Pixel)
+      }
+      dst.save(out, encprms)
+    }
+  }
+
+  results = nil
+  t_pipe = Benchmark.realtime {
+    results = Pipeline.thumbnail(inputs, size: 240, quality: 80, threads: threads)
+  }
+  failed = results.count {|r| !r.ok? }
+
+  printf("ruby loop: %8.2f images/s\n", files / t_ruby)
+  printf("pipeline:  %8.2f images/s  x%.2f  (failed: %d)\n", files / t_pipe, t_ruby / t_pipe, failed)
+  %w(decode_time resize_time encode_time).each {|m|
+    printf("  %-12s %8.2f ms/image\n", m, results.inject(0.0) {|s, r| s + r.send(m) } * 1000 / files)
+  }
+}
@@ -0,0 +1,62 @@
+# coding: utf-8
+#
+# Bitmap#grayscale! and friends against the same transform done with
+# ImageAttributes + DrawImage.
+#
+#   ruby -Ilib bench/pixel_ops.rb [width] [height] [times]
+#
+require 'gdiplus'
+require 'benchmark'
+
+include Gdiplus
+
+width = (ARGV[0] || 1920).to_i
+height = (ARGV[1] || 1080).to_i
+times = (ARGV[2] || 20).to_i
+
+src = Bitmap.new(width, height)
+src.draw {|g|
+  g.Clear(Color.White)
+  0.step(width, 20) {|x| g.DrawLine(Pen.new(Color.new(200, x % 256, 80, 160), 5), x, 0, width - x, height) }
+}
+src_bytes = src.to_blob(ImageFormat.Png)
+
+kr, kg, kb = 0.299, 0.587, 0.114
+gray = ColorMatrix.new([
+  kr, kr, kr, 0.0, 0.0,
+  kg, kg, kg, 0.0, 0.0,
+  kb, kb, kb, 0.0, 0.0,
+  0.0, 0.0, 0.0, 1.0, 0.0,
+  0.0, 0.0, 0.0, 0.0, 1.0,
+])
+
+draw_image = lambda {|&setup|
+  attrs = ImageAttributes.new
+  setup.call(attrs)
+  bmp = Bitmap.new(width, height)
+  bmp.draw {|g|
+    g.DrawImageRectRect(src, Rectangle.new(0, 0, width, height), 0, 0, width, height, GraphicsUnit.Pixel, attrs)
+  }
+}
+
+cases = [
+  ['grayscale',    lambda { Bitmap.from_bytes(src_bytes).grayscale! },
+                   lambda { draw_image.call {|a| a.SetColorMatrix(gray) } }],
+  ['color_matrix', lambda { Bitmap.from_bytes(src_bytes).apply_color_matrix!(gray) },
+                   lambda { draw_image.call {|a| a.SetColorMatrix(gray) } }],
+  ['gamma',        lambda { Bitmap.from_bytes(src_bytes).gamma!(2.2) },
+                   lambda { draw_image.call {|a| a.SetGamma(2.2) } }],
+  ['threshold',    lambda { Bitmap.from_bytes(src_bytes).threshold!(0.5) },
+                   lambda { draw_image.call {|a| a.SetThreshold(0.5) } }],
+  ['remap',        lambda { Bitmap.from_bytes(src_bytes).remap!(Color.White => Color.Black) },
+                   lambda { draw_image.call {|a| a.SetRemapTable(Color.White => Color.Black) } }],
+]
+
+puts "#{width}x#{height}, #{times} times, kernels: #{Bitmap::PixelKernels}"
+cases.each {|name, native, attrs|
+  native.call
+  attrs.call
+  t1 = Benchmark.realtime { times.times { native.call } }
+  t2 = Benchmark.realtime { times.times { attrs.call } }
+  printf("%-13s native: %8.2f ms  ImageAttributes: %8.2f ms  x%.2f\n", name, t1 * 1000 / times, t2 * 1000 / times, t2 / t1)
+}
@@ -0,0 +1,42 @@
+# coding: utf-8
+#
+# Cost of `require 'gdiplus'` in a fresh process: wall time, objects
+# allocated while loading, and the singleton methods and constants that
+# exist right after loading (LangId and Color define theirs on first use).
+# Gdiplus.init_profile of the fastest run breaks the time down by Init_*.
+#
+#   ruby -Ilib bench/startup.rb [times]
+#
+require 'rbconfig'
+
+times = (ARGV[0] || 10).to_i
+ruby = File.join(RbConfig::CONFIG['bindir'], RbConfig::CONFIG['ruby_install_name'])
+libdir = File.expand_path('../lib', __dir__)
+
+script = <<'EOS'
+GC.disable
+t = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+before = GC.stat(:total_allocated_objects)
+require 'gdiplus'
+n = GC.stat(:total_allocated_objects) - before
+t = Process.clock_gettime(Process::CLOCK_MONOTONIC) - t
+puts [t, n, Gdiplus::LangId.singleton_methods(false).size, Gdiplus::Color.constants(false).size].join(' ')
+Gdiplus.init_profile.each {|name, prof| puts [name, prof[:usec], prof[:objects]].join(' ') }
+EOS
+
+runs = Array.new(times) {
+  lines = IO.popen([ruby, '-I', libdir, '-e', script], &:read).lines
+  [lines.shift.split.map(&:to_f), lines.map(&:split)]
+}
+results = runs.map(&:first)
+
+best = results.min_by(&:first)
+printf("require 'gdiplus'  best %.2f ms  avg %.2f ms  (%d runs)\n",
+       best[0] * 1000, results.inject(0) {|s, r| s + r[0] } / times * 1000, times)
+printf("allocated objects  %d\n", best[1])
+printf("LangId singleton methods  %d\n", best[2])
+printf("Color constants  %d\n", best[3])
+puts
+runs.assoc(best)[1].each {|name, usec, objects|
+  printf("  %-20s %10.1f us %8d objects\n", name, usec.to_f, objects.to_i)
+}
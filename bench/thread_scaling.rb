@@ -0,0 +1,51 @@
+# coding: utf-8
+#
+# Throughput of resize + JPEG encode with 1..N threads.
+# DrawImage, Save and Bitmap loading run without the GVL, so the rate should
+# grow with the number of threads up to the number of cores.
+#
+#   ruby -Ilib bench/thread_scaling.rb [max_threads] [jobs]
+#
+require 'gdiplus'
+require 'benchmark'
+
+include Gdiplus
+
+max_threads = (ARGV[0] || 8).to_i
+jobs = (ARGV[1] || 64).to_i
+
+src = Bitmap.new(2400, 1600)
+src.draw {|g|
+  g.Clear(Color.White)
+  0.step(2400, 40) {|x| g.DrawLine(Pen.new(Color.Blue, 3), x, 0, 2400 - x, 1600) }
+}
+src_bytes = src.to_blob(ImageFormat.Png)
+
+job = lambda {
+  bmp = Bitmap.from_bytes(src_bytes)
+  dst = Bitmap.new(600, 400)
+  dst.draw {|g|
+    g.InterpolationMode = InterpolationMode.HighQualityBicubic
+    g.DrawImage(bmp, Rectangle.new(0, 0, 600, 400), Rectangle.new(0, 0, 2400, 1600), GraphicsUnit.Pixel)
+  }
+  dst.to_blob(ImageFormat.Jpeg)
+}
+
+job.call # warm up
+
+base = nil
+threads = 1
+while threads <= max_threads
+  queue = Queue.new
+  jobs.times { queue << true }
+  threads.times { queue << nil }
+  t = Benchmark.realtime {
+    Array.new(threads) {
+      Thread.new { job.call while queue.pop }
+    }.each(&:join)
+  }
+  rate = jobs / t
+  base ||= rate
+  printf("threads: %2d  %8.2f images/s  x%.2f\n", threads, rate, rate / base)
+  threads *= 2
+end
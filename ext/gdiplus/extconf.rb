@@ -6,12 +6,23 @@ RUBY_VERSION_NUM = versions[0] * 10000 + versions[1] * 100 + versions[2]
 
 have_library('gdiplus')
 have_library('Rpcrt4')
+have_library('ole32')
 
-gdiplus_debug = true ### check before release ###
+# release build by default.
+#   --enable-debug: dp() messages and the trace points
+#   --enable-trace: only the trace points (Gdiplus.trace = true to report them)
+gdiplus_debug = enable_config('debug', false)
+gdiplus_trace = enable_config('trace', gdiplus_debug)
 
 if gdiplus_debug
   $defs << "-DGDIPLUS_DEBUG=1"
 end
+$defs << (gdiplus_trace ? "-DGDIPLUS_TRACE=1" : "-DGDIPLUS_TRACE=0")
+
+# pixel kernels of gdip_pixel_ops.cpp: SSE2 by default on x64, AVX2 with --enable-avx2
+if enable_config('avx2', false)
+  $CXXFLAGS += $mswin ? " /arch:AVX2 " : " -mavx2 "
+end
 
 if $mswin
   $defs << "-DGDIPVER=0x0110"
@@ -4,17 +4,185 @@
  * Released under the MIT License.
  */
 #include "ruby_gdiplus.h"
+#include "gdip_stream.h"
+#if RUBY_API_VERSION_CODE >= 30100
+#include <ruby/io/buffer.h>
+#endif
 
 const rb_data_type_t tBitmap = _MAKE_DATA_TYPE(
-    "Bitmap", 0, GDIP_OBJ_FREE(Bitmap *), NULL, &tImage, &cBitmap);
+    "Bitmap", 0, GDIP_OBJ_FREE(Bitmap *), GDIP_OBJ_MEMSIZE(Bitmap *), &tImage, &cBitmap);
+
+struct gdipBitmapData {
+    BitmapData data;
+    UINT mode;
+    VALUE v_bitmap; // Qnil after UnlockBits
+    VALUE v_buffer;
+    VALUE v_finalizer; // set with v_buffer
+};
+
+static void
+gdip_bmpdata_mark(gdipBitmapData *bmpdata)
+{
+    if (bmpdata != NULL) {
+        _rb_gc_mark_movable(bmpdata->v_bitmap);
+        _rb_gc_mark_movable(bmpdata->v_buffer);
+        _rb_gc_mark_movable(bmpdata->v_finalizer);
+    }
+}
+
+static void
+gdip_bmpdata_compact(gdipBitmapData *bmpdata)
+{
+    if (bmpdata != NULL) {
+        bmpdata->v_bitmap = _rb_gc_location(bmpdata->v_bitmap);
+        bmpdata->v_buffer = _rb_gc_location(bmpdata->v_buffer);
+        bmpdata->v_finalizer = _rb_gc_location(bmpdata->v_finalizer);
+    }
+}
+
+/*
+ * A BitmapData collected while still locked unlocks its Bitmap, unless the
+ * Bitmap has already been deleted (in the same GC, gdip_use_target is NULL then).
+ * If it has handed out an IO::Buffer, the buffer may still be reachable, so
+ * its finalizer frees the buffer and unlocks the Bitmap afterwards instead.
+ */
+static void
+gdip_bmpdata_free(gdipBitmapData *bmpdata)
+{
+    GDIP_TRACE(TraceFree, type_name<gdipBitmapData>(), bmpdata);
+    if (gdip_uses_len > 0) {
+        Bitmap *bmp = static_cast<Bitmap *>(gdip_use_target(bmpdata));
+        if (bmp != NULL && bmpdata->data.Scan0 != NULL && RB_NIL_P(bmpdata->v_finalizer)) {
+            bmp->UnlockBits(&bmpdata->data);
+        }
+        gdip_use_forget(bmpdata);
+    }
+    ruby_xfree(bmpdata);
+}
+
+const rb_data_type_t tBitmapData = _MAKE_DATA_TYPE_MOVABLE(
+    "BitmapData", RUBY_DATA_FUNC(gdip_bmpdata_mark), RUBY_DATA_FUNC(gdip_bmpdata_free), &typeddata_size<gdipBitmapData>,
+    RUBY_DATA_FUNC(gdip_bmpdata_compact), NULL, &cBitmapData);
+
+#if RUBY_API_VERSION_CODE >= 30100
+/*
+ * The finalizer of a BitmapData that has handed out an IO::Buffer.
+ * It keeps the Bitmap and the buffer alive, and is attached as a user of
+ * the Bitmap so that the Bitmap cannot be disposed while it is locked.
+ */
+struct gdipBitmapDataFinalizer {
+    BitmapData data;
+    VALUE v_bitmap; // Qnil when disarmed
+    VALUE v_buffer;
+};
+
+static VALUE cBitmapDataFinalizer;
+
+static void
+gdip_bmpdata_fin_mark(gdipBitmapDataFinalizer *fin)
+{
+    if (fin != NULL) {
+        _rb_gc_mark_movable(fin->v_bitmap);
+        _rb_gc_mark_movable(fin->v_buffer);
+    }
+}
+
+static void
+gdip_bmpdata_fin_compact(gdipBitmapDataFinalizer *fin)
+{
+    if (fin != NULL) {
+        fin->v_bitmap = _rb_gc_location(fin->v_bitmap);
+        fin->v_buffer = _rb_gc_location(fin->v_buffer);
+    }
+}
+
+static void
+gdip_bmpdata_fin_free(gdipBitmapDataFinalizer *fin)
+{
+    GDIP_TRACE(TraceFree, type_name<gdipBitmapDataFinalizer>(), fin);
+    if (gdip_uses_len > 0) gdip_use_forget(fin);
+    ruby_xfree(fin);
+}
+
+static const rb_data_type_t tBitmapDataFinalizer = _MAKE_DATA_TYPE_MOVABLE(
+    "BitmapDataFinalizer", RUBY_DATA_FUNC(gdip_bmpdata_fin_mark), RUBY_DATA_FUNC(gdip_bmpdata_fin_free), &typeddata_size<gdipBitmapDataFinalizer>,
+    RUBY_DATA_FUNC(gdip_bmpdata_fin_compact), NULL, &cBitmapDataFinalizer);
+
+static void
+gdip_bmpdata_fin_disarm(gdipBitmapDataFinalizer *fin)
+{
+    gdip_use_forget(fin);
+    fin->v_bitmap = Qnil;
+    fin->v_buffer = Qnil;
+}
+
+/* Frees the buffer before the pixels it points to are unlocked. */
+static VALUE
+gdip_bmpdata_fin_call(VALUE self, VALUE objid)
+{
+    gdipBitmapDataFinalizer *fin = Data_Ptr<gdipBitmapDataFinalizer *>(self);
+    if (RB_NIL_P(fin->v_bitmap)) return Qnil;
+    rb_io_buffer_free(fin->v_buffer);
+    Bitmap *bmp = Data_Ptr<Bitmap *>(fin->v_bitmap);
+    if (bmp != NULL) {
+        bmp->UnlockBits(&fin->data);
+    }
+    gdip_bmpdata_fin_disarm(fin);
+    return Qnil;
+}
+#endif
 
 static Bitmap *
 gdip_bitmap_init_from_file(VALUE filename, BOOL use_ecm=FALSE)
 {
     VALUE wstr = util_utf16_str_new(filename);
-    Bitmap *bmp = gdip_obj_create<Bitmap *>(new Bitmap(RString_Ptr<WCHAR *>(wstr), use_ecm));
+    WCHAR *path = RString_Ptr<WCHAR *>(wstr);
+    Bitmap *bmp = NULL;
+    gdip_call_without_gvl([&]() { bmp = new Bitmap(path, use_ecm); return bmp != NULL ? bmp->GetLastStatus() : OutOfMemory; }, NULL);
     RB_GC_GUARD(wstr);
-    return bmp;
+    return gdip_obj_create<Bitmap *>(bmp);
+}
+
+/*
+ * The bitmap decodes lazily from the stream, so the bytes are kept in a hidden
+ * instance variable of +self+ for the lifetime of the bitmap.
+ */
+static Bitmap *
+gdip_bitmap_init_from_bytes(VALUE self, VALUE str, BOOL use_ecm=FALSE)
+{
+    VALUE src = rb_str_new_frozen(str);
+    rb_ivar_set(self, rb_intern("__gdip_source__"), src);
+    MemoryStream *stream;
+#if RUBY_API_VERSION_CODE >= 20700
+    if (!RB_FL_TEST(src, RSTRING_NOEMBED)) {
+        stream = MemoryStream::copy_of(RSTRING_PTR(src), static_cast<ULONG>(RSTRING_LEN(src)));
+    }
+    else
+#endif
+    {
+        stream = new MemoryStream(RSTRING_PTR(src), static_cast<ULONG>(RSTRING_LEN(src)));
+    }
+    Bitmap *bmp = NULL;
+    gdip_call_without_gvl([&]() { bmp = new Bitmap(stream, use_ecm); return bmp != NULL ? bmp->GetLastStatus() : OutOfMemory; }, NULL);
+    stream->Release();
+    RB_GC_GUARD(src);
+    return gdip_obj_create(bmp);
+}
+
+static inline bool
+gdip_bitmap_io_p(VALUE v)
+{
+    return RB_TYPE_P(v, RUBY_T_FILE) || (!_RB_STRING_P(v) && rb_respond_to(v, rb_intern("read")));
+}
+
+static Bitmap *
+gdip_bitmap_init_from_io(VALUE self, VALUE io, BOOL use_ecm=FALSE)
+{
+    VALUE str = rb_funcall(io, rb_intern("read"), 0);
+    if (!_RB_STRING_P(str)) {
+        rb_raise(rb_eTypeError, "The stream returned no data.");
+    }
+    return gdip_bitmap_init_from_bytes(self, str, use_ecm);
 }
 
 static Bitmap *
@@ -26,7 +194,9 @@ gdip_bitmap_init_by_size(VALUE width, VALUE height, VALUE format=Qnil)
     if (!RB_NIL_P(format)) {
         gdip_arg_to_enumint(cPixelFormat, format, &fmt, "The third argument should be PixelFormat.");
     }
-    return gdip_obj_create(new Bitmap(w, h, fmt));
+    Bitmap *bmp = NULL;
+    gdip_call([&]() { bmp = new Bitmap(w, h, fmt); return bmp != NULL ? bmp->GetLastStatus() : OutOfMemory; });
+    return gdip_obj_create(bmp);
 }
 
 static VALUE
@@ -41,6 +211,9 @@ gdip_bitmap_create_by_size(VALUE width, VALUE height, VALUE format=Qnil)
  * @overload initialize(filename, use_ecm=false)
  *   @param filename [String] File name.
  *   @param use_ecm [Boolean] whether to use embedded color management.
+ * @overload initialize(io, use_ecm=false)
+ *   @param io [IO] An object that responds to +read+. The whole stream is read and decoded in memory.
+ *   @param use_ecm [Boolean] whether to use embedded color management.
  * @overload initialize(width, height, format=PixelFormat::Format32bppARGB)
  *   @param width [Integer]
  *   @param height [Integer]
@@ -65,8 +238,8 @@ gdip_bitmap_init(int argc, VALUE *argv, VALUE self)
         if (RB_TYPE_P(argv[0], RUBY_T_STRING)) {
             _DATA_PTR(self) = gdip_bitmap_init_from_file(argv[0]);
         }
-        else if (RB_TYPE_P(argv[0], RUBY_T_FILE)) {
-            NOT_IMPLEMENTED_ERROR;
+        else if (gdip_bitmap_io_p(argv[0])) {
+            _DATA_PTR(self) = gdip_bitmap_init_from_io(self, argv[0]);
         }
         else {
             rb_raise(rb_eArgError, "wrong arguments");
@@ -76,8 +249,8 @@ gdip_bitmap_init(int argc, VALUE *argv, VALUE self)
         if (RB_TYPE_P(argv[0], RUBY_T_STRING)) {
             _DATA_PTR(self) = gdip_bitmap_init_from_file(argv[0], RB_TEST(argv[1]));
         }
-        else if (RB_TYPE_P(argv[0], RUBY_T_FILE)) {
-            NOT_IMPLEMENTED_ERROR;
+        else if (gdip_bitmap_io_p(argv[0])) {
+            _DATA_PTR(self) = gdip_bitmap_init_from_io(self, argv[0], RB_TEST(argv[1]));
         }
         else if (Integer_p(argv[0], argv[1])) {
             _DATA_PTR(self) = gdip_bitmap_init_by_size(argv[0], argv[1]);
@@ -93,10 +266,484 @@ gdip_bitmap_init(int argc, VALUE *argv, VALUE self)
     return self;
 }
 
+/**
+ * Creates a Bitmap from encoded image data (BMP, GIF, JPEG, PNG, TIFF, ...) in memory.
+ * The bytes are read in place, without a temporary file or a copy.
+ * @param bytes [String] Encoded image data.
+ * @param use_ecm [Boolean] whether to use embedded color management.
+ * @return [Bitmap]
+ * @example
+ *   bmp = Gdiplus::Bitmap.from_bytes(response.body)
+ */
+static VALUE
+gdip_bitmap_s_from_bytes(int argc, VALUE *argv, VALUE klass)
+{
+    VALUE v_bytes, v_use_ecm;
+    rb_scan_args(argc, argv, "11", &v_bytes, &v_use_ecm);
+    StringValue(v_bytes);
+    VALUE r = typeddata_alloc_null<&tBitmap>(klass);
+    _DATA_PTR(r) = gdip_bitmap_init_from_bytes(r, v_bytes, RB_TEST(v_use_ecm));
+    return r;
+}
+
+static Status
+gdip_bmpdata_unlock(Bitmap *bmp, VALUE v_bmpdata)
+{
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(v_bmpdata);
+#if RUBY_API_VERSION_CODE >= 30100
+    if (!RB_NIL_P(bmpdata->v_buffer)) {
+        rb_io_buffer_free(bmpdata->v_buffer);
+        bmpdata->v_buffer = Qnil;
+    }
+    if (!RB_NIL_P(bmpdata->v_finalizer)) {
+        gdip_bmpdata_fin_disarm(Data_Ptr<gdipBitmapDataFinalizer *>(bmpdata->v_finalizer));
+        rb_undefine_finalizer(v_bmpdata);
+        bmpdata->v_finalizer = Qnil;
+    }
+#endif
+    Status status = bmp->UnlockBits(&bmpdata->data);
+    gdip_use_forget(bmpdata);
+    bmpdata->v_bitmap = Qnil;
+    bmpdata->data.Scan0 = NULL;
+    return status;
+}
+
+/**
+ * Unlocks the pixels locked by {#LockBits}.
+ * Views obtained from the BitmapData must not be used after this call.
+ * @param bmpdata [BitmapData] The return value of {#LockBits}.
+ * @return [self]
+ */
+static VALUE
+gdip_bitmap_unlock_bits(VALUE self, VALUE v_bmpdata)
+{
+    Bitmap *bmp = Data_Ptr<Bitmap *>(self);
+    Check_NULL(bmp, "The Bitmap object does not exist.");
+    if (!_KIND_OF(v_bmpdata, &tBitmapData)) {
+        rb_raise(rb_eTypeError, "The argument should be BitmapData.");
+    }
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(v_bmpdata);
+    if (bmpdata->v_bitmap != self) {
+        rb_raise(eGdiplus, "The BitmapData is not locked by this Bitmap.");
+    }
+    Status status = gdip_bmpdata_unlock(bmp, v_bmpdata);
+    Check_Status(status);
+    return self;
+}
+
+/**
+ * Locks a rectangular portion of this bitmap and gives direct access to its pixels.
+ * @overload LockBits(rect, flags, format)
+ *   @param rect [Rectangle or nil] The portion to lock. nil means the whole bitmap.
+ *   @param flags [ImageLockMode]
+ *   @param format [PixelFormat]
+ *   @return [BitmapData] Call {#UnlockBits} when finished.
+ * @overload LockBits(rect, flags, format) {|bmpdata| ... }
+ *   The pixels are unlocked when the block exits.
+ *   @yieldparam bmpdata [BitmapData]
+ *   @return [Object] The value of the block.
+ * @example
+ *   bmp = Gdiplus::Bitmap.new(100, 100)
+ *   bmp.LockBits(nil, ImageLockMode.ReadOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+ *     argb = bmpdata.bytes.unpack("V*") # bytes is a copy of Stride * Height bytes
+ *   }
+ */
+static VALUE
+gdip_bitmap_lock_bits(VALUE self, VALUE v_rect, VALUE v_flags, VALUE v_format)
+{
+    Bitmap *bmp = Data_Ptr<Bitmap *>(self);
+    Check_NULL(bmp, "The Bitmap object does not exist.");
+
+    Rect rect(0, 0, bmp->GetWidth(), bmp->GetHeight());
+    if (_KIND_OF(v_rect, &tRectangle)) {
+        rect = *Data_Ptr<Rect *>(v_rect);
+    }
+    else if (!RB_NIL_P(v_rect)) {
+        rb_raise(rb_eTypeError, "The first argument should be Rectangle.");
+    }
+    int flags = 0;
+    gdip_arg_to_enumint(cImageLockMode, v_flags, &flags, "The second argument should be ImageLockMode.");
+    if (flags & ImageLockModeUserInputBuf) {
+        rb_raise(rb_eArgError, "ImageLockMode.UserInputBuffer is not supported.");
+    }
+    PixelFormat format = PixelFormat32bppARGB;
+    gdip_arg_to_enumint(cPixelFormat, v_format, &format, "The third argument should be PixelFormat.");
+
+    VALUE r = typeddata_alloc<gdipBitmapData, &tBitmapData>(cBitmapData);
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(r);
+    RB_OBJ_WRITE(r, &bmpdata->v_bitmap, Qnil);
+    RB_OBJ_WRITE(r, &bmpdata->v_buffer, Qnil);
+    RB_OBJ_WRITE(r, &bmpdata->v_finalizer, Qnil);
+    bmpdata->mode = flags;
+    Status status = bmp->LockBits(&rect, flags, format, &bmpdata->data);
+    Check_Status(status);
+    RB_OBJ_WRITE(r, &bmpdata->v_bitmap, self);
+    gdip_use_attach(bmpdata, bmp);
+
+    if (rb_block_given_p()) {
+        return _rb_ensure(
+            [&]() -> VALUE { return rb_yield(r); },
+            [&]() -> VALUE {
+                if (bmpdata->v_bitmap == self) {
+                    gdip_bmpdata_unlock(bmp, r);
+                }
+                return Qnil;
+            });
+    }
+    return r;
+}
+
+static inline gdipBitmapData *
+gdip_bmpdata_get_locked(VALUE self)
+{
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(self);
+    if (RB_NIL_P(bmpdata->v_bitmap)) {
+        rb_raise(eGdiplus, "The BitmapData is already unlocked.");
+    }
+    if (Data_Ptr<Bitmap *>(bmpdata->v_bitmap) == NULL) {
+        rb_raise(eGdiplus, "The Bitmap object does not exist.");
+    }
+    return bmpdata;
+}
+
+/* Returns the first byte of the locked memory and its length. */
+static BYTE *
+gdip_bmpdata_memory(gdipBitmapData *bmpdata, long& len)
+{
+    BitmapData& data = bmpdata->data;
+    long stride = data.Stride < 0 ? -data.Stride : data.Stride;
+    len = stride * static_cast<long>(data.Height);
+    BYTE *head = static_cast<BYTE *>(data.Scan0);
+    if (data.Stride < 0 && data.Height > 0) {
+        head += static_cast<long>(data.Stride) * (data.Height - 1);
+    }
+    return head;
+}
+
+/**
+ * Gets the width of the locked area in pixels.
+ * @return [Integer]
+ */
+static VALUE
+gdip_bmpdata_get_width(VALUE self)
+{
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(self);
+    return RB_UINT2NUM(bmpdata->data.Width);
+}
+
+/**
+ * Gets the height of the locked area in pixels.
+ * @return [Integer]
+ */
+static VALUE
+gdip_bmpdata_get_height(VALUE self)
+{
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(self);
+    return RB_UINT2NUM(bmpdata->data.Height);
+}
+
+/**
+ * Gets the byte offset between the beginnings of two consecutive scan lines.
+ * A negative value means a bottom-up bitmap.
+ * @return [Integer]
+ */
+static VALUE
+gdip_bmpdata_get_stride(VALUE self)
+{
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(self);
+    return RB_INT2NUM(bmpdata->data.Stride);
+}
+
+/**
+ * Gets the PixelFormat of the locked pixels.
+ * @return [PixelFormat]
+ */
+static VALUE
+gdip_bmpdata_get_pixel_format(VALUE self)
+{
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(self);
+    return gdip_enumint_create(cPixelFormat, bmpdata->data.PixelFormat);
+}
+
+/**
+ * Gets the address of the first scan line.
+ * @return [Integer]
+ */
+static VALUE
+gdip_bmpdata_get_scan0(VALUE self)
+{
+    gdipBitmapData *bmpdata = gdip_bmpdata_get_locked(self);
+    return _RB_ID2NUM(reinterpret_cast<UINT_PTR>(bmpdata->data.Scan0));
+}
+
+/**
+ * Whether the pixels are still locked.
+ * @return [Boolean]
+ */
+static VALUE
+gdip_bmpdata_locked_p(VALUE self)
+{
+    gdipBitmapData *bmpdata = Data_Ptr<gdipBitmapData *>(self);
+    return RB_NIL_P(bmpdata->v_bitmap) ? Qfalse : Qtrue;
+}
+
+/**
+ * Returns a copy of the locked pixels.
+ * Use {#buffer} on Ruby 3.1 or later to read them without copying.
+ * @return [String] Stride * Height bytes (ASCII-8BIT).
+ */
+static VALUE
+gdip_bmpdata_get_bytes(VALUE self)
+{
+    gdipBitmapData *bmpdata = gdip_bmpdata_get_locked(self);
+    long len = 0;
+    BYTE *head = gdip_bmpdata_memory(bmpdata, len);
+    return rb_str_new(reinterpret_cast<const char *>(head), len);
+}
+
+#if RUBY_API_VERSION_CODE >= 30100
+/**
+ * Returns an IO::Buffer over the locked pixels (Ruby 3.1 or later).
+ * The buffer is read-only unless the pixels are locked with ImageLockMode.WriteOnly or ReadWrite.
+ * It is freed by {Bitmap#UnlockBits}, or when this BitmapData is garbage collected.
+ * @return [IO::Buffer]
+ */
+static VALUE
+gdip_bmpdata_get_buffer(VALUE self)
+{
+    gdipBitmapData *bmpdata = gdip_bmpdata_get_locked(self);
+    if (RB_NIL_P(bmpdata->v_buffer)) {
+        long len = 0;
+        BYTE *head = gdip_bmpdata_memory(bmpdata, len);
+        int flags = RB_IO_BUFFER_EXTERNAL;
+        if ((bmpdata->mode & ImageLockModeWrite) == 0) {
+            flags |= RB_IO_BUFFER_READONLY;
+        }
+        VALUE v_buffer = rb_io_buffer_new(head, len, static_cast<enum rb_io_buffer_flags>(flags));
+        VALUE v_fin = typeddata_alloc<gdipBitmapDataFinalizer, &tBitmapDataFinalizer>();
+        gdipBitmapDataFinalizer *fin = Data_Ptr<gdipBitmapDataFinalizer *>(v_fin);
+        fin->data = bmpdata->data;
+        RB_OBJ_WRITE(v_fin, &fin->v_bitmap, bmpdata->v_bitmap);
+        RB_OBJ_WRITE(v_fin, &fin->v_buffer, v_buffer);
+        gdip_use_attach(fin, Data_Ptr<Bitmap *>(bmpdata->v_bitmap));
+        rb_define_finalizer(self, v_fin);
+        RB_OBJ_WRITE(self, &bmpdata->v_buffer, v_buffer);
+        RB_OBJ_WRITE(self, &bmpdata->v_finalizer, v_fin);
+    }
+    return bmpdata->v_buffer;
+}
+#endif
+
+/**
+ * Copies bytes into the locked pixels.
+ * @param offset [Integer] Byte offset from the first byte of the locked memory.
+ * @param str [String]
+ * @return [self]
+ */
+static VALUE
+gdip_bmpdata_write(VALUE self, VALUE offset, VALUE str)
+{
+    gdipBitmapData *bmpdata = gdip_bmpdata_get_locked(self);
+    if ((bmpdata->mode & ImageLockModeWrite) == 0) {
+        rb_raise(eGdiplus, "The BitmapData is locked as read-only.");
+    }
+    long ofs = RB_NUM2LONG(offset);
+    StringValue(str);
+    long len = 0;
+    BYTE *head = gdip_bmpdata_memory(bmpdata, len);
+    if (ofs < 0 || ofs > len || RSTRING_LEN(str) > len - ofs) {
+        rb_raise(rb_eIndexError, "out of the locked memory");
+    }
+    memcpy(head + ofs, RSTRING_PTR(str), RSTRING_LEN(str));
+    return self;
+}
+
+/*
+ * A horizontal band of the destination of gdip_bitmap_resize.
+ * Every band wraps the locked pixels in its own source and destination Bitmap,
+ * since GDI+ refuses to use one Image from several threads at once.
+ */
+struct gdipResizeBand {
+    BitmapData *src;
+    BitmapData *dst;
+    INT y0;
+    INT y1;
+    InterpolationMode mode;
+    Status status;
+};
+
+static Status
+gdip_resize_band(gdipResizeBand *band)
+{
+    BitmapData *src = band->src;
+    BitmapData *dst = band->dst;
+    Bitmap src_bmp(src->Width, src->Height, src->Stride, PixelFormat32bppPARGB, static_cast<BYTE *>(src->Scan0));
+    Bitmap dst_bmp(dst->Width, band->y1 - band->y0, dst->Stride, PixelFormat32bppPARGB,
+                   static_cast<BYTE *>(dst->Scan0) + static_cast<INT_PTR>(band->y0) * dst->Stride);
+    Graphics g(&dst_bmp);
+    g.SetCompositingMode(CompositingModeSourceCopy);
+    g.SetInterpolationMode(band->mode);
+    g.SetPixelOffsetMode(PixelOffsetModeHalf);
+    ImageAttributes attrs;
+    attrs.SetWrapMode(WrapModeTileFlipXY);
+    /* The whole destination shifted up by y0; the band bitmap clips it, and the
+       filter reads the neighbouring source pixels, so the bands join without seams. */
+    RectF dest(0.0f, static_cast<REAL>(-band->y0), static_cast<REAL>(dst->Width), static_cast<REAL>(dst->Height));
+    return g.DrawImage(&src_bmp, dest, 0.0f, 0.0f, static_cast<REAL>(src->Width), static_cast<REAL>(src->Height), UnitPixel, &attrs);
+}
+
+static DWORD WINAPI
+gdip_resize_band_proc(LPVOID param)
+{
+    gdipResizeBand *band = static_cast<gdipResizeBand *>(param);
+    band->status = gdip_resize_band(band);
+    return 0;
+}
+
+/*
+ * Scales +src+ into +dst+ (32bpp PARGB) on +threads+ threads, or on one thread
+ * per core if +threads+ <= 0. Bands are at least 32 rows high.
+ * Runs without Ruby; the caller releases the GVL.
+ */
+Status
+gdip_bitmap_resize(Bitmap *src, Bitmap *dst, InterpolationMode mode, int threads)
+{
+    if (threads <= 0) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        threads = static_cast<int>(info.dwNumberOfProcessors);
+    }
+    UINT height = dst->GetHeight();
+    int max_bands = static_cast<int>(height / 32);
+    if (threads > max_bands) threads = max_bands;
+    if (threads > MAXIMUM_WAIT_OBJECTS) threads = MAXIMUM_WAIT_OBJECTS;
+    if (threads < 1) threads = 1;
+
+    Rect src_rect(0, 0, src->GetWidth(), src->GetHeight());
+    BitmapData src_data;
+    Status status = src->LockBits(&src_rect, ImageLockModeRead, PixelFormat32bppPARGB, &src_data);
+    if (status != Ok) return status;
+    Rect dst_rect(0, 0, dst->GetWidth(), height);
+    BitmapData dst_data;
+    status = dst->LockBits(&dst_rect, ImageLockModeWrite, PixelFormat32bppPARGB, &dst_data);
+    if (status != Ok) {
+        src->UnlockBits(&src_data);
+        return status;
+    }
+
+    gdipResizeBand bands[MAXIMUM_WAIT_OBJECTS];
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+    int nhandles = 0;
+    for (int i = 0; i < threads; ++i) {
+        bands[i].src = &src_data;
+        bands[i].dst = &dst_data;
+        bands[i].y0 = static_cast<INT>(height * i / threads);
+        bands[i].y1 = static_cast<INT>(height * (i + 1) / threads);
+        bands[i].mode = mode;
+        bands[i].status = Ok;
+    }
+    for (int i = 1; i < threads; ++i) {
+        HANDLE h = CreateThread(NULL, 0, gdip_resize_band_proc, &bands[i], 0, NULL);
+        if (h != NULL) {
+            handles[nhandles++] = h;
+        }
+        else {
+            gdip_resize_band_proc(&bands[i]);
+        }
+    }
+    gdip_resize_band_proc(&bands[0]);
+    if (nhandles > 0) {
+        WaitForMultipleObjects(nhandles, handles, TRUE, INFINITE);
+        for (int i = 0; i < nhandles; ++i) {
+            CloseHandle(handles[i]);
+        }
+    }
+
+    for (int i = 0; i < threads && status == Ok; ++i) {
+        status = bands[i].status;
+    }
+    Status st = dst->UnlockBits(&dst_data);
+    if (status == Ok) status = st;
+    st = src->UnlockBits(&src_data);
+    if (status == Ok) status = st;
+    return status;
+}
+
+/**
+ * Returns a new bitmap scaled to the size. The destination is split into
+ * horizontal bands that are drawn on several threads without the GVL.
+ * @overload resize(width, height, mode=InterpolationMode.HighQualityBicubic, threads=nil)
+ *   @param width [Integer]
+ *   @param height [Integer]
+ *   @param mode [InterpolationMode]
+ *   @param threads [Integer] the number of threads; one per core if nil
+ *   @return [Bitmap] 32bpp PARGB
+ * @example
+ *   thumb = Bitmap.new("8k.png").resize(320, 180)
+ */
+static VALUE
+gdip_bitmap_resize_m(int argc, VALUE *argv, VALUE self)
+{
+    VALUE v_width, v_height, v_mode, v_threads;
+    rb_scan_args(argc, argv, "22", &v_width, &v_height, &v_mode, &v_threads);
+
+    Bitmap *bmp = Data_Ptr<Bitmap *>(self);
+    Check_NULL(bmp, "The Bitmap object does not exist.");
+    int width = RB_NUM2INT(v_width);
+    int height = RB_NUM2INT(v_height);
+    if (width <= 0 || height <= 0) {
+        rb_raise(rb_eArgError, "The width and height should be greater than 0.");
+    }
+    InterpolationMode mode = InterpolationModeHighQualityBicubic;
+    if (!RB_NIL_P(v_mode)) {
+        gdip_arg_to_enumint(cInterpolationMode, v_mode, &mode, "The third argument should be InterpolationMode.");
+    }
+    int threads = RB_NIL_P(v_threads) ? 0 : RB_NUM2INT(v_threads);
+
+    VALUE r = typeddata_alloc_null<&tBitmap>(cBitmap);
+    Bitmap *dst = gdip_obj_create(new Bitmap(width, height, PixelFormat32bppPARGB));
+    _DATA_PTR(r) = dst;
+    dst->SetResolution(bmp->GetHorizontalResolution(), bmp->GetVerticalResolution());
+
+    Status status = gdip_call_without_gvl([&]() {
+        return gdip_bitmap_resize(bmp, dst, mode, threads);
+    }, bmp, dst);
+    Check_Status(status);
+    return r;
+}
 
+/*
+Document-class: Gdiplus::BitmapData
+The pixels locked by {Bitmap#LockBits}.
+*/
 void Init_bitmap()
 {
     cBitmap = rb_define_class_under(mGdiplus, "Bitmap", cImage);
     rb_define_alloc_func(cBitmap, &typeddata_alloc_null<&tBitmap>);
     rb_define_method(cBitmap, "initialize", RUBY_METHOD_FUNC(gdip_bitmap_init), -1);
+    rb_define_singleton_method(cBitmap, "FromBytes", RUBY_METHOD_FUNC(gdip_bitmap_s_from_bytes), -1);
+    rb_define_alias(rb_singleton_class(cBitmap), "from_bytes", "FromBytes");
+    rb_define_method(cBitmap, "LockBits", RUBY_METHOD_FUNC(gdip_bitmap_lock_bits), 3);
+    rb_define_alias(cBitmap, "lock_bits", "LockBits");
+    rb_define_method(cBitmap, "UnlockBits", RUBY_METHOD_FUNC(gdip_bitmap_unlock_bits), 1);
+    rb_define_alias(cBitmap, "unlock_bits", "UnlockBits");
+    rb_define_method(cBitmap, "resize", RUBY_METHOD_FUNC(gdip_bitmap_resize_m), -1);
+
+    cBitmapData = rb_define_class_under(mGdiplus, "BitmapData", rb_cObject);
+    rb_undef_alloc_func(cBitmapData);
+    ATTR_R(cBitmapData, Width, width, bmpdata);
+    ATTR_R(cBitmapData, Height, height, bmpdata);
+    ATTR_R(cBitmapData, Stride, stride, bmpdata);
+    ATTR_R(cBitmapData, PixelFormat, pixel_format, bmpdata);
+    ATTR_R(cBitmapData, Scan0, scan0, bmpdata);
+    rb_define_method(cBitmapData, "locked?", RUBY_METHOD_FUNC(gdip_bmpdata_locked_p), 0);
+    rb_define_method(cBitmapData, "bytes", RUBY_METHOD_FUNC(gdip_bmpdata_get_bytes), 0);
+#if RUBY_API_VERSION_CODE >= 30100
+    rb_define_method(cBitmapData, "buffer", RUBY_METHOD_FUNC(gdip_bmpdata_get_buffer), 0);
+
+    cBitmapDataFinalizer = rb_define_class_under(mInternals, "BitmapDataFinalizer", rb_cObject);
+    rb_undef_alloc_func(cBitmapDataFinalizer);
+    rb_define_method(cBitmapDataFinalizer, "call", RUBY_METHOD_FUNC(gdip_bmpdata_fin_call), 1);
+#endif
+    rb_define_method(cBitmapData, "write", RUBY_METHOD_FUNC(gdip_bmpdata_write), 2);
 }
\ No newline at end of file
@@ -129,20 +129,36 @@ public:
 static void
 gdip_icinfo_mark(gdipImageCodecInfo *icinfo)
 {
-    if (icinfo->_clsid) rb_gc_mark(icinfo->_clsid);
-    if (icinfo->_formatid) rb_gc_mark(icinfo->_formatid);
-    if (icinfo->_codecname) rb_gc_mark(icinfo->_codecname);
-    if (icinfo->_dllname) rb_gc_mark(icinfo->_dllname);
-    if (icinfo->_filenameext) rb_gc_mark(icinfo->_filenameext);
-    if (icinfo->_formatdesc) rb_gc_mark(icinfo->_formatdesc);
-    if (icinfo->_mimetype) rb_gc_mark(icinfo->_mimetype);
-    if (icinfo->_sigpat) rb_gc_mark(icinfo->_sigpat);
-    if (icinfo->_sigmask) rb_gc_mark(icinfo->_sigmask);
-    if (icinfo->_encprms) rb_gc_mark(icinfo->_encprms);
+    if (icinfo->_clsid) _rb_gc_mark_movable(icinfo->_clsid);
+    if (icinfo->_formatid) _rb_gc_mark_movable(icinfo->_formatid);
+    if (icinfo->_codecname) _rb_gc_mark_movable(icinfo->_codecname);
+    if (icinfo->_dllname) _rb_gc_mark_movable(icinfo->_dllname);
+    if (icinfo->_filenameext) _rb_gc_mark_movable(icinfo->_filenameext);
+    if (icinfo->_formatdesc) _rb_gc_mark_movable(icinfo->_formatdesc);
+    if (icinfo->_mimetype) _rb_gc_mark_movable(icinfo->_mimetype);
+    if (icinfo->_sigpat) _rb_gc_mark_movable(icinfo->_sigpat);
+    if (icinfo->_sigmask) _rb_gc_mark_movable(icinfo->_sigmask);
+    if (icinfo->_encprms) _rb_gc_mark_movable(icinfo->_encprms);
 }
 
-const rb_data_type_t tImageCodecInfo = _MAKE_DATA_TYPE(
-    "ImageCodecInfo", RUBY_DATA_FUNC(gdip_icinfo_mark), GDIP_DEFAULT_FREE(gdipImageCodecInfo), &typeddata_size<ImageCodecInfo>, NULL, &cImageCodecInfo);
+static void
+gdip_icinfo_compact(gdipImageCodecInfo *icinfo)
+{
+    icinfo->_clsid = _rb_gc_location(icinfo->_clsid);
+    icinfo->_formatid = _rb_gc_location(icinfo->_formatid);
+    icinfo->_codecname = _rb_gc_location(icinfo->_codecname);
+    icinfo->_dllname = _rb_gc_location(icinfo->_dllname);
+    icinfo->_filenameext = _rb_gc_location(icinfo->_filenameext);
+    icinfo->_formatdesc = _rb_gc_location(icinfo->_formatdesc);
+    icinfo->_mimetype = _rb_gc_location(icinfo->_mimetype);
+    icinfo->_sigpat = _rb_gc_location(icinfo->_sigpat);
+    icinfo->_sigmask = _rb_gc_location(icinfo->_sigmask);
+    icinfo->_encprms = _rb_gc_location(icinfo->_encprms);
+}
+
+const rb_data_type_t tImageCodecInfo = _MAKE_DATA_TYPE_MOVABLE(
+    "ImageCodecInfo", RUBY_DATA_FUNC(gdip_icinfo_mark), GDIP_DEFAULT_FREE(gdipImageCodecInfo), &typeddata_size<ImageCodecInfo>,
+    RUBY_DATA_FUNC(gdip_icinfo_compact), NULL, &cImageCodecInfo);
 
 static VALUE gdip_icinfo_get_codec_name(VALUE);
 static VALUE gdip_icinfo_get_dll_name(VALUE);
@@ -181,7 +197,7 @@ gdip_icinfo_get_clsid(VALUE self)
     
     VALUE v = gdip_guid_create(&icinfo->Clsid);
     RB_OBJ_FREEZE(v);
-    icinfo->_clsid = v;
+    RB_OBJ_WRITE(self, &icinfo->_clsid, v);
     return v;
 }
 
@@ -197,7 +213,7 @@ gdip_icinfo_get_format_id(VALUE self)
     
     VALUE v = gdip_guid_create(&icinfo->FormatID);
     RB_OBJ_FREEZE(v);
-    icinfo->_formatid = v;
+    RB_OBJ_WRITE(self, &icinfo->_formatid, v);
     return v;
 }
 
@@ -213,7 +229,7 @@ gdip_icinfo_get_codec_name(VALUE self)
     
     VALUE v = util_utf8_str_new_from_wstr(icinfo->CodecName);
     RB_OBJ_FREEZE(v);
-    icinfo->_codecname = v;
+    RB_OBJ_WRITE(self, &icinfo->_codecname, v);
     return v;
 }
 
@@ -229,7 +245,7 @@ gdip_icinfo_get_dll_name(VALUE self)
     
     VALUE v = util_utf8_str_new_from_wstr(icinfo->DllName);
     RB_OBJ_FREEZE(v);
-    icinfo->_dllname = v;
+    RB_OBJ_WRITE(self, &icinfo->_dllname, v);
     return v;
 }
 
@@ -245,7 +261,7 @@ gdip_icinfo_get_format_description(VALUE self)
     
     VALUE v = util_utf8_str_new_from_wstr(icinfo->FormatDescription);
     RB_OBJ_FREEZE(v);
-    icinfo->_formatdesc = v;
+    RB_OBJ_WRITE(self, &icinfo->_formatdesc, v);
     return v;
 }
 
@@ -261,7 +277,7 @@ gdip_icinfo_get_filename_extension(VALUE self)
     
     VALUE v = util_utf8_str_new_from_wstr(icinfo->FilenameExtension);
     RB_OBJ_FREEZE(v);
-    icinfo->_filenameext = v;
+    RB_OBJ_WRITE(self, &icinfo->_filenameext, v);
     return v;
 }
 
@@ -277,7 +293,7 @@ gdip_icinfo_get_mime_type(VALUE self)
     
     VALUE v = util_utf8_str_new_from_wstr(icinfo->MimeType);
     RB_OBJ_FREEZE(v);
-    icinfo->_mimetype = v;
+    RB_OBJ_WRITE(self, &icinfo->_mimetype, v);
     return v;
 }
 
@@ -348,7 +364,7 @@ gdip_icinfo_get_signature_patterns(VALUE self)
         }
     }
     RB_OBJ_FREEZE(v);
-    icinfo->_sigpat = v;
+    RB_OBJ_WRITE(self, &icinfo->_sigpat, v);
     return v;
 }
 
@@ -371,7 +387,7 @@ gdip_icinfo_get_signature_masks(VALUE self)
         }
     }
     RB_OBJ_FREEZE(v);
-    icinfo->_sigmask = v;
+    RB_OBJ_WRITE(self, &icinfo->_sigmask, v);
     return v;
 }
 
@@ -387,6 +403,7 @@ gdip_icinfo_prmlist(VALUE self)
     gdipImageCodecInfo *icinfo = Data_Ptr<gdipImageCodecInfo *>(self);
     if (icinfo->_encprms) return icinfo->_encprms;
     VALUE r;
+    GdiplusEnsureStarted();
     Bitmap *bmp = new Bitmap(1, 1);
     UINT prmsize = bmp->GetEncoderParameterListSize(&icinfo->Clsid);
     if (prmsize == 0) {
@@ -404,7 +421,7 @@ gdip_icinfo_prmlist(VALUE self)
         ruby_xfree(prms);
     }
     delete bmp;
-    icinfo->_encprms = r;
+    RB_OBJ_WRITE(self, &icinfo->_encprms, r);
     return r;
 }
 
@@ -424,6 +441,7 @@ gdip_icinfo_s_image_encoders(VALUE self)
     UINT size = 0;
     ImageCodecInfo* pImageCodecInfo = NULL;
 
+    GdiplusEnsureStarted();
     GetImageEncodersSize(&num, &size);
     if (size == 0) { return rb_ary_new(); }
 
@@ -455,6 +473,7 @@ gdip_icinfo_s_image_decoders(VALUE self)
     UINT size = 0;
     ImageCodecInfo *pImageCodecInfo = NULL;
 
+    GdiplusEnsureStarted();
     GetImageDecodersSize(&num, &size);
     if (size == 0) { return rb_ary_new(); }
 
@@ -485,11 +504,18 @@ struct gdipEncoderParameter {
 static void
 gdip_encprm_mark(gdipEncoderParameter *ptr)
 {
-    rb_gc_mark(ptr->values);
+    _rb_gc_mark_movable(ptr->values);
 }
 
-const rb_data_type_t tEncoderParameter = _MAKE_DATA_TYPE(
-    "EncoderParameter", RUBY_DATA_FUNC(gdip_encprm_mark), GDIP_DEFAULT_FREE(gdipEncoderParameter), &typeddata_size<gdipEncoderParameter>, NULL, &cEncoderParameter);
+static void
+gdip_encprm_compact(gdipEncoderParameter *ptr)
+{
+    ptr->values = _rb_gc_location(ptr->values);
+}
+
+const rb_data_type_t tEncoderParameter = _MAKE_DATA_TYPE_MOVABLE(
+    "EncoderParameter", RUBY_DATA_FUNC(gdip_encprm_mark), GDIP_DEFAULT_FREE(gdipEncoderParameter), &typeddata_size<gdipEncoderParameter>,
+    RUBY_DATA_FUNC(gdip_encprm_compact), NULL, &cEncoderParameter);
 
 static VALUE
 gdip_encprm_alloc(VALUE klass)
@@ -508,7 +534,7 @@ gdip_encprm_create(EncoderParameter *encprm)
     gdipEncoderParameter *gpencprm = Data_Ptr<gdipEncoderParameter *>(r);
     gpencprm->Guid = encprm->Guid;
     gpencprm->Type = encprm->Type;
-    gpencprm->values = Qnil;
+    RB_OBJ_WRITE(r, &gpencprm->values, Qnil);
     gpencprm->_enc_id = gdip_enum_get_id<GUID *>(cEncoder, &encprm->Guid);
     if (encprm->NumberOfValues > 0) {
         VALUE ary = rb_ary_new_capa(encprm->NumberOfValues);
@@ -542,7 +568,7 @@ gdip_encprm_create(EncoderParameter *encprm)
         case EncoderParameterValueTypeASCII: {
             VALUE str = rb_usascii_str_new(static_cast<char *>(encprm->Value), encprm->NumberOfValues - 1);
             RB_OBJ_FREEZE(str);
-            gpencprm->values = str;
+            RB_OBJ_WRITE(r, &gpencprm->values, str);
             return r;
         } break;
         case EncoderParameterValueTypeRational: {
@@ -576,7 +602,7 @@ gdip_encprm_create(EncoderParameter *encprm)
         }
 
         RB_OBJ_FREEZE(ary);
-        gpencprm->values = ary;
+        RB_OBJ_WRITE(r, &gpencprm->values, ary);
     }
     return r;
 }
@@ -650,22 +676,22 @@ gdip_encprm_init_type_value(VALUE self, int type, VALUE value)
     encprm->Type = type;
     switch(type) {
         case EncoderParameterValueTypeByte:
-            encprm->values = gdip_encprm_get_int_ary(value);
+            RB_OBJ_WRITE(self, &encprm->values, gdip_encprm_get_int_ary(value));
             break;
         case EncoderParameterValueTypeShort:
-            encprm->values = gdip_encprm_get_int_ary(value);
+            RB_OBJ_WRITE(self, &encprm->values, gdip_encprm_get_int_ary(value));
             break;
         case EncoderParameterValueTypeLong:
-            encprm->values = gdip_encprm_get_int_ary(value);
+            RB_OBJ_WRITE(self, &encprm->values, gdip_encprm_get_int_ary(value));
             break;
         case EncoderParameterValueTypeUndefined:
-            encprm->values = gdip_encprm_get_int_ary(value);
+            RB_OBJ_WRITE(self, &encprm->values, gdip_encprm_get_int_ary(value));
             break;
         case EncoderParameterValueTypeASCII: { // EncoderParameterValueTypeASCII
             if (RB_TYPE_P(value, RUBY_T_STRING)) {
                 VALUE str = rb_str_dup(value);
                 RB_OBJ_FREEZE(str);
-                encprm->values = str;
+                RB_OBJ_WRITE(self, &encprm->values, str);
             }
             else {
                 rb_raise(rb_eTypeError, "ValueTypeASCII requires string");
@@ -692,7 +718,7 @@ gdip_encprm_init_type_value(VALUE self, int type, VALUE value)
                 rb_raise(rb_eTypeError, "ValueTypeRational requires Rational or Array<Rational>");
             }
             RB_OBJ_FREEZE(ary);
-            encprm->values = ary;
+            RB_OBJ_WRITE(self, &encprm->values, ary);
         } break;
         case EncoderParameterValueTypeLongRange: { // EncoderParameterValueTypeLongRange
             VALUE ary = rb_ary_new();
@@ -727,7 +753,7 @@ gdip_encprm_init_type_value(VALUE self, int type, VALUE value)
                 rb_raise(rb_eTypeError, "ValueTypeLongRange requires Range(Integer) or Array<Range(Integer)>");
             }
             RB_OBJ_FREEZE(ary);
-            encprm->values = ary;
+            RB_OBJ_WRITE(self, &encprm->values, ary);
         } break;
         case EncoderParameterValueTypeRationalRange: { // EncoderParameterValueTypeRationalRange
             VALUE ary = rb_ary_new();
@@ -762,7 +788,7 @@ gdip_encprm_init_type_value(VALUE self, int type, VALUE value)
                 rb_raise(rb_eTypeError, "ValueTypeLongRange requires Range(Integer) or Array<Range(Integer)>");
             }
             RB_OBJ_FREEZE(ary);
-            encprm->values = ary;
+            RB_OBJ_WRITE(self, &encprm->values, ary);
         } break;
         case EncoderParameterValueTypePointer: {
             rb_raise(rb_eNotImpError, "Not implemented type: ValueTypePointer");
@@ -781,7 +807,7 @@ gdip_encprm_quality_init(VALUE self, VALUE value)
     encprm->Guid = EncoderQuality;
     encprm->_enc_id = ID_Quality;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
 
@@ -804,7 +830,7 @@ gdip_encprm_transformation_init(VALUE self, VALUE value)
     encprm->Guid = EncoderTransformation;
     encprm->_enc_id = ID_Transformation;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
 
@@ -827,7 +853,7 @@ gdip_encprm_compression_init(VALUE self, VALUE value)
     encprm->Guid = EncoderCompression;
     encprm->_enc_id = ID_Compression;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
 
@@ -850,7 +876,7 @@ gdip_encprm_colordepth_init(VALUE self, VALUE value)
     encprm->Guid = EncoderColorDepth;
     encprm->_enc_id = ID_ColorDepth;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
 
@@ -873,7 +899,7 @@ gdip_encprm_saveflag_init(VALUE self, VALUE value)
     encprm->Guid = EncoderSaveFlag;
     encprm->_enc_id = ID_SaveFlag;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
 
@@ -896,7 +922,7 @@ gdip_encprm_saveascmyk_init(VALUE self, VALUE value)
     encprm->Guid = _EncoderSaveAsCMYK;
     encprm->_enc_id = ID_SaveAsCMYK;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
 
@@ -919,7 +945,7 @@ gdip_encprm_chrominance_init(VALUE self, VALUE value)
     encprm->Guid = EncoderChrominanceTable;
     encprm->_enc_id = ID_ChrominanceTable;
     encprm->Type = EncoderParameterValueTypeShort;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeShort, value);
 
@@ -936,7 +962,7 @@ gdip_encprm_luminance_init(VALUE self, VALUE value)
     encprm->Guid = EncoderLuminanceTable;
     encprm->_enc_id = ID_LuminanceTable;
     encprm->Type = EncoderParameterValueTypeShort;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeShort, value);
 
@@ -953,7 +979,7 @@ gdip_encprm_version_init(VALUE self, VALUE value)
     encprm->Guid = EncoderVersion;
     encprm->_enc_id = ID_Version;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
     
@@ -977,7 +1003,7 @@ gdip_encprm_scanmethod_init(VALUE self, VALUE value)
     encprm->Guid = EncoderScanMethod;
     encprm->_enc_id = ID_ScanMethod;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
     if (_RB_ARRAY_P(encprm->values) && RARRAY_LEN(encprm->values) == 1) {
@@ -1000,7 +1026,7 @@ gdip_encprm_rendermethod_init(VALUE self, VALUE value)
     encprm->Guid = EncoderRenderMethod;
     encprm->_enc_id = ID_RenderMethod;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
     if (_RB_ARRAY_P(encprm->values) && RARRAY_LEN(encprm->values) == 1) {
@@ -1023,7 +1049,7 @@ gdip_encprm_colorspace_init(VALUE self, VALUE value)
     encprm->Guid = _EncoderColorSpace;
     encprm->_enc_id = ID_ColorSpace;
     encprm->Type = EncoderParameterValueTypeLong;
-    encprm->values = Qnil;
+    RB_OBJ_WRITE(self, &encprm->values, Qnil);
 
     gdip_encprm_init_type_value(self, EncoderParameterValueTypeLong, value);
     
@@ -1041,7 +1067,7 @@ gdip_encprm_imageitems_init(VALUE self, VALUE value)
     // check value
     VALUE ary = rb_ary_new();
     rb_ary_push(ary, value);
-    encprm->values = ary;
+    RB_OBJ_WRITE(self, &encprm->values, ary);
     // NOTIMPLEMENTED
     
     return self;
@@ -1192,18 +1218,25 @@ gdip_encprms_free(gdipEncoderParameters *ptr)
 static void
 gdip_encprms_mark(gdipEncoderParameters *ptr)
 {
-    rb_gc_mark(ptr->params);
+    _rb_gc_mark_movable(ptr->params);
+}
+
+static void
+gdip_encprms_compact(gdipEncoderParameters *ptr)
+{
+    ptr->params = _rb_gc_location(ptr->params);
 }
 
-const rb_data_type_t tEncoderParameters = _MAKE_DATA_TYPE(
-    "EncoderParameters", RUBY_DATA_FUNC(gdip_encprms_mark), RUBY_DATA_FUNC(gdip_encprms_free), &typeddata_size<gdipEncoderParameters>, NULL, &cEncoderParameters);
+const rb_data_type_t tEncoderParameters = _MAKE_DATA_TYPE_MOVABLE(
+    "EncoderParameters", RUBY_DATA_FUNC(gdip_encprms_mark), RUBY_DATA_FUNC(gdip_encprms_free), &typeddata_size<gdipEncoderParameters>,
+    RUBY_DATA_FUNC(gdip_encprms_compact), NULL, &cEncoderParameters);
 
 static VALUE
 gdip_encprms_create(EncoderParameters *encprms)
 {
     VALUE r = typeddata_alloc<gdipEncoderParameters, &tEncoderParameters>(cEncoderParameters);
     gdipEncoderParameters *gpencprms = Data_Ptr<gdipEncoderParameters *>(r);
-    gpencprms->params = Qnil;
+    RB_OBJ_WRITE(r, &gpencprms->params, Qnil);
     if (encprms != NULL && encprms->Count > 0) {
         VALUE ary = rb_ary_new_capa(encprms->Count);
         for (UINT i = 0; i < encprms->Count; ++i) {
@@ -1211,7 +1244,7 @@ gdip_encprms_create(EncoderParameters *encprms)
             rb_ary_push(ary, e);
         }
         //RB_OBJ_FREEZE(ary);
-        gpencprms->params = ary;
+        RB_OBJ_WRITE(r, &gpencprms->params, ary);
     }
     return r;
 }
@@ -1225,7 +1258,7 @@ static VALUE
 gdip_encprms_init(VALUE self)
 {
     gdipEncoderParameters *gpencprms = Data_Ptr<gdipEncoderParameters *>(self);
-    gpencprms->params = Qnil;
+    RB_OBJ_WRITE(self, &gpencprms->params, Qnil);
     return self;
 }
 
@@ -1287,7 +1320,7 @@ gdip_encprms_get_param(VALUE self)
      VALUE ary = gpencprms->params;
      if (!_RB_ARRAY_P(ary)) {
          ary = rb_ary_new();
-         gpencprms->params = ary;
+         RB_OBJ_WRITE(self, &gpencprms->params, ary);
      }
      rb_ary_push(ary, v);
      return self;
@@ -1307,6 +1340,9 @@ gdip_encprms_build_struct(VALUE v)
 
     gdipEncoderParameters *encprms = Data_Ptr<gdipEncoderParameters *>(v);
     if (encprms->data) {
+        if (gdip_busy_p(encprms->data)) {
+            rb_raise(eGdiplus, "The object is being used by another thread.");
+        }
         gdip_encprms_free_data(encprms->data);
         encprms->data = NULL;
     }
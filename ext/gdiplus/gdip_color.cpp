@@ -4,16 +4,250 @@
  * Released under the MIT License.
  */
 #include "ruby_gdiplus.h"
+#include "simplemap.h"
 
 const rb_data_type_t tColor = _MAKE_DATA_TYPE(
     "Color", 0, RUBY_NEVER_FREE, NULL, NULL, &cColor);
 
+struct color_name {
+    const char *name;
+    ARGB argb;
+};
+
+/* The named colors sorted by name. Color::Red etc. are defined on first access. */
+static constexpr color_name color_names[] = {
+    {"AliceBlue", 0xFFF0F8FF},
+    {"AntiqueWhite", 0xFFFAEBD7},
+    {"Aqua", 0xFF00FFFF},
+    {"Aquamarine", 0xFF7FFFD4},
+    {"Azure", 0xFFF0FFFF},
+    {"Beige", 0xFFF5F5DC},
+    {"Bisque", 0xFFFFE4C4},
+    {"Black", 0xFF000000},
+    {"BlanchedAlmond", 0xFFFFEBCD},
+    {"Blue", 0xFF0000FF},
+    {"BlueViolet", 0xFF8A2BE2},
+    {"Brown", 0xFFA52A2A},
+    {"BurlyWood", 0xFFDEB887},
+    {"CadetBlue", 0xFF5F9EA0},
+    {"Chartreuse", 0xFF7FFF00},
+    {"Chocolate", 0xFFD2691E},
+    {"Coral", 0xFFFF7F50},
+    {"CornflowerBlue", 0xFF6495ED},
+    {"Cornsilk", 0xFFFFF8DC},
+    {"Crimson", 0xFFDC143C},
+    {"Cyan", 0xFF00FFFF},
+    {"DarkBlue", 0xFF00008B},
+    {"DarkCyan", 0xFF008B8B},
+    {"DarkGoldenrod", 0xFFB8860B},
+    {"DarkGray", 0xFFA9A9A9},
+    {"DarkGreen", 0xFF006400},
+    {"DarkKhaki", 0xFFBDB76B},
+    {"DarkMagenta", 0xFF8B008B},
+    {"DarkOliveGreen", 0xFF556B2F},
+    {"DarkOrange", 0xFFFF8C00},
+    {"DarkOrchid", 0xFF9932CC},
+    {"DarkRed", 0xFF8B0000},
+    {"DarkSalmon", 0xFFE9967A},
+    {"DarkSeaGreen", 0xFF8FBC8B},
+    {"DarkSlateBlue", 0xFF483D8B},
+    {"DarkSlateGray", 0xFF2F4F4F},
+    {"DarkTurquoise", 0xFF00CED1},
+    {"DarkViolet", 0xFF9400D3},
+    {"DeepPink", 0xFFFF1493},
+    {"DeepSkyBlue", 0xFF00BFFF},
+    {"DimGray", 0xFF696969},
+    {"DodgerBlue", 0xFF1E90FF},
+    {"Firebrick", 0xFFB22222},
+    {"FloralWhite", 0xFFFFFAF0},
+    {"ForestGreen", 0xFF228B22},
+    {"Fuchsia", 0xFFFF00FF},
+    {"Gainsboro", 0xFFDCDCDC},
+    {"GhostWhite", 0xFFF8F8FF},
+    {"Gold", 0xFFFFD700},
+    {"Goldenrod", 0xFFDAA520},
+    {"Gray", 0xFF808080},
+    {"Green", 0xFF008000},
+    {"GreenYellow", 0xFFADFF2F},
+    {"Honeydew", 0xFFF0FFF0},
+    {"HotPink", 0xFFFF69B4},
+    {"IndianRed", 0xFFCD5C5C},
+    {"Indigo", 0xFF4B0082},
+    {"Ivory", 0xFFFFFFF0},
+    {"Khaki", 0xFFF0E68C},
+    {"Lavender", 0xFFE6E6FA},
+    {"LavenderBlush", 0xFFFFF0F5},
+    {"LawnGreen", 0xFF7CFC00},
+    {"LemonChiffon", 0xFFFFFACD},
+    {"LightBlue", 0xFFADD8E6},
+    {"LightCoral", 0xFFF08080},
+    {"LightCyan", 0xFFE0FFFF},
+    {"LightGoldenrodYellow", 0xFFFAFAD2},
+    {"LightGray", 0xFFD3D3D3},
+    {"LightGreen", 0xFF90EE90},
+    {"LightPink", 0xFFFFB6C1},
+    {"LightSalmon", 0xFFFFA07A},
+    {"LightSeaGreen", 0xFF20B2AA},
+    {"LightSkyBlue", 0xFF87CEFA},
+    {"LightSlateGray", 0xFF778899},
+    {"LightSteelBlue", 0xFFB0C4DE},
+    {"LightYellow", 0xFFFFFFE0},
+    {"Lime", 0xFF00FF00},
+    {"LimeGreen", 0xFF32CD32},
+    {"Linen", 0xFFFAF0E6},
+    {"Magenta", 0xFFFF00FF},
+    {"Maroon", 0xFF800000},
+    {"MediumAquamarine", 0xFF66CDAA},
+    {"MediumBlue", 0xFF0000CD},
+    {"MediumOrchid", 0xFFBA55D3},
+    {"MediumPurple", 0xFF9370DB},
+    {"MediumSeaGreen", 0xFF3CB371},
+    {"MediumSlateBlue", 0xFF7B68EE},
+    {"MediumSpringGreen", 0xFF00FA9A},
+    {"MediumTurquoise", 0xFF48D1CC},
+    {"MediumVioletRed", 0xFFC71585},
+    {"MidnightBlue", 0xFF191970},
+    {"MintCream", 0xFFF5FFFA},
+    {"MistyRose", 0xFFFFE4E1},
+    {"Moccasin", 0xFFFFE4B5},
+    {"NavajoWhite", 0xFFFFDEAD},
+    {"Navy", 0xFF000080},
+    {"OldLace", 0xFFFDF5E6},
+    {"Olive", 0xFF808000},
+    {"OliveDrab", 0xFF6B8E23},
+    {"Orange", 0xFFFFA500},
+    {"OrangeRed", 0xFFFF4500},
+    {"Orchid", 0xFFDA70D6},
+    {"PaleGoldenrod", 0xFFEEE8AA},
+    {"PaleGreen", 0xFF98FB98},
+    {"PaleTurquoise", 0xFFAFEEEE},
+    {"PaleVioletRed", 0xFFDB7093},
+    {"PapayaWhip", 0xFFFFEFD5},
+    {"PeachPuff", 0xFFFFDAB9},
+    {"Peru", 0xFFCD853F},
+    {"Pink", 0xFFFFC0CB},
+    {"Plum", 0xFFDDA0DD},
+    {"PowderBlue", 0xFFB0E0E6},
+    {"Purple", 0xFF800080},
+    {"Red", 0xFFFF0000},
+    {"RosyBrown", 0xFFBC8F8F},
+    {"RoyalBlue", 0xFF4169E1},
+    {"SaddleBrown", 0xFF8B4513},
+    {"Salmon", 0xFFFA8072},
+    {"SandyBrown", 0xFFF4A460},
+    {"SeaGreen", 0xFF2E8B57},
+    {"SeaShell", 0xFFFFF5EE},
+    {"Sienna", 0xFFA0522D},
+    {"Silver", 0xFFC0C0C0},
+    {"SkyBlue", 0xFF87CEEB},
+    {"SlateBlue", 0xFF6A5ACD},
+    {"SlateGray", 0xFF708090},
+    {"Snow", 0xFFFFFAFA},
+    {"SpringGreen", 0xFF00FF7F},
+    {"SteelBlue", 0xFF4682B4},
+    {"Tan", 0xFFD2B48C},
+    {"Teal", 0xFF008080},
+    {"Thistle", 0xFFD8BFD8},
+    {"Tomato", 0xFFFF6347},
+    {"Transparent", 0x00FFFFFF},
+    {"Turquoise", 0xFF40E0D0},
+    {"Violet", 0xFFEE82EE},
+    {"Wheat", 0xFFF5DEB3},
+    {"White", 0xFFFFFFFF},
+    {"WhiteSmoke", 0xFFF5F5F5},
+    {"Yellow", 0xFFFFFF00},
+    {"YellowGreen", 0xFF9ACD32},
+};
+
+typedef FlatMap<color_name, const char *, &color_name::name> ColorNameMap;
+static_assert(ColorNameMap::sorted(color_names), "color_names should be sorted by name.");
+
+struct color_index {
+    ARGB argb;
+    const color_name *entry;
+};
+
+/* color_names in ARGB order. The first name wins for duplicates (Aqua/Cyan, Fuchsia/Magenta). */
+static constexpr color_index color_order[] = {
+    {0x00FFFFFF, &color_names[133]}, {0xFF000000, &color_names[7]}, {0xFF000080, &color_names[95]},
+    {0xFF00008B, &color_names[21]}, {0xFF0000CD, &color_names[82]}, {0xFF0000FF, &color_names[9]},
+    {0xFF006400, &color_names[25]}, {0xFF008000, &color_names[51]}, {0xFF008080, &color_names[130]},
+    {0xFF008B8B, &color_names[22]}, {0xFF00BFFF, &color_names[39]}, {0xFF00CED1, &color_names[36]},
+    {0xFF00FA9A, &color_names[87]}, {0xFF00FF00, &color_names[76]}, {0xFF00FF7F, &color_names[127]},
+    {0xFF00FFFF, &color_names[2]}, {0xFF191970, &color_names[90]}, {0xFF1E90FF, &color_names[41]},
+    {0xFF20B2AA, &color_names[71]}, {0xFF228B22, &color_names[44]}, {0xFF2E8B57, &color_names[119]},
+    {0xFF2F4F4F, &color_names[35]}, {0xFF32CD32, &color_names[77]}, {0xFF3CB371, &color_names[85]},
+    {0xFF40E0D0, &color_names[134]}, {0xFF4169E1, &color_names[115]}, {0xFF4682B4, &color_names[128]},
+    {0xFF483D8B, &color_names[34]}, {0xFF48D1CC, &color_names[88]}, {0xFF4B0082, &color_names[56]},
+    {0xFF556B2F, &color_names[28]}, {0xFF5F9EA0, &color_names[13]}, {0xFF6495ED, &color_names[17]},
+    {0xFF66CDAA, &color_names[81]}, {0xFF696969, &color_names[40]}, {0xFF6A5ACD, &color_names[124]},
+    {0xFF6B8E23, &color_names[98]}, {0xFF708090, &color_names[125]}, {0xFF778899, &color_names[73]},
+    {0xFF7B68EE, &color_names[86]}, {0xFF7CFC00, &color_names[61]}, {0xFF7FFF00, &color_names[14]},
+    {0xFF7FFFD4, &color_names[3]}, {0xFF800000, &color_names[80]}, {0xFF800080, &color_names[112]},
+    {0xFF808000, &color_names[97]}, {0xFF808080, &color_names[50]}, {0xFF87CEEB, &color_names[123]},
+    {0xFF87CEFA, &color_names[72]}, {0xFF8A2BE2, &color_names[10]}, {0xFF8B0000, &color_names[31]},
+    {0xFF8B008B, &color_names[27]}, {0xFF8B4513, &color_names[116]}, {0xFF8FBC8B, &color_names[33]},
+    {0xFF90EE90, &color_names[68]}, {0xFF9370DB, &color_names[84]}, {0xFF9400D3, &color_names[37]},
+    {0xFF98FB98, &color_names[103]}, {0xFF9932CC, &color_names[30]}, {0xFF9ACD32, &color_names[140]},
+    {0xFFA0522D, &color_names[121]}, {0xFFA52A2A, &color_names[11]}, {0xFFA9A9A9, &color_names[24]},
+    {0xFFADD8E6, &color_names[63]}, {0xFFADFF2F, &color_names[52]}, {0xFFAFEEEE, &color_names[104]},
+    {0xFFB0C4DE, &color_names[74]}, {0xFFB0E0E6, &color_names[111]}, {0xFFB22222, &color_names[42]},
+    {0xFFB8860B, &color_names[23]}, {0xFFBA55D3, &color_names[83]}, {0xFFBC8F8F, &color_names[114]},
+    {0xFFBDB76B, &color_names[26]}, {0xFFC0C0C0, &color_names[122]}, {0xFFC71585, &color_names[89]},
+    {0xFFCD5C5C, &color_names[55]}, {0xFFCD853F, &color_names[108]}, {0xFFD2691E, &color_names[15]},
+    {0xFFD2B48C, &color_names[129]}, {0xFFD3D3D3, &color_names[67]}, {0xFFD8BFD8, &color_names[131]},
+    {0xFFDA70D6, &color_names[101]}, {0xFFDAA520, &color_names[49]}, {0xFFDB7093, &color_names[105]},
+    {0xFFDC143C, &color_names[19]}, {0xFFDCDCDC, &color_names[46]}, {0xFFDDA0DD, &color_names[110]},
+    {0xFFDEB887, &color_names[12]}, {0xFFE0FFFF, &color_names[65]}, {0xFFE6E6FA, &color_names[59]},
+    {0xFFE9967A, &color_names[32]}, {0xFFEE82EE, &color_names[135]}, {0xFFEEE8AA, &color_names[102]},
+    {0xFFF08080, &color_names[64]}, {0xFFF0E68C, &color_names[58]}, {0xFFF0F8FF, &color_names[0]},
+    {0xFFF0FFF0, &color_names[53]}, {0xFFF0FFFF, &color_names[4]}, {0xFFF4A460, &color_names[118]},
+    {0xFFF5DEB3, &color_names[136]}, {0xFFF5F5DC, &color_names[5]}, {0xFFF5F5F5, &color_names[138]},
+    {0xFFF5FFFA, &color_names[91]}, {0xFFF8F8FF, &color_names[47]}, {0xFFFA8072, &color_names[117]},
+    {0xFFFAEBD7, &color_names[1]}, {0xFFFAF0E6, &color_names[78]}, {0xFFFAFAD2, &color_names[66]},
+    {0xFFFDF5E6, &color_names[96]}, {0xFFFF0000, &color_names[113]}, {0xFFFF00FF, &color_names[45]},
+    {0xFFFF1493, &color_names[38]}, {0xFFFF4500, &color_names[100]}, {0xFFFF6347, &color_names[132]},
+    {0xFFFF69B4, &color_names[54]}, {0xFFFF7F50, &color_names[16]}, {0xFFFF8C00, &color_names[29]},
+    {0xFFFFA07A, &color_names[70]}, {0xFFFFA500, &color_names[99]}, {0xFFFFB6C1, &color_names[69]},
+    {0xFFFFC0CB, &color_names[109]}, {0xFFFFD700, &color_names[48]}, {0xFFFFDAB9, &color_names[107]},
+    {0xFFFFDEAD, &color_names[94]}, {0xFFFFE4B5, &color_names[93]}, {0xFFFFE4C4, &color_names[6]},
+    {0xFFFFE4E1, &color_names[92]}, {0xFFFFEBCD, &color_names[8]}, {0xFFFFEFD5, &color_names[106]},
+    {0xFFFFF0F5, &color_names[60]}, {0xFFFFF5EE, &color_names[120]}, {0xFFFFF8DC, &color_names[18]},
+    {0xFFFFFACD, &color_names[62]}, {0xFFFFFAF0, &color_names[43]}, {0xFFFFFAFA, &color_names[126]},
+    {0xFFFFFF00, &color_names[139]}, {0xFFFFFFE0, &color_names[75]}, {0xFFFFFFF0, &color_names[57]},
+    {0xFFFFFFFF, &color_names[137]},
+};
+
+typedef FlatMap<color_index, ARGB, &color_index::argb> ColorOrderMap;
+static_assert(ColorOrderMap::sorted(color_order), "color_order should be sorted by ARGB.");
+
+static constexpr bool
+color_order_matches(const color_index *table, size_t n)
+{
+    return n == 0 || (table[0].entry->argb == table[0].argb && color_order_matches(table + 1, n - 1));
+}
+static_assert(color_order_matches(color_order, sizeof(color_order) / sizeof(color_index)),
+              "color_order should point to the entry of its ARGB.");
+
+static const color_name *
+color_lookup_by_id(ID name_id)
+{
+    const char *name = rb_id2name(name_id);
+    if (name == NULL) return NULL;
+    return ColorNameMap::find(color_names, name);
+}
+
 
 bool
 gdip_arg_to_color(VALUE v, Color *color, const char *raise_msg, int option)
 {
     if (RB_SYMBOL_P(v)) {
-        if (rb_const_defined_at(cColor, RB_SYM2ID(v))) {
+        const color_name *entry = color_lookup_by_id(RB_SYM2ID(v));
+        if (entry != NULL) {
+            color->SetValue(entry->argb);
+            return true;
+        }
+        else if (rb_const_defined_at(cColor, RB_SYM2ID(v))) {
             v = rb_const_get_at(cColor, RB_SYM2ID(v));
         }
         else if (raise_msg != NULL) {
@@ -55,9 +289,40 @@ gdip_arg_to_color(VALUE v, Color *color, const char *raise_msg, int option)
 }
 
 
+/* The frozen named colors created so far, indexed like color_names. */
+static VALUE named_colors[sizeof(color_names) / sizeof(color_name)];
+
+/*
+ * Returns the frozen constant of +entry+, defining Color::<name> and Color.<name>
+ * when it is used for the first time.
+ */
+static VALUE
+gdip_color_named(const color_name *entry)
+{
+    size_t idx = entry - color_names;
+    if (RTEST(named_colors[idx])) return named_colors[idx];
+
+    VALUE color = _Data_Wrap_Struct(cColor, &tColor, reinterpret_cast<void*>(entry->argb));
+    RB_OBJ_FREEZE(color);
+#if RUBY_API_VERSION_CODE >= 20700
+    /* held by the table: must not be moved by GC.compact */
+    rb_gc_register_mark_object(color);
+#endif
+    named_colors[idx] = color;
+    rb_define_const(cColor, entry->name, color);
+    rb_define_singleton_method(cColor, entry->name, RUBY_METHOD_FUNC(gdip_class_const_get), 0);
+    return color;
+}
+
+/*
+ * Returns the shared frozen constant (e.g. Color::Red) when +argb+ is a named color,
+ * otherwise a new Color.
+ */
 VALUE
 gdip_color_create(ARGB argb)
 {
+    const color_index *index = ColorOrderMap::find(color_order, argb);
+    if (index != NULL) return gdip_color_named(index->entry);
     return _Data_Wrap_Struct(cColor, &tColor, reinterpret_cast<void*>(argb));
 }
 
@@ -102,6 +367,7 @@ gdip_color_set_color(VALUE v, ARGB argb)
 static VALUE
 gdip_color_init(int argc, VALUE *argv, VALUE self)
 {
+    Check_Frozen(self);
     if (argc == 0) { }
     else if (argc == 1) {
         if (Integer_p(argv[0])) {
@@ -284,163 +550,33 @@ gdip_color_equal(VALUE self, VALUE other)
 }
 
 static VALUE
-gdip_color_s_const_get(VALUE self)
+gdip_color_s_const_missing(VALUE self, VALUE name)
 {
-    return rb_const_get(self, rb_frame_this_func());
+    if (RB_SYMBOL_P(name)) {
+        const color_name *entry = color_lookup_by_id(RB_SYM2ID(name));
+        if (entry != NULL) return gdip_color_named(entry);
+    }
+    return rb_call_super(1, &name);
 }
 
-static inline void
-gdip_color_define_const(ARGB argb, const char *name) {
-    VALUE color = gdip_color_alloc(cColor);
-    Data_Ptr_Set_As<ARGB>(color, argb);
-    rb_define_const(cColor, name, color);
-    rb_define_singleton_method(cColor, name, RUBY_METHOD_FUNC(gdip_color_s_const_get), 0);
+static VALUE
+gdip_color_s_method_missing(int argc, VALUE *argv, VALUE self)
+{
+    if (argc == 1 && RB_SYMBOL_P(argv[0])) {
+        const color_name *entry = color_lookup_by_id(RB_SYM2ID(argv[0]));
+        if (entry != NULL) return gdip_color_named(entry);
+    }
+    return rb_call_super(argc, argv);
 }
 
-static void
-Init_color_constants()
+static VALUE
+gdip_color_s_respond_to_missing_p(VALUE self, VALUE name, VALUE include_private)
 {
-    gdip_color_define_const(0xFFF0F8FF, "AliceBlue");
-    gdip_color_define_const(0xFFFAEBD7, "AntiqueWhite");
-    gdip_color_define_const(0xFF00FFFF, "Aqua");
-    gdip_color_define_const(0xFF7FFFD4, "Aquamarine");
-    gdip_color_define_const(0xFFF0FFFF, "Azure");
-    gdip_color_define_const(0xFFF5F5DC, "Beige");
-    gdip_color_define_const(0xFFFFE4C4, "Bisque");
-    gdip_color_define_const(0xFF000000, "Black");
-    gdip_color_define_const(0xFFFFEBCD, "BlanchedAlmond");
-    gdip_color_define_const(0xFF0000FF, "Blue");
-    gdip_color_define_const(0xFF8A2BE2, "BlueViolet");
-    gdip_color_define_const(0xFFA52A2A, "Brown");
-    gdip_color_define_const(0xFFDEB887, "BurlyWood");
-    gdip_color_define_const(0xFF5F9EA0, "CadetBlue");
-    gdip_color_define_const(0xFF7FFF00, "Chartreuse");
-    gdip_color_define_const(0xFFD2691E, "Chocolate");
-    gdip_color_define_const(0xFFFF7F50, "Coral");
-    gdip_color_define_const(0xFF6495ED, "CornflowerBlue");
-    gdip_color_define_const(0xFFFFF8DC, "Cornsilk");
-    gdip_color_define_const(0xFFDC143C, "Crimson");
-    gdip_color_define_const(0xFF00FFFF, "Cyan");
-    gdip_color_define_const(0xFF00008B, "DarkBlue");
-    gdip_color_define_const(0xFF008B8B, "DarkCyan");
-    gdip_color_define_const(0xFFB8860B, "DarkGoldenrod");
-    gdip_color_define_const(0xFFA9A9A9, "DarkGray");
-    gdip_color_define_const(0xFF006400, "DarkGreen");
-    gdip_color_define_const(0xFFBDB76B, "DarkKhaki");
-    gdip_color_define_const(0xFF8B008B, "DarkMagenta");
-    gdip_color_define_const(0xFF556B2F, "DarkOliveGreen");
-    gdip_color_define_const(0xFFFF8C00, "DarkOrange");
-    gdip_color_define_const(0xFF9932CC, "DarkOrchid");
-    gdip_color_define_const(0xFF8B0000, "DarkRed");
-    gdip_color_define_const(0xFFE9967A, "DarkSalmon");
-    gdip_color_define_const(0xFF8FBC8B, "DarkSeaGreen");
-    gdip_color_define_const(0xFF483D8B, "DarkSlateBlue");
-    gdip_color_define_const(0xFF2F4F4F, "DarkSlateGray");
-    gdip_color_define_const(0xFF00CED1, "DarkTurquoise");
-    gdip_color_define_const(0xFF9400D3, "DarkViolet");
-    gdip_color_define_const(0xFFFF1493, "DeepPink");
-    gdip_color_define_const(0xFF00BFFF, "DeepSkyBlue");
-    gdip_color_define_const(0xFF696969, "DimGray");
-    gdip_color_define_const(0xFF1E90FF, "DodgerBlue");
-    gdip_color_define_const(0xFFB22222, "Firebrick");
-    gdip_color_define_const(0xFFFFFAF0, "FloralWhite");
-    gdip_color_define_const(0xFF228B22, "ForestGreen");
-    gdip_color_define_const(0xFFFF00FF, "Fuchsia");
-    gdip_color_define_const(0xFFDCDCDC, "Gainsboro");
-    gdip_color_define_const(0xFFF8F8FF, "GhostWhite");
-    gdip_color_define_const(0xFFFFD700, "Gold");
-    gdip_color_define_const(0xFFDAA520, "Goldenrod");
-    gdip_color_define_const(0xFF808080, "Gray");
-    gdip_color_define_const(0xFF008000, "Green");
-    gdip_color_define_const(0xFFADFF2F, "GreenYellow");
-    gdip_color_define_const(0xFFF0FFF0, "Honeydew");
-    gdip_color_define_const(0xFFFF69B4, "HotPink");
-    gdip_color_define_const(0xFFCD5C5C, "IndianRed");
-    gdip_color_define_const(0xFF4B0082, "Indigo");
-    gdip_color_define_const(0xFFFFFFF0, "Ivory");
-    gdip_color_define_const(0xFFF0E68C, "Khaki");
-    gdip_color_define_const(0xFFE6E6FA, "Lavender");
-    gdip_color_define_const(0xFFFFF0F5, "LavenderBlush");
-    gdip_color_define_const(0xFF7CFC00, "LawnGreen");
-    gdip_color_define_const(0xFFFFFACD, "LemonChiffon");
-    gdip_color_define_const(0xFFADD8E6, "LightBlue");
-    gdip_color_define_const(0xFFF08080, "LightCoral");
-    gdip_color_define_const(0xFFE0FFFF, "LightCyan");
-    gdip_color_define_const(0xFFFAFAD2, "LightGoldenrodYellow");
-    gdip_color_define_const(0xFFD3D3D3, "LightGray");
-    gdip_color_define_const(0xFF90EE90, "LightGreen");
-    gdip_color_define_const(0xFFFFB6C1, "LightPink");
-    gdip_color_define_const(0xFFFFA07A, "LightSalmon");
-    gdip_color_define_const(0xFF20B2AA, "LightSeaGreen");
-    gdip_color_define_const(0xFF87CEFA, "LightSkyBlue");
-    gdip_color_define_const(0xFF778899, "LightSlateGray");
-    gdip_color_define_const(0xFFB0C4DE, "LightSteelBlue");
-    gdip_color_define_const(0xFFFFFFE0, "LightYellow");
-    gdip_color_define_const(0xFF00FF00, "Lime");
-    gdip_color_define_const(0xFF32CD32, "LimeGreen");
-    gdip_color_define_const(0xFFFAF0E6, "Linen");
-    gdip_color_define_const(0xFFFF00FF, "Magenta");
-    gdip_color_define_const(0xFF800000, "Maroon");
-    gdip_color_define_const(0xFF66CDAA, "MediumAquamarine");
-    gdip_color_define_const(0xFF0000CD, "MediumBlue");
-    gdip_color_define_const(0xFFBA55D3, "MediumOrchid");
-    gdip_color_define_const(0xFF9370DB, "MediumPurple");
-    gdip_color_define_const(0xFF3CB371, "MediumSeaGreen");
-    gdip_color_define_const(0xFF7B68EE, "MediumSlateBlue");
-    gdip_color_define_const(0xFF00FA9A, "MediumSpringGreen");
-    gdip_color_define_const(0xFF48D1CC, "MediumTurquoise");
-    gdip_color_define_const(0xFFC71585, "MediumVioletRed");
-    gdip_color_define_const(0xFF191970, "MidnightBlue");
-    gdip_color_define_const(0xFFF5FFFA, "MintCream");
-    gdip_color_define_const(0xFFFFE4E1, "MistyRose");
-    gdip_color_define_const(0xFFFFE4B5, "Moccasin");
-    gdip_color_define_const(0xFFFFDEAD, "NavajoWhite");
-    gdip_color_define_const(0xFF000080, "Navy");
-    gdip_color_define_const(0xFFFDF5E6, "OldLace");
-    gdip_color_define_const(0xFF808000, "Olive");
-    gdip_color_define_const(0xFF6B8E23, "OliveDrab");
-    gdip_color_define_const(0xFFFFA500, "Orange");
-    gdip_color_define_const(0xFFFF4500, "OrangeRed");
-    gdip_color_define_const(0xFFDA70D6, "Orchid");
-    gdip_color_define_const(0xFFEEE8AA, "PaleGoldenrod");
-    gdip_color_define_const(0xFF98FB98, "PaleGreen");
-    gdip_color_define_const(0xFFAFEEEE, "PaleTurquoise");
-    gdip_color_define_const(0xFFDB7093, "PaleVioletRed");
-    gdip_color_define_const(0xFFFFEFD5, "PapayaWhip");
-    gdip_color_define_const(0xFFFFDAB9, "PeachPuff");
-    gdip_color_define_const(0xFFCD853F, "Peru");
-    gdip_color_define_const(0xFFFFC0CB, "Pink");
-    gdip_color_define_const(0xFFDDA0DD, "Plum");
-    gdip_color_define_const(0xFFB0E0E6, "PowderBlue");
-    gdip_color_define_const(0xFF800080, "Purple");
-    gdip_color_define_const(0xFFFF0000, "Red");
-    gdip_color_define_const(0xFFBC8F8F, "RosyBrown");
-    gdip_color_define_const(0xFF4169E1, "RoyalBlue");
-    gdip_color_define_const(0xFF8B4513, "SaddleBrown");
-    gdip_color_define_const(0xFFFA8072, "Salmon");
-    gdip_color_define_const(0xFFF4A460, "SandyBrown");
-    gdip_color_define_const(0xFF2E8B57, "SeaGreen");
-    gdip_color_define_const(0xFFFFF5EE, "SeaShell");
-    gdip_color_define_const(0xFFA0522D, "Sienna");
-    gdip_color_define_const(0xFFC0C0C0, "Silver");
-    gdip_color_define_const(0xFF87CEEB, "SkyBlue");
-    gdip_color_define_const(0xFF6A5ACD, "SlateBlue");
-    gdip_color_define_const(0xFF708090, "SlateGray");
-    gdip_color_define_const(0xFFFFFAFA, "Snow");
-    gdip_color_define_const(0xFF00FF7F, "SpringGreen");
-    gdip_color_define_const(0xFF4682B4, "SteelBlue");
-    gdip_color_define_const(0xFFD2B48C, "Tan");
-    gdip_color_define_const(0xFF008080, "Teal");
-    gdip_color_define_const(0xFFD8BFD8, "Thistle");
-    gdip_color_define_const(0xFFFF6347, "Tomato");
-    gdip_color_define_const(0x00FFFFFF, "Transparent");
-    gdip_color_define_const(0xFF40E0D0, "Turquoise");
-    gdip_color_define_const(0xFFEE82EE, "Violet");
-    gdip_color_define_const(0xFFF5DEB3, "Wheat");
-    gdip_color_define_const(0xFFFFFFFF, "White");
-    gdip_color_define_const(0xFFF5F5F5, "WhiteSmoke");
-    gdip_color_define_const(0xFFFFFF00, "Yellow");
-    gdip_color_define_const(0xFF9ACD32, "YellowGreen");
+    if (RB_SYMBOL_P(name) && color_lookup_by_id(RB_SYM2ID(name)) != NULL) {
+        return Qtrue;
+    }
+    VALUE args[2] = { name, include_private };
+    return rb_call_super(2, args);
 }
 
 /**
@@ -467,5 +603,10 @@ Init_color()
     rb_define_singleton_method(cColor, "FromArgb", RUBY_METHOD_FUNC(gdip_color_s_from_argb), -1);
     rb_define_alias(rb_singleton_class(cColor), "from_argb", "FromArgb");
 
-    Init_color_constants();
+    // @private
+    rb_define_singleton_method(cColor, "const_missing", RUBY_METHOD_FUNC(gdip_color_s_const_missing), 1);
+    // @private
+    rb_define_singleton_method(cColor, "method_missing", RUBY_METHOD_FUNC(gdip_color_s_method_missing), -1);
+    // @private
+    rb_define_singleton_method(cColor, "respond_to_missing?", RUBY_METHOD_FUNC(gdip_color_s_respond_to_missing_p), 2);
 }
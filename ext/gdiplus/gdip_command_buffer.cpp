@@ -0,0 +1,390 @@
+/*
+ * gdip_command_buffer.cpp
+ * Copyright (c) 2017 Yagi Sumiya
+ * Released under the MIT License.
+ */
+#include "ruby_gdiplus.h"
+
+enum CommandOp {
+    CmdDrawLine,
+    CmdDrawRectangle,
+    CmdFillRectangle,
+    CmdDrawEllipse,
+    CmdFillEllipse,
+    CmdDrawArc,
+    CmdDrawPie,
+    CmdFillPie,
+    CmdOpCount
+};
+
+/* the number of float arguments of each CommandOp */
+static const int cmd_argc[CmdOpCount] = { 4, 4, 4, 4, 4, 6, 6, 6 };
+
+/*
+ * ops: (CommandOp, index of the Pen or Brush in objects) pairs
+ * args: the float arguments of all ops, in order
+ */
+struct gdipCommandBuffer {
+    int *ops;
+    int ops_len;
+    int ops_capa;
+    float *args;
+    int args_len;
+    int args_capa;
+    VALUE objects;
+};
+
+static void
+gdip_cmdbuf_mark(gdipCommandBuffer *cmdbuf)
+{
+    if (cmdbuf != NULL) {
+        _rb_gc_mark_movable(cmdbuf->objects);
+    }
+}
+
+static void
+gdip_cmdbuf_compact(gdipCommandBuffer *cmdbuf)
+{
+    if (cmdbuf != NULL) {
+        cmdbuf->objects = _rb_gc_location(cmdbuf->objects);
+    }
+}
+
+static void
+gdip_cmdbuf_free(gdipCommandBuffer *cmdbuf)
+{
+    if (cmdbuf != NULL) {
+        dp("<CommandBuffer> free");
+        ruby_xfree(cmdbuf->ops);
+        ruby_xfree(cmdbuf->args);
+        ruby_xfree(cmdbuf);
+    }
+}
+
+static size_t
+gdip_cmdbuf_memsize(const void *ptr)
+{
+    const gdipCommandBuffer *cmdbuf = static_cast<const gdipCommandBuffer *>(ptr);
+    return sizeof(gdipCommandBuffer) + cmdbuf->ops_capa * sizeof(int) + cmdbuf->args_capa * sizeof(float);
+}
+
+const rb_data_type_t tCommandBuffer = _MAKE_DATA_TYPE_MOVABLE(
+    "CommandBuffer", RUBY_DATA_FUNC(gdip_cmdbuf_mark), RUBY_DATA_FUNC(gdip_cmdbuf_free), gdip_cmdbuf_memsize,
+    RUBY_DATA_FUNC(gdip_cmdbuf_compact), NULL, &cCommandBuffer);
+
+static VALUE
+gdip_cmdbuf_alloc(VALUE klass)
+{
+    VALUE r = typeddata_alloc<gdipCommandBuffer, &tCommandBuffer>(klass);
+    gdipCommandBuffer *cmdbuf = Data_Ptr<gdipCommandBuffer *>(r);
+    RB_OBJ_WRITE(r, &cmdbuf->objects, rb_ary_new());
+    return r;
+}
+
+static int
+gdip_cmdbuf_object_index(gdipCommandBuffer *cmdbuf, VALUE obj)
+{
+    long len = RARRAY_LEN(cmdbuf->objects);
+    if (len > 0 && rb_ary_entry(cmdbuf->objects, len - 1) == obj) {
+        return static_cast<int>(len - 1);
+    }
+    rb_ary_push(cmdbuf->objects, obj);
+    return static_cast<int>(len);
+}
+
+static gdipCommandBuffer *
+gdip_cmdbuf_get_modifiable(VALUE self)
+{
+    gdipCommandBuffer *cmdbuf = Data_Ptr<gdipCommandBuffer *>(self);
+    Check_Frozen(self);
+    if (gdip_busy_p(cmdbuf)) {
+        rb_raise(eGdiplus, "The object is being used by another thread.");
+    }
+    return cmdbuf;
+}
+
+static void
+gdip_cmdbuf_push(VALUE self, CommandOp op, VALUE obj, int argc, VALUE *argv)
+{
+    gdipCommandBuffer *cmdbuf = gdip_cmdbuf_get_modifiable(self);
+    if (argc != cmd_argc[op]) {
+        rb_raise(rb_eArgError, "wrong number of arguments (%d for %d)", argc + 1, cmd_argc[op] + 1);
+    }
+    if (cmdbuf->ops_len + 2 > cmdbuf->ops_capa) {
+        int capa = cmdbuf->ops_capa == 0 ? 64 : cmdbuf->ops_capa * 2;
+        cmdbuf->ops = static_cast<int *>(ruby_xrealloc(cmdbuf->ops, capa * sizeof(int)));
+        cmdbuf->ops_capa = capa;
+    }
+    if (cmdbuf->args_len + argc > cmdbuf->args_capa) {
+        int capa = cmdbuf->args_capa == 0 ? 256 : cmdbuf->args_capa * 2;
+        cmdbuf->args = static_cast<float *>(ruby_xrealloc(cmdbuf->args, capa * sizeof(float)));
+        cmdbuf->args_capa = capa;
+    }
+    float *args = cmdbuf->args + cmdbuf->args_len;
+    for (int i = 0; i < argc; ++i) {
+        args[i] = NUM2SINGLE(argv[i]);
+    }
+    cmdbuf->ops[cmdbuf->ops_len] = op;
+    cmdbuf->ops[cmdbuf->ops_len + 1] = gdip_cmdbuf_object_index(cmdbuf, obj);
+    cmdbuf->ops_len += 2;
+    cmdbuf->args_len += argc;
+}
+
+static void
+gdip_cmdbuf_push_pen(int argc, VALUE *argv, VALUE self, CommandOp op)
+{
+    if (argc < 1 || !_KIND_OF(argv[0], &tPen)) {
+        rb_raise(rb_eTypeError, "The first argument should be Pen.");
+    }
+    gdip_cmdbuf_push(self, op, argv[0], argc - 1, argv + 1);
+}
+
+static void
+gdip_cmdbuf_push_brush(int argc, VALUE *argv, VALUE self, CommandOp op)
+{
+    if (argc < 1 || !_KIND_OF(argv[0], &tBrush)) {
+        rb_raise(rb_eTypeError, "The first argument should be Brush.");
+    }
+    gdip_cmdbuf_push(self, op, argv[0], argc - 1, argv + 1);
+}
+
+/**
+ * @overload DrawLine(pen, x1, y1, x2, y2)
+ *   @param pen [Pen]
+ *   @param x1 [Integer or Float]
+ *   @param y1 [Integer or Float]
+ *   @param x2 [Integer or Float]
+ *   @param y2 [Integer or Float]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_draw_line(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_pen(argc, argv, self, CmdDrawLine);
+    return self;
+}
+
+/**
+ * @overload DrawRectangle(pen, x, y, width, height)
+ *   @param pen [Pen]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_draw_rectangle(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_pen(argc, argv, self, CmdDrawRectangle);
+    return self;
+}
+
+/**
+ * @overload FillRectangle(brush, x, y, width, height)
+ *   @param brush [Brush]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_fill_rectangle(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_brush(argc, argv, self, CmdFillRectangle);
+    return self;
+}
+
+/**
+ * @overload DrawEllipse(pen, x, y, width, height)
+ *   @param pen [Pen]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_draw_ellipse(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_pen(argc, argv, self, CmdDrawEllipse);
+    return self;
+}
+
+/**
+ * @overload FillEllipse(brush, x, y, width, height)
+ *   @param brush [Brush]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_fill_ellipse(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_brush(argc, argv, self, CmdFillEllipse);
+    return self;
+}
+
+/**
+ * @overload DrawArc(pen, x, y, width, height, start_angle, sweep_angle)
+ *   @param pen [Pen]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_draw_arc(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_pen(argc, argv, self, CmdDrawArc);
+    return self;
+}
+
+/**
+ * @overload DrawPie(pen, x, y, width, height, start_angle, sweep_angle)
+ *   @param pen [Pen]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_draw_pie(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_pen(argc, argv, self, CmdDrawPie);
+    return self;
+}
+
+/**
+ * @overload FillPie(brush, x, y, width, height, start_angle, sweep_angle)
+ *   @param brush [Brush]
+ *   @return [self]
+ */
+static VALUE
+gdip_cmdbuf_fill_pie(int argc, VALUE *argv, VALUE self)
+{
+    gdip_cmdbuf_push_brush(argc, argv, self, CmdFillPie);
+    return self;
+}
+
+/**
+ * Removes all commands. The allocated memory is kept for reuse.
+ * @return [self]
+ */
+static VALUE
+gdip_cmdbuf_clear(VALUE self)
+{
+    gdipCommandBuffer *cmdbuf = gdip_cmdbuf_get_modifiable(self);
+    cmdbuf->ops_len = 0;
+    cmdbuf->args_len = 0;
+    rb_ary_clear(cmdbuf->objects);
+    return self;
+}
+
+/**
+ * The number of commands.
+ * @return [Integer]
+ */
+static VALUE
+gdip_cmdbuf_size(VALUE self)
+{
+    gdipCommandBuffer *cmdbuf = Data_Ptr<gdipCommandBuffer *>(self);
+    return RB_INT2NUM(cmdbuf->ops_len / 2);
+}
+
+/*
+ * Replays +v_cmdbuf+ on +g+. The Pens and Brushes are resolved first,
+ * then the whole list runs in one loop without the GVL. Meanwhile the
+ * buffer, its Pens and its Brushes are busy: modifying the buffer or
+ * disposing them from another thread raises GdiplusError.
+ */
+Status
+gdip_cmdbuf_execute(Graphics *g, VALUE v_cmdbuf)
+{
+    if (!_KIND_OF(v_cmdbuf, &tCommandBuffer)) {
+        rb_raise(rb_eTypeError, "The argument should be Graphics::CommandBuffer.");
+    }
+    gdipCommandBuffer *cmdbuf = Data_Ptr<gdipCommandBuffer *>(v_cmdbuf);
+    if (cmdbuf->ops_len == 0) return Ok;
+
+    long obj_count = RARRAY_LEN(cmdbuf->objects);
+    VALUE tmp = Qnil;
+    void **objs = static_cast<void **>(_rb_alloc_tmp_buffer(&tmp, obj_count * sizeof(void *)));
+    for (long i = 0; i < obj_count; ++i) {
+        objs[i] = Data_Ptr<void *>(rb_ary_entry(cmdbuf->objects, i));
+        if (objs[i] == NULL) {
+            _rb_free_tmp_buffer(&tmp);
+            rb_raise(eGdiplus, "The Pen or Brush object does not exist.");
+        }
+    }
+
+    int *ops = cmdbuf->ops;
+    int ops_len = cmdbuf->ops_len;
+    float *args = cmdbuf->args;
+    Status status = GenericError;
+    gdip_busy_enter_all(objs, obj_count);
+    _rb_ensure(
+        [&]() -> VALUE {
+            status = gdip_call_without_gvl([&]() -> Status {
+                Status st = Ok;
+                float *a = args;
+                for (int i = 0; i < ops_len && st == Ok; i += 2) {
+                    void *obj = objs[ops[i + 1]];
+                    switch (ops[i]) {
+                        case CmdDrawLine:
+                            st = g->DrawLine(static_cast<Pen *>(obj), a[0], a[1], a[2], a[3]);
+                            break;
+                        case CmdDrawRectangle:
+                            st = g->DrawRectangle(static_cast<Pen *>(obj), a[0], a[1], a[2], a[3]);
+                            break;
+                        case CmdFillRectangle:
+                            st = g->FillRectangle(static_cast<Brush *>(obj), a[0], a[1], a[2], a[3]);
+                            break;
+                        case CmdDrawEllipse:
+                            st = g->DrawEllipse(static_cast<Pen *>(obj), a[0], a[1], a[2], a[3]);
+                            break;
+                        case CmdFillEllipse:
+                            st = g->FillEllipse(static_cast<Brush *>(obj), a[0], a[1], a[2], a[3]);
+                            break;
+                        case CmdDrawArc:
+                            st = g->DrawArc(static_cast<Pen *>(obj), a[0], a[1], a[2], a[3], a[4], a[5]);
+                            break;
+                        case CmdDrawPie:
+                            st = g->DrawPie(static_cast<Pen *>(obj), a[0], a[1], a[2], a[3], a[4], a[5]);
+                            break;
+                        case CmdFillPie:
+                            st = g->FillPie(static_cast<Brush *>(obj), a[0], a[1], a[2], a[3], a[4], a[5]);
+                            break;
+                    }
+                    a += cmd_argc[ops[i]];
+                }
+                return st;
+            }, g, cmdbuf);
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            gdip_busy_leave_all(objs, obj_count);
+            _rb_free_tmp_buffer(&tmp);
+            return Qnil;
+        });
+    RB_GC_GUARD(v_cmdbuf);
+    return status;
+}
+
+/*
+Document-class: Gdiplus::Graphics::CommandBuffer
+A list of drawing commands packed into native arrays.
+It is replayed by {Graphics#execute} in one call and can be reused with {#clear}.
+@example
+  buf = Gdiplus::Graphics::CommandBuffer.new
+  data.each_with_index {|v, i| buf.FillRectangle(brush, i * 4, 300 - v, 3, v) }
+  bmp.draw {|g| g.execute(buf) }
+*/
+void
+Init_command_buffer()
+{
+    cCommandBuffer = rb_define_class_under(cGraphics, "CommandBuffer", rb_cObject);
+    rb_define_alloc_func(cCommandBuffer, gdip_cmdbuf_alloc);
+
+    rb_define_method(cCommandBuffer, "DrawLine", RUBY_METHOD_FUNC(gdip_cmdbuf_draw_line), -1);
+    rb_define_alias(cCommandBuffer, "draw_line", "DrawLine");
+    rb_define_method(cCommandBuffer, "DrawRectangle", RUBY_METHOD_FUNC(gdip_cmdbuf_draw_rectangle), -1);
+    rb_define_alias(cCommandBuffer, "draw_rectangle", "DrawRectangle");
+    rb_define_method(cCommandBuffer, "FillRectangle", RUBY_METHOD_FUNC(gdip_cmdbuf_fill_rectangle), -1);
+    rb_define_alias(cCommandBuffer, "fill_rectangle", "FillRectangle");
+    rb_define_method(cCommandBuffer, "DrawEllipse", RUBY_METHOD_FUNC(gdip_cmdbuf_draw_ellipse), -1);
+    rb_define_alias(cCommandBuffer, "draw_ellipse", "DrawEllipse");
+    rb_define_method(cCommandBuffer, "FillEllipse", RUBY_METHOD_FUNC(gdip_cmdbuf_fill_ellipse), -1);
+    rb_define_alias(cCommandBuffer, "fill_ellipse", "FillEllipse");
+    rb_define_method(cCommandBuffer, "DrawArc", RUBY_METHOD_FUNC(gdip_cmdbuf_draw_arc), -1);
+    rb_define_alias(cCommandBuffer, "draw_arc", "DrawArc");
+    rb_define_method(cCommandBuffer, "DrawPie", RUBY_METHOD_FUNC(gdip_cmdbuf_draw_pie), -1);
+    rb_define_alias(cCommandBuffer, "draw_pie", "DrawPie");
+    rb_define_method(cCommandBuffer, "FillPie", RUBY_METHOD_FUNC(gdip_cmdbuf_fill_pie), -1);
+    rb_define_alias(cCommandBuffer, "fill_pie", "FillPie");
+
+    rb_define_method(cCommandBuffer, "clear", RUBY_METHOD_FUNC(gdip_cmdbuf_clear), 0);
+    rb_define_method(cCommandBuffer, "size", RUBY_METHOD_FUNC(gdip_cmdbuf_size), 0);
+    rb_define_alias(cCommandBuffer, "length", "size");
+}
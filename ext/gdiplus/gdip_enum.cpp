@@ -37,10 +37,72 @@ public:
             delete this->ValTable[i];
         }
     }
+#if RUBY_API_VERSION_CODE >= 20700
+    /* The table is sorted by the class VALUE, so the class must never be moved by GC.compact. */
+    virtual bool set(VALUE klass, MapBase *table) {
+        rb_gc_register_mark_object(klass);
+        return SortedArrayMap<VALUE, MapBase *>::set(klass, table);
+    }
+#endif
 };
 
 static KlassTableMap klass_table_map(60);
 
+/*
+ * Symbol ID => value of each constant of an enum class, filled when the
+ * constants are defined, so a Symbol argument such as :AntiAlias resolves
+ * without constant lookups.
+ */
+class KlassSymbolMap : public SortedArrayMap<VALUE, st_table *> {
+public:
+    KlassSymbolMap(int capa) : SortedArrayMap<VALUE, st_table *>(capa) {}
+    virtual ~KlassSymbolMap() {
+        for (int i = 0; i < this->Len; ++i) {
+            st_free_table(this->ValTable[i]);
+        }
+    }
+#if RUBY_API_VERSION_CODE >= 20700
+    virtual bool set(VALUE klass, st_table *table) {
+        rb_gc_register_mark_object(klass);
+        return SortedArrayMap<VALUE, st_table *>::set(klass, table);
+    }
+#endif
+};
+
+static KlassSymbolMap klass_symbol_map(60);
+
+static void
+gdip_enum_symbol_add(VALUE klass, ID id, int num)
+{
+    st_table *table = NULL;
+    if (!klass_symbol_map.get(klass, table)) {
+        table = st_init_numtable();
+        klass_symbol_map.set(klass, table);
+    }
+    st_insert(table, static_cast<st_data_t>(id), static_cast<st_data_t>(static_cast<unsigned int>(num)));
+}
+
+static inline void
+gdip_enum_symbol_add(VALUE klass, ID id, unsigned int num)
+{
+    gdip_enum_symbol_add(klass, id, static_cast<int>(num));
+}
+
+static inline void
+gdip_enum_symbol_add(VALUE klass, ID id, GUID *guid) { }
+
+static bool
+gdip_enum_symbol_lookup(VALUE klass, ID id, int *num)
+{
+    st_table *table = NULL;
+    st_data_t v;
+    if (klass_symbol_map.get(klass, table) && st_lookup(table, static_cast<st_data_t>(id), &v)) {
+        *num = static_cast<int>(static_cast<unsigned int>(v));
+        return true;
+    }
+    return false;
+}
+
 template <typename TKey>
 static IMap<TKey, ID>*
 gdip_enum_get_table(VALUE klass)
@@ -59,10 +121,33 @@ gdip_enum_const_get(VALUE self)
 const rb_data_type_t tEnumInt = _MAKE_DATA_TYPE(
     "EnumInt", 0, RUBY_NEVER_FREE, NULL, NULL, &cEnumInt);
 
+/*
+ * Instances are interned per class in a Hash (num => frozen instance) kept in
+ * a hidden instance variable of the class, so getters and flag operators
+ * returning a known value allocate nothing. The constants are the first entries.
+ */
+static ID id_interned;
+static const long EnumInternMax = 1024;
+
 VALUE
 gdip_enumint_create(VALUE klass, int num)
 {
+    VALUE key = RB_INT2NUM(num);
+    VALUE interned = rb_attr_get(klass, id_interned);
+    if (!RB_NIL_P(interned)) {
+        VALUE r = rb_hash_aref(interned, key);
+        if (!RB_NIL_P(r)) return r;
+    }
     VALUE r = _Data_Wrap_Struct(klass, &tEnumInt, reinterpret_cast<void*>(num));
+    rb_obj_freeze(r);
+    if (RB_NIL_P(interned)) {
+        if (RB_OBJ_FROZEN(klass)) return r;
+        interned = rb_hash_new();
+        rb_ivar_set(klass, id_interned, interned);
+    }
+    if (RHASH_SIZE(interned) < EnumInternMax) {
+        rb_hash_aset(interned, key, r);
+    }
     return r;
 }
 
@@ -71,6 +156,9 @@ gdip_arg_to_enumint(VALUE klass, VALUE arg, void *enumint, const char *raise_msg
 {
     int *num = static_cast<int *>(enumint);
 
+    if (RB_SYMBOL_P(arg) && gdip_enum_symbol_lookup(klass, RB_SYM2ID(arg), num)) {
+        return true;
+    }
     if (RB_SYMBOL_P(arg) && rb_const_defined_at(klass, RB_SYM2ID(arg))) {
         arg = rb_const_get(klass, RB_SYM2ID(arg));
     }
@@ -494,8 +582,9 @@ gdip_enum_define(VALUE klass, IMap<TKey, ID> *table, const char *name, TKey data
 {
     rb_define_const(klass, name, v);
     rb_define_singleton_method(klass, name, RUBY_METHOD_FUNC(gdip_enum_const_get), 0);
+    ID id = rb_intern(name);
+    gdip_enum_symbol_add(klass, id, data);
     if (table != NULL) {
-        ID id = rb_intern(name);
         table->append(data, id);
     }
 }
@@ -1304,6 +1393,19 @@ Init_ColorMatrixFlag()
     define_enumint(cColorMatrixFlag, table, "AltGray", 2);
 }
 
+static void
+Init_ImageLockMode()
+{
+    cImageLockMode = rb_define_class_under(mGdiplus, "ImageLockMode", cEnumFlags);
+    SortedArrayMap<unsigned int, ID> *table = new SortedArrayMap<unsigned int, ID>(4);
+    klass_table_map.set(cImageLockMode, table);
+
+    define_enumflags(cImageLockMode, table, "ReadOnly", ImageLockModeRead);
+    define_enumflags(cImageLockMode, table, "WriteOnly", ImageLockModeWrite);
+    define_enumflags(cImageLockMode, table, "ReadWrite", ImageLockModeRead | ImageLockModeWrite);
+    define_enumflags(cImageLockMode, table, "UserInputBuffer", ImageLockModeUserInputBuf);
+}
+
 
 /* Encoder */
 
@@ -1478,6 +1580,7 @@ Init_imageformat()
 void
 Init_enum() {
     ID_UNKNOWN = rb_intern("__UNKNOWN__");
+    id_interned = rb_intern("__gdip_interned__");
 
     cEnumInt = rb_define_class_under(mInternals, "EnumInt", rb_cObject);
     rb_undef_alloc_func(cEnumInt);
@@ -1542,6 +1645,7 @@ Init_enum() {
     Init_ColorAdjustType();
     Init_ColorChannelFlag();
     Init_ColorMatrixFlag();
+    Init_ImageLockMode();
     /* GUID */
     Init_Encoder();
     Init_imageformat();
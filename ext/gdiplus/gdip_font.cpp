@@ -6,20 +6,20 @@
 #include "ruby_gdiplus.h"
 
 const rb_data_type_t tFontFamily = _MAKE_DATA_TYPE(
-    "FontFamily", 0, GDIP_OBJ_FREE(FontFamily *), NULL, NULL, &cFontFamily);
+    "FontFamily", 0, GDIP_OBJ_FREE(FontFamily *), GDIP_OBJ_MEMSIZE(FontFamily *), NULL, &cFontFamily);
 
 const rb_data_type_t tFontCollection = _MAKE_DATA_TYPE(
-    "FontCollection", 0, GDIP_OBJ_FREE(FontCollection *), NULL, NULL, &cFontCollection);
+    "FontCollection", 0, GDIP_OBJ_FREE(FontCollection *), GDIP_OBJ_MEMSIZE(FontCollection *), NULL, &cFontCollection);
 
 const rb_data_type_t tInstalledFontCollection = _MAKE_DATA_TYPE(
-    "InstalledFontCollection", 0, GDIP_OBJ_FREE(InstalledFontCollection *), NULL, &tFontCollection, &cInstalledFontCollection);
+    "InstalledFontCollection", 0, GDIP_OBJ_FREE(InstalledFontCollection *), GDIP_OBJ_MEMSIZE(InstalledFontCollection *), &tFontCollection, &cInstalledFontCollection);
 
 const rb_data_type_t tPrivateFontCollection = _MAKE_DATA_TYPE(
-    "PrivateFontCollection", 0, GDIP_OBJ_FREE(PrivateFontCollection *), NULL, &tFontCollection, &cPrivateFontCollection);
+    "PrivateFontCollection", 0, GDIP_OBJ_FREE(PrivateFontCollection *), GDIP_OBJ_MEMSIZE(PrivateFontCollection *), &tFontCollection, &cPrivateFontCollection);
 
 
 const rb_data_type_t tFont = _MAKE_DATA_TYPE(
-    "Font", 0, GDIP_OBJ_FREE(Font *), NULL, NULL, &cFont);
+    "Font", 0, GDIP_OBJ_FREE(Font *), GDIP_OBJ_MEMSIZE(Font *), NULL, &cFont);
 
 
 
@@ -32,6 +32,38 @@ gdip_fontfamily_create(FontFamily *fontfamily)
 }
 
 
+static bool
+test_font()
+{
+    GdiplusEnsureStarted();
+    InstalledFontCollection *fontcol = new InstalledFontCollection();
+    if (fontcol == NULL) {
+        return false;
+    }
+    else {
+        int count = fontcol->GetFamilyCount();
+        delete fontcol;
+        return count == 0 ? false : true;
+    }
+}
+
+/* Checked when fonts are first used instead of at load time, which would start GDI+. */
+static void
+warn_if_font_broken()
+{
+    static bool checked = false;
+    if (checked) return;
+    checked = true;
+    if (test_font() == false) {
+        _WARNING(
+            "\n"
+            "Because of 'AddDllDirectory' or 'SetDefaultDllDirectories' on windows 7, \n"
+            "You can not get installed fonts. (The functions is used by rubyinstaller2.)\n"
+            "Please use PrivateFontCollection#AddFontFile(path_to_font) to get FontFamily.\n"
+            );
+    }
+}
+
 static VALUE vGenericSansSerif = Qnil;
 static VALUE vGenericSerif = Qnil;
 static VALUE vGenericMonospace = Qnil;
@@ -40,6 +72,7 @@ static VALUE
 gdip_fontfamily_s_get_generic_sans_serif(VALUE self)
 {
     if (RB_NIL_P(vGenericSansSerif)) {
+        GdiplusEnsureStarted();
         #if IFVC
             const FontFamily *family = FontFamily::GenericSansSerif();
             if (family == NULL) {
@@ -58,6 +91,7 @@ static VALUE
 gdip_fontfamily_s_get_generic_serif(VALUE self)
 {
     if (RB_NIL_P(vGenericSerif)) {
+        GdiplusEnsureStarted();
         #if IFVC
             const FontFamily *family = FontFamily::GenericSerif();
             if (family == NULL) {
@@ -76,6 +110,7 @@ static VALUE
 gdip_fontfamily_s_get_generic_monospace(VALUE self)
 {
     if (RB_NIL_P(vGenericMonospace)) {
+        GdiplusEnsureStarted();
         #if IFVC
             const FontFamily *family = FontFamily::GenericMonospace();
             if (family == NULL) {
@@ -105,6 +140,7 @@ gdip_fontfamily_init(int argc, VALUE *argv, VALUE self)
     if (argc == 1) {
         int gff;
         if (_RB_STRING_P(argv[0])) {
+            warn_if_font_broken();
             VALUE wstr = util_utf16_str_new(argv[0]);
             _DATA_PTR(self) = gdip_obj_create(new FontFamily(RString_Ptr<WCHAR *>(wstr)));
             RB_GC_GUARD(wstr);
@@ -243,6 +279,8 @@ gdip_fontfamily_get_line_spacing(int argc, VALUE *argv, VALUE self)
 static VALUE
 gdip_instfontcol_alloc(VALUE klass)
 {
+    GdiplusEnsureStarted();
+    warn_if_font_broken();
     InstalledFontCollection *ptr = gdip_obj_create(new InstalledFontCollection());
     dp("InstalledFontCollection alloc");
     VALUE r = _Data_Wrap_Struct(klass, &tInstalledFontCollection, ptr);
@@ -252,6 +290,7 @@ gdip_instfontcol_alloc(VALUE klass)
 static VALUE
 gdip_privfontcol_alloc(VALUE klass)
 {
+    GdiplusEnsureStarted();
     PrivateFontCollection *ptr = gdip_obj_create(new PrivateFontCollection());
     dp("PrivateFontCollection alloc");
     VALUE r = _Data_Wrap_Struct(klass, &tPrivateFontCollection, ptr);
@@ -530,20 +569,6 @@ gdip_font_m_get_height(int argc, VALUE *argv, VALUE self)
     return Qnil;
 }
 
-static bool
-test_font()
-{
-    InstalledFontCollection *fontcol = new InstalledFontCollection();
-    if (fontcol == NULL) {
-        return false;
-    }
-    else {
-        int count = fontcol->GetFamilyCount();
-        delete fontcol;
-        return count == 0 ? false : true;
-    }
-}
-
 
 static VALUE
 gdip_instfontcol_s_broken(VALUE self)
@@ -617,13 +642,4 @@ Init_font()
 
     rb_define_method(cFont, "GetHeight", RUBY_METHOD_FUNC(gdip_font_m_get_height), -1);
     rb_define_alias(cFont, "get_height", "GetHeight");
-
-    if (test_font() == false) {
-        _WARNING(
-            "\n"
-            "Because of 'AddDllDirectory' or 'SetDefaultDllDirectories' on windows 7, \n"
-            "You can not get installed fonts. (The functions is used by rubyinstaller2.)\n"
-            "Please use PrivateFontCollection#AddFontFile(path_to_font) to get FontFamily.\n"
-            );
-    }
 }
\ No newline at end of file
@@ -0,0 +1,571 @@
+/*
+ * gdip_geometry_array.cpp
+ * Copyright (c) 2017 Yagi Sumiya
+ * Released under the MIT License.
+ */
+#include "ruby_gdiplus.h"
+
+/*
+ * A growable native array of PointF or RectF.
+ * Both are plain structs of floats, so the storage is also a flat float
+ * array and is passed to GDI+ as it is.
+ */
+template<typename T>
+struct gdipGeomArray {
+    T *ptr;
+    int len;
+    int capa;
+};
+
+template<typename T>
+static void
+gdip_garray_free(gdipGeomArray<T> *ary)
+{
+    if (ary != NULL) {
+        GDIP_TRACE(TraceFree, type_name<gdipGeomArray<T> >(), ary);
+        ruby_xfree(ary->ptr);
+        ruby_xfree(ary);
+    }
+}
+
+template<typename T>
+static size_t
+gdip_garray_memsize(const void *ptr)
+{
+    const gdipGeomArray<T> *ary = static_cast<const gdipGeomArray<T> *>(ptr);
+    return sizeof(gdipGeomArray<T>) + ary->capa * sizeof(T);
+}
+
+const rb_data_type_t tPointFArray = _MAKE_DATA_TYPE(
+    "PointFArray", 0, RUBY_DATA_FUNC(gdip_garray_free<PointF>), gdip_garray_memsize<PointF>, NULL, &cPointFArray);
+const rb_data_type_t tRectFArray = _MAKE_DATA_TYPE(
+    "RectFArray", 0, RUBY_DATA_FUNC(gdip_garray_free<RectF>), gdip_garray_memsize<RectF>, NULL, &cRectFArray);
+
+/* the number of floats of an element */
+template<typename T> static inline int garray_coords() { return static_cast<int>(sizeof(T) / sizeof(float)); }
+
+template<typename T> static const rb_data_type_t *garray_type();
+template<> inline const rb_data_type_t *garray_type<PointF>() { return &tPointFArray; }
+template<> inline const rb_data_type_t *garray_type<RectF>() { return &tRectFArray; }
+
+static inline VALUE
+garray_elem_create(const PointF& point)
+{
+    return gdip_pointf_create(point.X, point.Y);
+}
+
+static inline VALUE
+garray_elem_create(const RectF& rect)
+{
+    return gdip_rectf_create(rect.X, rect.Y, rect.Width, rect.Height);
+}
+
+static bool
+garray_elem_get(VALUE v, PointF& point)
+{
+    if (_KIND_OF(v, &tPointF)) {
+        point = *Data_Ptr<PointF *>(v);
+    }
+    else if (_KIND_OF(v, &tPoint)) {
+        Point *po = Data_Ptr<Point *>(v);
+        point.X = static_cast<float>(po->X);
+        point.Y = static_cast<float>(po->Y);
+    }
+    else return false;
+    return true;
+}
+
+static bool
+garray_elem_get(VALUE v, RectF& rect)
+{
+    if (_KIND_OF(v, &tRectangleF)) {
+        rect = *Data_Ptr<RectF *>(v);
+    }
+    else if (_KIND_OF(v, &tRectangle)) {
+        Rect *r = Data_Ptr<Rect *>(v);
+        rect.X = static_cast<float>(r->X);
+        rect.Y = static_cast<float>(r->Y);
+        rect.Width = static_cast<float>(r->Width);
+        rect.Height = static_cast<float>(r->Height);
+    }
+    else return false;
+    return true;
+}
+
+static inline const char *
+garray_elem_error(const PointF *)
+{
+    return "The argument should be Point or PointF.";
+}
+
+static inline const char *
+garray_elem_error(const RectF *)
+{
+    return "The argument should be Rectangle or RectangleF.";
+}
+
+template<typename T>
+static inline gdipGeomArray<T> *
+garray_get(VALUE self)
+{
+    return Data_Ptr<gdipGeomArray<T> *>(self);
+}
+
+template<typename T>
+static T *
+garray_reserve(gdipGeomArray<T> *ary, long count)
+{
+    long need = ary->len + count;
+    if (need > INT_MAX) {
+        rb_raise(rb_eArgError, "Too many elements.");
+    }
+    if (need > ary->capa) {
+        long capa = ary->capa == 0 ? 16 : ary->capa;
+        while (capa < need) capa *= 2;
+        if (capa > INT_MAX) capa = INT_MAX;
+        ary->ptr = static_cast<T *>(ruby_xrealloc(ary->ptr, capa * sizeof(T)));
+        ary->capa = static_cast<int>(capa);
+    }
+    return ary->ptr + ary->len;
+}
+
+template<typename T>
+static VALUE
+gdip_garray_alloc(VALUE klass)
+{
+    void *ptr = RB_ZALLOC(gdipGeomArray<T>);
+    GDIP_TRACE(TraceAlloc, type_name<gdipGeomArray<T> >(), ptr);
+    return _Data_Wrap_Struct(klass, garray_type<T>(), ptr);
+}
+
+template<typename T>
+static VALUE
+garray_create(const T *elems, int count)
+{
+    VALUE r = gdip_garray_alloc<T>(*static_cast<VALUE *>(garray_type<T>()->data));
+    if (count > 0) {
+        gdipGeomArray<T> *ary = garray_get<T>(r);
+        memcpy(garray_reserve(ary, count), elems, count * sizeof(T));
+        ary->len = count;
+    }
+    return r;
+}
+
+/*
+ * Appends +v+: another array of the same class, an Array of elements,
+ * a flat Array of numbers or a binary String of floats.
+ */
+template<typename T>
+static void
+garray_concat(VALUE self, VALUE v)
+{
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    const int coords = garray_coords<T>();
+    if (_KIND_OF(v, garray_type<T>())) {
+        gdipGeomArray<T> *other = garray_get<T>(v);
+        int count = other->len;
+        T *dest = garray_reserve(ary, count);
+        memmove(dest, other->ptr, count * sizeof(T));
+        ary->len += count;
+    }
+    else if (_RB_STRING_P(v)) {
+        long len = RSTRING_LEN(v);
+        if (len % sizeof(T) != 0) {
+            rb_raise(rb_eArgError, "The length of the string should be a multiple of %d.", static_cast<int>(sizeof(T)));
+        }
+        long count = len / static_cast<long>(sizeof(T));
+        T *dest = garray_reserve(ary, count);
+        memcpy(dest, RSTRING_PTR(v), count * sizeof(T));
+        ary->len += static_cast<int>(count);
+    }
+    else if (_RB_ARRAY_P(v)) {
+        long len = RARRAY_LEN(v);
+        if (len == 0) return;
+        VALUE first = rb_ary_entry(v, 0);
+        if (Integer_p(first) || Float_p(first)) {
+            if (len % coords != 0) {
+                rb_raise(rb_eArgError, "The number of elements should be a multiple of %d.", coords);
+            }
+            long count = len / coords;
+            float *dest = reinterpret_cast<float *>(garray_reserve(ary, count));
+            for (long i = 0; i < len; ++i) {
+                dest[i] = NUM2SINGLE(rb_ary_entry(v, i));
+            }
+            ary->len += static_cast<int>(count);
+        }
+        else {
+            T *dest = garray_reserve(ary, len);
+            for (long i = 0; i < len; ++i) {
+                if (!garray_elem_get(rb_ary_entry(v, i), dest[i])) {
+                    rb_raise(rb_eTypeError, "%s", garray_elem_error(ary->ptr));
+                }
+            }
+            ary->len += static_cast<int>(len);
+        }
+    }
+    else {
+        rb_raise(rb_eTypeError, "%s", garray_elem_error(ary->ptr));
+    }
+}
+
+/**
+ * @overload initialize(elements = nil)
+ *   @param elements [Array, String, PointFArray or RectFArray]
+ *     Elements, a flat Array of numbers or a binary String of floats (pack('f*')).
+ */
+template<typename T>
+static VALUE
+gdip_garray_init(int argc, VALUE *argv, VALUE self)
+{
+    VALUE v_elems = Qnil;
+    rb_scan_args(argc, argv, "01", &v_elems);
+    if (!RB_NIL_P(v_elems)) {
+        garray_concat<T>(self, v_elems);
+    }
+    return self;
+}
+
+/**
+ * @return [self]
+ */
+template<typename T>
+static VALUE
+gdip_garray_append(VALUE self, VALUE v)
+{
+    Check_Frozen(self);
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    T elem;
+    if (!garray_elem_get(v, elem)) {
+        rb_raise(rb_eTypeError, "%s", garray_elem_error(&elem));
+    }
+    *garray_reserve(ary, 1) = elem;
+    ary->len += 1;
+    return self;
+}
+
+/**
+ * @overload concat(elements)
+ *   @param elements [Array, String, PointFArray or RectFArray]
+ *   @return [self]
+ */
+template<typename T>
+static VALUE
+gdip_garray_concat(VALUE self, VALUE v)
+{
+    Check_Frozen(self);
+    garray_concat<T>(self, v);
+    return self;
+}
+
+/**
+ * @overload [](index)
+ *   @return [PointF, RectangleF or nil] a copy of the element
+ * @overload [](start, length)
+ *   @return [PointFArray, RectFArray or nil]
+ * @overload [](range)
+ *   @return [PointFArray, RectFArray or nil]
+ */
+template<typename T>
+static VALUE
+gdip_garray_aref(int argc, VALUE *argv, VALUE self)
+{
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    long beg, len;
+    if (argc == 2) {
+        beg = NUM2LONG(argv[0]);
+        len = NUM2LONG(argv[1]);
+        if (beg < 0) beg += ary->len;
+        if (beg < 0 || ary->len < beg || len < 0) return Qnil;
+        if (ary->len < beg + len) len = ary->len - beg;
+        return garray_create(ary->ptr + beg, static_cast<int>(len));
+    }
+    if (argc != 1) {
+        rb_raise(rb_eArgError, "wrong number of arguments (%d for 1..2)", argc);
+    }
+    if (Integer_p(argv[0])) {
+        long idx = NUM2LONG(argv[0]);
+        if (idx < 0) idx += ary->len;
+        if (idx < 0 || ary->len <= idx) return Qnil;
+        return garray_elem_create(ary->ptr[idx]);
+    }
+    switch (rb_range_beg_len(argv[0], &beg, &len, ary->len, 0)) {
+        case Qfalse:
+            rb_raise(rb_eTypeError, "The argument should be Integer or Range.");
+        case Qnil:
+            return Qnil;
+    }
+    return garray_create(ary->ptr + beg, static_cast<int>(len));
+}
+
+/**
+ * @overload []=(index, element)
+ *   @param index [Integer]
+ *   @param element [Point, PointF, Rectangle or RectangleF]
+ */
+template<typename T>
+static VALUE
+gdip_garray_aset(VALUE self, VALUE v_idx, VALUE v)
+{
+    Check_Frozen(self);
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    long idx = NUM2LONG(v_idx);
+    if (idx < 0) idx += ary->len;
+    if (idx < 0 || ary->len <= idx) {
+        rb_raise(rb_eIndexError, "index %ld out of array", NUM2LONG(v_idx));
+    }
+    if (!garray_elem_get(v, ary->ptr[idx])) {
+        rb_raise(rb_eTypeError, "%s", garray_elem_error(ary->ptr));
+    }
+    return v;
+}
+
+/**
+ * Yields a copy of each element.
+ * @return [self]
+ */
+template<typename T>
+static VALUE
+gdip_garray_each(VALUE self)
+{
+    RETURN_ENUMERATOR(self, 0, 0);
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    for (int i = 0; i < ary->len; ++i) {
+        rb_yield(garray_elem_create(ary->ptr[i]));
+    }
+    return self;
+}
+
+/**
+ * @return [Integer]
+ */
+template<typename T>
+static VALUE
+gdip_garray_size(VALUE self)
+{
+    return RB_INT2NUM(garray_get<T>(self)->len);
+}
+
+/**
+ * Removes all elements. The allocated memory is kept for reuse.
+ * @return [self]
+ */
+template<typename T>
+static VALUE
+gdip_garray_clear(VALUE self)
+{
+    Check_Frozen(self);
+    garray_get<T>(self)->len = 0;
+    return self;
+}
+
+/**
+ * @return [Array<PointF or RectangleF>]
+ */
+template<typename T>
+static VALUE
+gdip_garray_to_a(VALUE self)
+{
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    VALUE r = rb_ary_new_capa(ary->len);
+    for (int i = 0; i < ary->len; ++i) {
+        rb_ary_push(r, garray_elem_create(ary->ptr[i]));
+    }
+    return r;
+}
+
+/**
+ * The elements as a binary String of floats, the same as +to_a+ flattened and packed with pack('f*').
+ * @return [String]
+ */
+template<typename T>
+static VALUE
+gdip_garray_bytes(VALUE self)
+{
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    return rb_str_new(reinterpret_cast<const char *>(ary->ptr), ary->len * sizeof(T));
+}
+
+template<typename T>
+static VALUE
+gdip_garray_inspect(VALUE self)
+{
+    return util_utf8_sprintf("#<%s size=%d>", __class__(self), garray_get<T>(self)->len);
+}
+
+/**
+ * Moves all elements in place.
+ * @overload Translate(dx, dy)
+ *   @param dx [Integer or Float]
+ *   @param dy [Integer or Float]
+ *   @return [self]
+ */
+template<typename T>
+static VALUE
+gdip_garray_translate(VALUE self, VALUE v_dx, VALUE v_dy)
+{
+    Check_Frozen(self);
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    float dx = NUM2SINGLE(v_dx);
+    float dy = NUM2SINGLE(v_dy);
+    for (int i = 0; i < ary->len; ++i) {
+        ary->ptr[i].X += dx;
+        ary->ptr[i].Y += dy;
+    }
+    return self;
+}
+
+static inline void
+garray_scale(PointF& point, float sx, float sy)
+{
+    point.X *= sx;
+    point.Y *= sy;
+}
+
+static inline void
+garray_scale(RectF& rect, float sx, float sy)
+{
+    rect.X *= sx;
+    rect.Y *= sy;
+    rect.Width *= sx;
+    rect.Height *= sy;
+}
+
+/**
+ * Scales all elements in place about the origin.
+ * @overload Scale(sx, sy)
+ *   @param sx [Integer or Float]
+ *   @param sy [Integer or Float]
+ *   @return [self]
+ */
+template<typename T>
+static VALUE
+gdip_garray_scale(VALUE self, VALUE v_sx, VALUE v_sy)
+{
+    Check_Frozen(self);
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    float sx = NUM2SINGLE(v_sx);
+    float sy = NUM2SINGLE(v_sy);
+    for (int i = 0; i < ary->len; ++i) {
+        garray_scale(ary->ptr[i], sx, sy);
+    }
+    return self;
+}
+
+static inline void
+garray_bounds(const PointF& point, float& left, float& top, float& right, float& bottom)
+{
+    if (point.X < left) left = point.X;
+    if (point.Y < top) top = point.Y;
+    if (point.X > right) right = point.X;
+    if (point.Y > bottom) bottom = point.Y;
+}
+
+static inline void
+garray_bounds(const RectF& rect, float& left, float& top, float& right, float& bottom)
+{
+    if (rect.GetLeft() < left) left = rect.GetLeft();
+    if (rect.GetTop() < top) top = rect.GetTop();
+    if (rect.GetRight() > right) right = rect.GetRight();
+    if (rect.GetBottom() > bottom) bottom = rect.GetBottom();
+}
+
+/**
+ * The smallest rectangle that contains all elements.
+ * @return [RectangleF or nil] nil if empty
+ */
+template<typename T>
+static VALUE
+gdip_garray_get_bounds(VALUE self)
+{
+    gdipGeomArray<T> *ary = garray_get<T>(self);
+    if (ary->len == 0) return Qnil;
+    float left = ary->ptr[0].X;
+    float top = ary->ptr[0].Y;
+    float right = left;
+    float bottom = top;
+    for (int i = 0; i < ary->len; ++i) {
+        garray_bounds(ary->ptr[i], left, top, right, bottom);
+    }
+    return gdip_rectf_create(left, top, right - left, bottom - top);
+}
+
+/* The storage of a PointFArray, borrowed. */
+PointF *
+gdip_pointfarray_ptr(VALUE v, int& count)
+{
+    gdipGeomArray<PointF> *ary = garray_get<PointF>(v);
+    count = ary->len;
+    return ary->ptr;
+}
+
+/* The storage of a RectFArray, borrowed. */
+RectF *
+gdip_rectfarray_ptr(VALUE v, int& count)
+{
+    gdipGeomArray<RectF> *ary = garray_get<RectF>(v);
+    count = ary->len;
+    return ary->ptr;
+}
+
+VALUE
+gdip_pointfarray_create(const PointF *points, int count)
+{
+    return garray_create(points, count);
+}
+
+template<typename T>
+static void
+define_garray_methods(VALUE klass)
+{
+    rb_include_module(klass, rb_mEnumerable);
+    rb_define_alloc_func(klass, gdip_garray_alloc<T>);
+    rb_define_method(klass, "initialize", RUBY_METHOD_FUNC(gdip_garray_init<T>), -1);
+    rb_define_method(klass, "<<", RUBY_METHOD_FUNC(gdip_garray_append<T>), 1);
+    rb_define_method(klass, "concat", RUBY_METHOD_FUNC(gdip_garray_concat<T>), 1);
+    rb_define_method(klass, "[]", RUBY_METHOD_FUNC(gdip_garray_aref<T>), -1);
+    rb_define_method(klass, "[]=", RUBY_METHOD_FUNC(gdip_garray_aset<T>), 2);
+    rb_define_method(klass, "each", RUBY_METHOD_FUNC(gdip_garray_each<T>), 0);
+    rb_define_method(klass, "size", RUBY_METHOD_FUNC(gdip_garray_size<T>), 0);
+    rb_define_alias(klass, "length", "size");
+    rb_define_method(klass, "clear", RUBY_METHOD_FUNC(gdip_garray_clear<T>), 0);
+    rb_define_method(klass, "to_a", RUBY_METHOD_FUNC(gdip_garray_to_a<T>), 0);
+    rb_define_method(klass, "bytes", RUBY_METHOD_FUNC(gdip_garray_bytes<T>), 0);
+    rb_define_method(klass, "inspect", RUBY_METHOD_FUNC(gdip_garray_inspect<T>), 0);
+
+    rb_define_method(klass, "Translate", RUBY_METHOD_FUNC(gdip_garray_translate<T>), 2);
+    rb_define_alias(klass, "translate", "Translate");
+    rb_define_method(klass, "Scale", RUBY_METHOD_FUNC(gdip_garray_scale<T>), 2);
+    rb_define_alias(klass, "scale", "Scale");
+    rb_define_method(klass, "GetBounds", RUBY_METHOD_FUNC(gdip_garray_get_bounds<T>), 0);
+    rb_define_alias(klass, "bounds", "GetBounds");
+}
+
+/*
+Document-class: Gdiplus::PointFArray
+A contiguous native array of PointF.
+It is passed to GDI+ without copying by every API that takes an Array of PointF,
+and no Ruby object is created per point until an element is read.
+@example
+  points = Gdiplus::PointFArray.new([0.0, 10.0, 30.0, 30.0, 100.0, 30.0])
+  points << Gdiplus::PointF.new(150.0, 80.0)
+  points.Translate(10, 10)
+  bmp.draw {|g| g.DrawLines(pen, points) }
+*/
+/*
+Document-class: Gdiplus::RectFArray
+A contiguous native array of RectangleF.
+It is passed to GDI+ without copying by DrawRectangles, FillRectangles and GraphicsPath#AddRectangles.
+@example
+  rects = Gdiplus::RectFArray.new
+  data.each_with_index {|v, i| rects << Gdiplus::RectangleF.new(i * 4.0, 300.0 - v, 3.0, v) }
+  bmp.draw {|g| g.FillRectangles(brush, rects) }
+*/
+void
+Init_geometry_array()
+{
+    cPointFArray = rb_define_class_under(mGdiplus, "PointFArray", rb_cObject);
+    define_garray_methods<PointF>(cPointFArray);
+
+    cRectFArray = rb_define_class_under(mGdiplus, "RectFArray", rb_cObject);
+    define_garray_methods<RectF>(cRectFArray);
+}
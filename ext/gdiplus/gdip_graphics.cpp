@@ -6,7 +6,7 @@
 #include "ruby_gdiplus.h"
 
 const rb_data_type_t tGraphics = _MAKE_DATA_TYPE(
-    "Graphics", 0, GDIP_OBJ_FREE(Graphics *), NULL, NULL, &cGraphics);
+    "Graphics", 0, GDIP_OBJ_FREE(Graphics *), GDIP_OBJ_MEMSIZE(Graphics *), NULL, &cGraphics);
 
 VALUE
 gdip_graphics_create(Graphics *g)
@@ -17,6 +17,23 @@ gdip_graphics_create(Graphics *g)
     return r;
 }
 
+/*
+ * Creates a Graphics drawing on +v_image+. The image cannot be disposed
+ * while the Graphics exists, and is kept alive by it.
+ */
+VALUE
+gdip_graphics_from_image(VALUE v_image)
+{
+    Image *image = Data_Ptr<Image *>(v_image);
+    VALUE r = gdip_graphics_create(Graphics::FromImage(image));
+    Graphics *g = Data_Ptr<Graphics *>(r);
+    if (g != NULL) {
+        gdip_use_attach(g, image);
+        rb_ivar_set(r, rb_intern("__gdip_image__"), v_image);
+    }
+    return r;
+}
+
 /**
  * Gets the rectangle of clipping region.
  * @return [RectangleF]
@@ -537,7 +554,7 @@ gdip_graphics_draw_rectangle(int argc, VALUE *argv, VALUE self)
 /**
  * @overload DrawRectangles(pen, rectangles)
  *   @param pen [Pen]
- *   @param rectangles [Array<Rectangle or RectangleF>]
+ *   @param rectangles [Array<Rectangle or RectangleF>, RectFArray]
  *   @return [self]
  */
 static VALUE
@@ -546,7 +563,7 @@ gdip_graphics_draw_rectangles(VALUE self, VALUE v_pen, VALUE ary)
     if (!_KIND_OF(v_pen, &tPen)) {
         rb_raise(rb_eTypeError, "The first argument should be Pen.");
     }
-    if (!_RB_ARRAY_P(ary) && RARRAY_LEN(ary) == 0) {
+    if (!_KIND_OF(ary, &tRectFArray) && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Rectangle or RectangleF.");
     }
 
@@ -555,6 +572,14 @@ gdip_graphics_draw_rectangles(VALUE self, VALUE v_pen, VALUE ary)
     Pen *pen = Data_Ptr<Pen *>(v_pen);
     Check_NULL(pen, "The pen object does not exist.");
 
+    if (_KIND_OF(ary, &tRectFArray)) {
+        int count;
+        RectF *rects = gdip_rectfarray_ptr(ary, count);
+        Status status = g->DrawRectangles(pen, rects, count);
+        Check_Status(status);
+        return self;
+    }
+
     VALUE first = rb_ary_entry(ary, 0);
     if (_KIND_OF(first, &tRectangle)) {
         int count;
@@ -580,7 +605,7 @@ gdip_graphics_draw_rectangles(VALUE self, VALUE v_pen, VALUE ary)
 /**
  * @overload FillRectangles(pen, rectangles)
  *   @param pen [Pen]
- *   @param rectangles [Array<Rectangle or RectangleF>]
+ *   @param rectangles [Array<Rectangle or RectangleF>, RectFArray]
  *   @return [self]
  */
 static VALUE
@@ -589,7 +614,7 @@ gdip_graphics_fill_rectangles(VALUE self, VALUE v_brush, VALUE ary)
     if (!_KIND_OF(v_brush, &tBrush)) {
         rb_raise(rb_eTypeError, "The first argument should be Brush.");
     }
-    if (!_RB_ARRAY_P(ary) && RARRAY_LEN(ary) == 0) {
+    if (!_KIND_OF(ary, &tRectFArray) && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Rectangle or RectangleF.");
     }
 
@@ -598,6 +623,14 @@ gdip_graphics_fill_rectangles(VALUE self, VALUE v_brush, VALUE ary)
     Brush *brush = Data_Ptr<Brush *>(v_brush);
     Check_NULL(brush, "This Brush object does not exist.");
 
+    if (_KIND_OF(ary, &tRectFArray)) {
+        int count;
+        RectF *rects = gdip_rectfarray_ptr(ary, count);
+        Status status = g->FillRectangles(brush, rects, count);
+        Check_Status(status);
+        return self;
+    }
+
     VALUE first = rb_ary_entry(ary, 0);
     if (_KIND_OF(first, &tRectangle)) {
         int count;
@@ -750,12 +783,14 @@ gdip_graphics_draw_line(int argc, VALUE *argv, VALUE self)
 /**
  * @overload DrawLines(pen, points)
  *   @param pen [Pen]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @return [self]
  * @example
  *   points = [Point.new(0, 10), Point.new(30, 30), Point.new(100, 30)]
  *   bmp.draw {|g|
  *     g.DrawLines(pen, points)
+ *     g.DrawLines(pen, [0, 10, 30, 30, 100, 30])
+ *     g.DrawLines(pen, [0.0, 10.0, 30.0, 30.0, 100.0, 30.0].pack('f*'))
  *   }
  */
 static VALUE
@@ -764,7 +799,8 @@ gdip_graphics_draw_lines(VALUE self, VALUE v_pen, VALUE ary)
     if (!_KIND_OF(v_pen, &tPen)) {
         rb_raise(rb_eTypeError, "The first argument should be Pen.");
     }
-    if (!_RB_ARRAY_P(ary) && RARRAY_LEN(ary) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(ary);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
 
@@ -773,19 +809,19 @@ gdip_graphics_draw_lines(VALUE self, VALUE v_pen, VALUE ary)
     Pen *pen = Data_Ptr<Pen *>(v_pen);
     Check_NULL(pen, "The pen object does not exist.");
 
-    VALUE first = rb_ary_entry(ary, 0);
-    if (_KIND_OF(first, &tPoint)) {
+    VALUE first = packed ? Qnil : rb_ary_entry(ary, 0);
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(ary, count);
+        Point *points = packed ? alloc_packed_points(ary, count) : alloc_array_of<Point, &tPoint>(ary, count);
         Status status = g->DrawLines(pen, points, count);
         ruby_xfree(points);
         Check_Status(status);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(ary, count);
+        PointF *points = packed ? get_packed_pointfs(ary, count) : alloc_array_of<PointF, &tPointF>(ary, count);
         Status status = g->DrawLines(pen, points, count);
-        ruby_xfree(points);
+        free_packed_points(ary, points);
         Check_Status(status);
     }
     else {
@@ -807,11 +843,11 @@ gdip_graphics_draw_lines(VALUE self, VALUE v_pen, VALUE ary)
  *   }
  * @overload DrawCurve(pen, points, tension=0.5)
  *   @param pen [Pen]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param tension [Float] 0.0-1.0
  * @overload DrawCurve(pen, points, offset, num, tension=0.5)
  *   @param pen [Pen]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param offset [Integer] start index of points
  *   @param num [Integer] number of segments
  *   @param tension [Float] 0.0-1.0
@@ -826,7 +862,8 @@ gdip_graphics_draw_curve(int argc, VALUE *argv, VALUE self)
     if (!_KIND_OF(argv[0], &tPen)) {
         rb_raise(rb_eTypeError, "The first argument should be Pen.");
     }
-    if (!_RB_ARRAY_P(argv[1]) || RARRAY_LEN(argv[1]) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(argv[1]);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(argv[1]) || RARRAY_LEN(argv[1]) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
     if (argc == 3 && !Float_p(argv[2])) {
@@ -849,7 +886,7 @@ gdip_graphics_draw_curve(int argc, VALUE *argv, VALUE self)
     Pen *pen = Data_Ptr<Pen *>(argv[0]);
     Check_NULL(pen, "The pen object does not exist.");
 
-    VALUE first = rb_ary_entry(argv[1], 0);
+    VALUE first = packed ? Qnil : rb_ary_entry(argv[1], 0);
     int offset = 0;
     int num = 0;
     if (argc > 3) {
@@ -863,9 +900,9 @@ gdip_graphics_draw_curve(int argc, VALUE *argv, VALUE self)
     if (argc == 5) {
         tension = clamp(NUM2SINGLE(argv[4]), 0.0f, 1.0f);
     }
-    if (_KIND_OF(first, &tPoint)) {
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(argv[1], count);
+        Point *points = packed ? alloc_packed_points(argv[1], count) : alloc_array_of<Point, &tPoint>(argv[1], count);
         Status status;
         if (argc > 3) {
             status = g->DrawCurve(pen, points, count, offset, num, tension);
@@ -876,9 +913,9 @@ gdip_graphics_draw_curve(int argc, VALUE *argv, VALUE self)
         ruby_xfree(points);
         Check_Status(status);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(argv[1], count);
+        PointF *points = packed ? get_packed_pointfs(argv[1], count) : alloc_array_of<PointF, &tPointF>(argv[1], count);
         Status status;
         if (argc > 3) {
             status = g->DrawCurve(pen, points, count, offset, num, tension);
@@ -886,7 +923,7 @@ gdip_graphics_draw_curve(int argc, VALUE *argv, VALUE self)
         else {
             status = g->DrawCurve(pen, points, count, tension);
         }
-        ruby_xfree(points);
+        free_packed_points(argv[1], points);
         Check_Status(status);
     }
     else {
@@ -989,7 +1026,7 @@ gdip_graphics_fill_ellipse(int argc, VALUE *argv, VALUE self)
     Graphics *g = Data_Ptr<Graphics *>(self);
     Check_NULL(g, "The graphics object does not exist.");
     Brush *brush = Data_Ptr<Brush *>(argv[0]);
-    Check_NULL(g, "The brush object does not exist.");
+    Check_NULL(brush, "The brush object does not exist.");
 
     if (argc == 2) {
         if (_KIND_OF(argv[1], &tRectangle)) {
@@ -1024,7 +1061,7 @@ gdip_graphics_fill_ellipse(int argc, VALUE *argv, VALUE self)
 /**
  * @overload DrawClosedCurve(pen, points, tension=0.5)
  *   @param pen [Pen]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param tension [Float] 0.0-1.0
  *   @return [self]
  * @example
@@ -1047,7 +1084,7 @@ gdip_graphics_draw_closed_curve(int argc, VALUE *argv, VALUE self)
     Graphics *g = Data_Ptr<Graphics *>(self);
     Check_NULL(g, "The graphics object does not exist.");
     Pen *pen = Data_Ptr<Pen *>(v_pen);
-    Check_NULL(g, "The pen object does not exist.");
+    Check_NULL(pen, "The pen object does not exist.");
     float tension = 0.5f;
 
     if (!RB_NIL_P(v_tension)) {
@@ -1059,20 +1096,21 @@ gdip_graphics_draw_closed_curve(int argc, VALUE *argv, VALUE self)
         }
     }
 
-    if (_RB_ARRAY_P(v_ary) && RARRAY_LEN(v_ary) > 0) {
-        VALUE first = rb_ary_entry(v_ary, 0);
-        if (_KIND_OF(first, &tPoint)) {
+    PackedPointsType packed = gdip_packed_points_type(v_ary);
+    if (packed != PackedPointNone || (_RB_ARRAY_P(v_ary) && RARRAY_LEN(v_ary) > 0)) {
+        VALUE first = packed ? Qnil : rb_ary_entry(v_ary, 0);
+        if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
             int count;
-            Point *points = alloc_array_of<Point, &tPoint>(v_ary, count);
+            Point *points = packed ? alloc_packed_points(v_ary, count) : alloc_array_of<Point, &tPoint>(v_ary, count);
             Status status = g->DrawClosedCurve(pen, points, count, tension);
             ruby_xfree(points);
             Check_Status(status);
         }
-        else if (_KIND_OF(first, &tPointF)) {
+        else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
             int count;
-            PointF *points = alloc_array_of<PointF, &tPointF>(v_ary, count);
+            PointF *points = packed ? get_packed_pointfs(v_ary, count) : alloc_array_of<PointF, &tPointF>(v_ary, count);
             Status status = g->DrawClosedCurve(pen, points, count, tension);
-            ruby_xfree(points);
+            free_packed_points(v_ary, points);
             Check_Status(status);
         }
         else {
@@ -1092,10 +1130,10 @@ gdip_graphics_draw_closed_curve(int argc, VALUE *argv, VALUE self)
  *   }
  * @overload FillClosedCurve(brush, points)
  *   @param brush [Brush]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  * @overload FillClosedCurve(pen, points, fillmode, tension=0.5)
  *   @param brush [Brush]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param fillmode [FillMode]
  *   @param tension [Float]
  * @return [self]
@@ -1109,7 +1147,8 @@ gdip_graphics_fill_closed_curve(int argc, VALUE *argv, VALUE self)
     if (_KIND_OF(argv[1], &tBrush)) {
         rb_raise(rb_eTypeError, "The second argument should be Brush.");
     }
-    if (_RB_ARRAY_P(argv[1]) && RARRAY_LEN(argv[1]) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(argv[1]);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(argv[1]) || RARRAY_LEN(argv[1]) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
     if (argc == 4 && !Float_p(argv[3])) {
@@ -1130,10 +1169,10 @@ gdip_graphics_fill_closed_curve(int argc, VALUE *argv, VALUE self)
         gdip_arg_to_enumint(cFillMode, argv[2], (int*)&fillmode, "The third argument should be FillMode.");
     }
     
-    VALUE first = rb_ary_entry(argv[1], 0);
-    if (_KIND_OF(first, &tPoint)) {
+    VALUE first = packed ? Qnil : rb_ary_entry(argv[1], 0);
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(argv[1], count);
+        Point *points = packed ? alloc_packed_points(argv[1], count) : alloc_array_of<Point, &tPoint>(argv[1], count);
         Status status;
         if (argc > 2) {
             status = g->FillClosedCurve(brush, points, count, fillmode, tension);
@@ -1144,9 +1183,9 @@ gdip_graphics_fill_closed_curve(int argc, VALUE *argv, VALUE self)
         ruby_xfree(points);
         Check_Status(status);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(argv[1], count);
+        PointF *points = packed ? get_packed_pointfs(argv[1], count) : alloc_array_of<PointF, &tPointF>(argv[1], count);
         Status status;
         if (argc > 2) {
             status = g->FillClosedCurve(brush, points, count, fillmode, tension);
@@ -1154,7 +1193,7 @@ gdip_graphics_fill_closed_curve(int argc, VALUE *argv, VALUE self)
         else {
             status = g->FillClosedCurve(brush, points, count);
         }
-        ruby_xfree(points);
+        free_packed_points(argv[1], points);
         Check_Status(status);
     }
     else {
@@ -1334,7 +1373,7 @@ gdip_graphics_draw_bezier(int argc, VALUE *argv, VALUE self)
 /**
  * @overload DrawBeziers(pen, points)
  *   @param pen [Pen]
- *   @param points [Array<Point or PointF>] The number of points should be 1 + 3n (n >= 1: 4, 7, 10, 13, ...).
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*'). The number of points should be 1 + 3n (n >= 1: 4, 7, 10, 13, ...).
  *   @return [self]
  * @example
  *   bmp.draw {|g|
@@ -1362,7 +1401,8 @@ gdip_graphics_draw_beziers(VALUE self, VALUE v_pen, VALUE ary)
     if (!_KIND_OF(v_pen, &tPen)) {
         rb_raise(rb_eTypeError, "The first argument should be Pen.");
     }
-    if (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(ary);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
 
@@ -1370,11 +1410,11 @@ gdip_graphics_draw_beziers(VALUE self, VALUE v_pen, VALUE ary)
     Check_NULL(g, "The graphics object does not exist.");
     Pen *pen = Data_Ptr<Pen *>(v_pen);
     Check_NULL(pen, "The pen object does not exist.");
-    VALUE first = rb_ary_entry(ary, 0);
+    VALUE first = packed ? Qnil : rb_ary_entry(ary, 0);
 
-    if (_KIND_OF(first, &tPoint)) {
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(ary, count);
+        Point *points = packed ? alloc_packed_points(ary, count) : alloc_array_of<Point, &tPoint>(ary, count);
         if ((count - 1) % 3 == 0) {
             Status status = g->DrawBeziers(pen, points, count);
             ruby_xfree(points);
@@ -1385,16 +1425,16 @@ gdip_graphics_draw_beziers(VALUE self, VALUE v_pen, VALUE ary)
             rb_raise(rb_eArgError, "wrong number of elements of the array (%d for 4, 7, 10, 13, ...)", count);
         }
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(ary, count);
+        PointF *points = packed ? get_packed_pointfs(ary, count) : alloc_array_of<PointF, &tPointF>(ary, count);
         if ((count - 1) % 3 == 0) {
             Status status = g->DrawBeziers(pen, points, count);
-            ruby_xfree(points);
+            free_packed_points(ary, points);
             Check_Status(status);
         }
         else {
-            ruby_xfree(points);
+            free_packed_points(ary, points);
             rb_raise(rb_eArgError, "wrong number of elements of the array (%d for 4, 7, 10, 13, ...)", count);
         }
     }
@@ -1572,7 +1612,7 @@ gdip_graphics_fill_pie(int argc, VALUE *argv, VALUE self)
 /**
  * @overload DrawPolygon(pen, points)
  *   @param pen [Pen]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @return [self]
  * @example
  *   bmp.draw {|g|
@@ -1589,7 +1629,8 @@ gdip_graphics_draw_polygon(VALUE self, VALUE v_pen, VALUE ary)
     if (!_KIND_OF(v_pen, &tPen)) {
         rb_raise(rb_eTypeError, "The first argument should be Pen.");
     }
-    if (!_RB_ARRAY_P(ary) && RARRAY_LEN(ary) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(ary);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
 
@@ -1598,19 +1639,19 @@ gdip_graphics_draw_polygon(VALUE self, VALUE v_pen, VALUE ary)
     Pen *pen = Data_Ptr<Pen *>(v_pen);
     Check_NULL(pen, "The pen object does not exist.");
 
-    VALUE first = rb_ary_entry(ary, 0);
-    if (_KIND_OF(first, &tPoint)) {
+    VALUE first = packed ? Qnil : rb_ary_entry(ary, 0);
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(ary, count);
+        Point *points = packed ? alloc_packed_points(ary, count) : alloc_array_of<Point, &tPoint>(ary, count);
         Status status = g->DrawPolygon(pen, points, count);
         ruby_xfree(points);
         Check_Status(status);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(ary, count);
+        PointF *points = packed ? get_packed_pointfs(ary, count) : alloc_array_of<PointF, &tPointF>(ary, count);
         Status status = g->DrawPolygon(pen, points, count);
-        ruby_xfree(points);
+        free_packed_points(ary, points);
         Check_Status(status);
     }
     else {
@@ -1623,7 +1664,7 @@ gdip_graphics_draw_polygon(VALUE self, VALUE v_pen, VALUE ary)
 /**
  * @overload FillPolygon(brush, points, fillmode = FillMode.Alternate)
  *   @param brush [Brush]
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param fillmode [FillMode]
  *   @return [self]
  * @example
@@ -1645,7 +1686,8 @@ gdip_graphics_fill_polygon(int argc, VALUE *argv, VALUE self)
     if (!_KIND_OF(v_brush, &tBrush)) {
         rb_raise(rb_eTypeError, "The first argument should be Brush.");
     }
-    if (!_RB_ARRAY_P(v_points) || RARRAY_LEN(v_points) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(v_points);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(v_points) || RARRAY_LEN(v_points) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
     FillMode fillmode = FillModeAlternate;
@@ -1657,12 +1699,12 @@ gdip_graphics_fill_polygon(int argc, VALUE *argv, VALUE self)
     Check_NULL(g, "The graphics object does not exist.");
     Brush *brush = Data_Ptr<Brush *>(v_brush);
     Check_NULL(brush, "The brush object does not exist.");
-    VALUE first = rb_ary_entry(v_points, 0);
+    VALUE first = packed ? Qnil : rb_ary_entry(v_points, 0);
 
     Status status = Ok;
-    if (_KIND_OF(first, &tPoint)) {
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(v_points, count);
+        Point *points = packed ? alloc_packed_points(v_points, count) : alloc_array_of<Point, &tPoint>(v_points, count);
         if (!RB_NIL_P(v_fillmode)) {
             status = g->FillPolygon(brush, points, count, fillmode);
         }
@@ -1671,16 +1713,16 @@ gdip_graphics_fill_polygon(int argc, VALUE *argv, VALUE self)
         }
         ruby_xfree(points);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(v_points, count);
+        PointF *points = packed ? get_packed_pointfs(v_points, count) : alloc_array_of<PointF, &tPointF>(v_points, count);
         if (!RB_NIL_P(v_fillmode)) {
             status = g->FillPolygon(brush, points, count, fillmode);
         }
         else {
             status = g->FillPolygon(brush, points, count);
         }
-        ruby_xfree(points);
+        free_packed_points(v_points, points);
     }
     else {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
@@ -1697,10 +1739,10 @@ gdip_graphics_draw_string_at_point(Graphics *g, VALUE wstr, Font *font, Brush *b
     if (_KIND_OF(v_format, &tStringFormat)) {
         StringFormat *format = Data_Ptr<StringFormat *>(v_format);
         Check_NULL(format, "The StringFormat object does not exist.");
-        status = g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, point, format, brush);
+        status = gdip_call([&]() { return g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, point, format, brush); });
     }
     else if (RB_NIL_P(v_format)) {
-        status = g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, point, brush);
+        status = gdip_call([&]() { return g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, point, brush); });
     }
     else {
         rb_raise(rb_eTypeError, "The last argument should be StringFormat.");
@@ -1715,10 +1757,10 @@ gdip_graphics_draw_string_at_rect(Graphics *g, VALUE wstr, Font *font, Brush *br
     if (_KIND_OF(v_format, &tStringFormat)) {
         StringFormat *format = Data_Ptr<StringFormat *>(v_format);
         Check_NULL(format, "The StringFormat object does not exist.");
-        status = g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, rect, format, brush);
+        status = gdip_call([&]() { return g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, rect, format, brush); });
     }
     else if (RB_NIL_P(v_format)) {
-        status = g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, rect, NULL, brush);
+        status = gdip_call([&]() { return g->DrawString(RString_Ptr<WCHAR *>(wstr), -1, font, rect, NULL, brush); });
     }
     else {
         rb_raise(rb_eTypeError, "The last argument should be StringFormat.");
@@ -1770,7 +1812,7 @@ gdip_graphics_draw_string(int argc, VALUE *argv, VALUE self)
     Font *font = Data_Ptr<Font *>(argv[1]);
     Brush *brush = Data_Ptr<Brush *>(argv[2]);
     Check_NULL(font, "The Font object does not exist.");
-    Check_NULL(font, "The Brush object does not exist.");
+    Check_NULL(brush, "The Brush object does not exist.");
 
     Status status = Ok;
     if (argc >= 5 && Integer_p(argv[3]) && Integer_p(argv[4])) {
@@ -1863,7 +1905,7 @@ gdip_graphics_fill_path(VALUE self, VALUE v_brush, VALUE v_path)
     GraphicsPath *path = Data_Ptr<GraphicsPath *>(v_path);
     Check_NULL(path, "This GraphicsPath object does not exist.");
     
-    Status status = g->FillPath(brush, path);
+    Status status = gdip_call_without_gvl([&]() { return g->FillPath(brush, path); }, g, path, brush);
     Check_Status(status);
 
     return self;
@@ -1928,11 +1970,11 @@ gdip_graphics_draw_image_point(int argc, VALUE *argv, VALUE self)
     if (argc == 2) {
         if (_KIND_OF(argv[1], &tPoint)) {
             Point *point = Data_Ptr<Point *>(argv[1]);
-            status = g->DrawImage(image, *point);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *point); }, g, image);
         }
         else if (_KIND_OF(argv[1], &tPointF)) {
             PointF *point = Data_Ptr<PointF *>(argv[1]);
-            status = g->DrawImage(image, *point);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *point); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "The second argument should be Point or PointF.");
@@ -1940,10 +1982,12 @@ gdip_graphics_draw_image_point(int argc, VALUE *argv, VALUE self)
     }
     else if (argc == 3) {
         if (Integer_p(argv[1], argv[2])) {
-            status = g->DrawImage(image, RB_NUM2INT(argv[1]), RB_NUM2INT(argv[2]));
+            int a1 = RB_NUM2INT(argv[1]), a2 = RB_NUM2INT(argv[2]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2); }, g, image);
         }
         else if (Float_p(argv[1], argv[2])) {
-            status = g->DrawImage(image, NUM2SINGLE(argv[1]), NUM2SINGLE(argv[2]));
+            float a1 = NUM2SINGLE(argv[1]), a2 = NUM2SINGLE(argv[2]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "Invalid types of arguments representing coordinates.");
@@ -1986,11 +2030,11 @@ gdip_graphics_draw_image_rect(int argc, VALUE *argv, VALUE self)
     if (argc == 2) {
         if (_KIND_OF(argv[1], &tRectangle)) {
             Rect *rect = Data_Ptr<Rect *>(argv[1]);
-            status = g->DrawImage(image, *rect);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *rect); }, g, image);
         }
         else if (_KIND_OF(argv[1], &tRectangleF)) {
             RectF *rect = Data_Ptr<RectF *>(argv[1]);
-            status = g->DrawImage(image, *rect);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *rect); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "The second argument should be Rectangle or RectangleF.");
@@ -1998,10 +2042,12 @@ gdip_graphics_draw_image_rect(int argc, VALUE *argv, VALUE self)
     }
     else if (argc == 5) {
         if (Integer_p(4, &argv[1])) {
-            status = g->DrawImage(image, RB_NUM2INT(argv[1]), RB_NUM2INT(argv[2]), RB_NUM2INT(argv[3]), RB_NUM2INT(argv[4]));
+            int a1 = RB_NUM2INT(argv[1]), a2 = RB_NUM2INT(argv[2]), a3 = RB_NUM2INT(argv[3]), a4 = RB_NUM2INT(argv[4]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, a3, a4); }, g, image);
         }
         else if (Float_p(4, &argv[1])) {
-            status = g->DrawImage(image, NUM2SINGLE(argv[1]), NUM2SINGLE(argv[2]), NUM2SINGLE(argv[3]), NUM2SINGLE(argv[4]));
+            float a1 = NUM2SINGLE(argv[1]), a2 = NUM2SINGLE(argv[2]), a3 = NUM2SINGLE(argv[3]), a4 = NUM2SINGLE(argv[4]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, a3, a4); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "Invalid types of arguments representing coordinates.");
@@ -2044,7 +2090,7 @@ gdip_graphics_draw_image_points(VALUE self, VALUE v_image, VALUE v_points)
             ruby_xfree(points);
             rb_raise(rb_eArgError, "The number of points should be 3.");
         }
-        status = g->DrawImage(image, points, count);
+        status = gdip_call_without_gvl([&]() { return g->DrawImage(image, points, count); }, g, image);
         ruby_xfree(points);
     }
     else if (_KIND_OF(first, &tPointF)) {
@@ -2054,7 +2100,7 @@ gdip_graphics_draw_image_points(VALUE self, VALUE v_image, VALUE v_points)
             ruby_xfree(points);
             rb_raise(rb_eArgError, "The number of points should be 3.");
         }
-        status = g->DrawImage(image, points, count);
+        status = gdip_call_without_gvl([&]() { return g->DrawImage(image, points, count); }, g, image);
         ruby_xfree(points);
     }
     else {
@@ -2118,12 +2164,12 @@ gdip_graphics_draw_image_point_rect(int argc, VALUE *argv, VALUE self)
         if (_KIND_OF(argv[1], &tPoint) && _KIND_OF(argv[2], &tRectangle)) {
             Point *point = Data_Ptr<Point *>(argv[1]);
             Rect *rect = Data_Ptr<Rect *>(argv[2]);
-            status = g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
         }
         else if (_KIND_OF(argv[1], &tPointF) && _KIND_OF(argv[2], &tRectangleF)) {
             PointF *point = Data_Ptr<PointF *>(argv[1]);
             RectF *rect = Data_Ptr<RectF *>(argv[2]);
-            status = g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2132,23 +2178,25 @@ gdip_graphics_draw_image_point_rect(int argc, VALUE *argv, VALUE self)
     else if (argc == 4) {
         if (Integer_p(argv[1], argv[2]) && _KIND_OF(argv[3], &tRectangle)) {
             Rect *rect = Data_Ptr<Rect *>(argv[3]);
-            status = g->DrawImage(image, RB_NUM2INT(argv[1]), RB_NUM2INT(argv[2]), rect->X, rect->Y, rect->Width, rect->Height, unit);
+            int a1 = RB_NUM2INT(argv[1]), a2 = RB_NUM2INT(argv[2]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
         }
         else if (Float_p(argv[1], argv[2]) && _KIND_OF(argv[3], &tRectangleF)) {
             RectF *rect = Data_Ptr<RectF *>(argv[3]);
-            status = g->DrawImage(image, NUM2SINGLE(argv[1]), NUM2SINGLE(argv[2]), rect->X, rect->Y, rect->Width, rect->Height, unit);
+            float a1 = NUM2SINGLE(argv[1]), a2 = NUM2SINGLE(argv[2]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
         }
         else {
             gdip_arg_to_enumint(cGraphicsUnit, argv[3], &unit, "The last argument should be GraphicsUnit.");
             if (_KIND_OF(argv[1], &tPoint) && _KIND_OF(argv[2], &tRectangle)) {
                 Point *point = Data_Ptr<Point *>(argv[1]);
                 Rect *rect = Data_Ptr<Rect *>(argv[2]);
-                status = g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
             }
             else if (_KIND_OF(argv[1], &tPointF) && _KIND_OF(argv[2], &tRectangleF)) {
                 PointF *point = Data_Ptr<PointF *>(argv[1]);
                 RectF *rect = Data_Ptr<RectF *>(argv[2]);
-                status = g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
             }
             else {
                 rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2160,11 +2208,13 @@ gdip_graphics_draw_image_point_rect(int argc, VALUE *argv, VALUE self)
         gdip_arg_to_enumint(cGraphicsUnit, argv[4], &unit, "The last argument should be GraphicsUnit.");
         if (Integer_p(argv[1], argv[2]) && _KIND_OF(argv[3], &tRectangle)) {
             Rect *rect = Data_Ptr<Rect *>(argv[3]);
-            status = g->DrawImage(image, RB_NUM2INT(argv[1]), RB_NUM2INT(argv[2]), rect->X, rect->Y, rect->Width, rect->Height, unit);
+            int a1 = RB_NUM2INT(argv[1]), a2 = RB_NUM2INT(argv[2]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
         }
         else if (Float_p(argv[1], argv[2]) && _KIND_OF(argv[3], &tRectangleF)) {
             RectF *rect = Data_Ptr<RectF *>(argv[3]);
-            status = g->DrawImage(image, NUM2SINGLE(argv[1]), NUM2SINGLE(argv[2]), rect->X, rect->Y, rect->Width, rect->Height, unit);
+            float a1 = NUM2SINGLE(argv[1]), a2 = NUM2SINGLE(argv[2]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, rect->X, rect->Y, rect->Width, rect->Height, unit); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2173,11 +2223,13 @@ gdip_graphics_draw_image_point_rect(int argc, VALUE *argv, VALUE self)
     else if (argc == 6) {
         if (_KIND_OF(argv[1], &tPoint) && Integer_p(4, &argv[2])) {
             Point *point = Data_Ptr<Point *>(argv[1]);
-            status = g->DrawImage(image, point->X, point->Y, RB_NUM2INT(argv[2]), RB_NUM2INT(argv[3]), RB_NUM2INT(argv[4]), RB_NUM2INT(argv[5]), unit);
+            int a2 = RB_NUM2INT(argv[2]), a3 = RB_NUM2INT(argv[3]), a4 = RB_NUM2INT(argv[4]), a5 = RB_NUM2INT(argv[5]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, a2, a3, a4, a5, unit); }, g, image);
         }
         else if (_KIND_OF(argv[1], &tPointF) && Float_p(4, &argv[2])) {
             PointF *point = Data_Ptr<PointF *>(argv[1]);
-            status = g->DrawImage(image, point->X, point->Y, NUM2SINGLE(argv[2]), NUM2SINGLE(argv[3]), NUM2SINGLE(argv[4]), NUM2SINGLE(argv[5]), unit);
+            float a2 = NUM2SINGLE(argv[2]), a3 = NUM2SINGLE(argv[3]), a4 = NUM2SINGLE(argv[4]), a5 = NUM2SINGLE(argv[5]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, a2, a3, a4, a5, unit); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2185,20 +2237,24 @@ gdip_graphics_draw_image_point_rect(int argc, VALUE *argv, VALUE self)
     }
     else if (argc == 7) {
         if (Integer_p(6, &argv[1])) {
-            status = g->DrawImage(image, RB_NUM2INT(argv[1]), RB_NUM2INT(argv[2]), RB_NUM2INT(argv[3]), RB_NUM2INT(argv[4]), RB_NUM2INT(argv[5]), RB_NUM2INT(argv[6]), unit);
+            int a1 = RB_NUM2INT(argv[1]), a2 = RB_NUM2INT(argv[2]), a3 = RB_NUM2INT(argv[3]), a4 = RB_NUM2INT(argv[4]), a5 = RB_NUM2INT(argv[5]), a6 = RB_NUM2INT(argv[6]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, a3, a4, a5, a6, unit); }, g, image);
         }
         else if (Float_p(6, &argv[1])) {
-            status = g->DrawImage(image, NUM2SINGLE(argv[1]), NUM2SINGLE(argv[2]), NUM2SINGLE(argv[3]), NUM2SINGLE(argv[4]), NUM2SINGLE(argv[5]), NUM2SINGLE(argv[6]), unit);
+            float a1 = NUM2SINGLE(argv[1]), a2 = NUM2SINGLE(argv[2]), a3 = NUM2SINGLE(argv[3]), a4 = NUM2SINGLE(argv[4]), a5 = NUM2SINGLE(argv[5]), a6 = NUM2SINGLE(argv[6]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, a3, a4, a5, a6, unit); }, g, image);
         }
         else {
             gdip_arg_to_enumint(cGraphicsUnit, argv[6], &unit, "The last argument should be GraphicsUnit.");
             if (_KIND_OF(argv[1], &tPoint) && Integer_p(4, &argv[2])) {
                 Point *point = Data_Ptr<Point *>(argv[1]);
-                status = g->DrawImage(image, point->X, point->Y, RB_NUM2INT(argv[2]), RB_NUM2INT(argv[3]), RB_NUM2INT(argv[4]), RB_NUM2INT(argv[5]), unit);
+                int a2 = RB_NUM2INT(argv[2]), a3 = RB_NUM2INT(argv[3]), a4 = RB_NUM2INT(argv[4]), a5 = RB_NUM2INT(argv[5]);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, a2, a3, a4, a5, unit); }, g, image);
             }
             else if (_KIND_OF(argv[1], &tPointF) && Float_p(4, &argv[2])) {
                 PointF *point = Data_Ptr<PointF *>(argv[1]);
-                status = g->DrawImage(image, point->X, point->Y, NUM2SINGLE(argv[2]), NUM2SINGLE(argv[3]), NUM2SINGLE(argv[4]), NUM2SINGLE(argv[5]), unit);
+                float a2 = NUM2SINGLE(argv[2]), a3 = NUM2SINGLE(argv[3]), a4 = NUM2SINGLE(argv[4]), a5 = NUM2SINGLE(argv[5]);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, point->X, point->Y, a2, a3, a4, a5, unit); }, g, image);
             }
             else {
                 rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2208,10 +2264,12 @@ gdip_graphics_draw_image_point_rect(int argc, VALUE *argv, VALUE self)
     else if (argc == 8) {
         gdip_arg_to_enumint(cGraphicsUnit, argv[7], &unit, "The last argument should be GraphicsUnit.");
         if (Integer_p(6, &argv[1])) {
-            status = g->DrawImage(image, RB_NUM2INT(argv[1]), RB_NUM2INT(argv[2]), RB_NUM2INT(argv[3]), RB_NUM2INT(argv[4]), RB_NUM2INT(argv[5]), RB_NUM2INT(argv[6]), unit);
+            int a1 = RB_NUM2INT(argv[1]), a2 = RB_NUM2INT(argv[2]), a3 = RB_NUM2INT(argv[3]), a4 = RB_NUM2INT(argv[4]), a5 = RB_NUM2INT(argv[5]), a6 = RB_NUM2INT(argv[6]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, a3, a4, a5, a6, unit); }, g, image);
         }
         else if (Float_p(6, &argv[1])) {
-            status = g->DrawImage(image, NUM2SINGLE(argv[1]), NUM2SINGLE(argv[2]), NUM2SINGLE(argv[3]), NUM2SINGLE(argv[4]), NUM2SINGLE(argv[5]), NUM2SINGLE(argv[6]), unit);
+            float a1 = NUM2SINGLE(argv[1]), a2 = NUM2SINGLE(argv[2]), a3 = NUM2SINGLE(argv[3]), a4 = NUM2SINGLE(argv[4]), a5 = NUM2SINGLE(argv[5]), a6 = NUM2SINGLE(argv[6]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, a1, a2, a3, a4, a5, a6, unit); }, g, image);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2298,7 +2356,7 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, *dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes); }, g, image, attributes);
         }
         else if (argc >= 6 && Integer_p(4, &argv[2])) {
             if (argc >= 7) {
@@ -2314,7 +2372,8 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, *dest_rect, RB_NUM2INT(argv[2]), RB_NUM2INT(argv[3]), RB_NUM2INT(argv[4]), RB_NUM2INT(argv[5]), unit, attributes);
+            int a2 = RB_NUM2INT(argv[2]), a3 = RB_NUM2INT(argv[3]), a4 = RB_NUM2INT(argv[4]), a5 = RB_NUM2INT(argv[5]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *dest_rect, a2, a3, a4, a5, unit, attributes); }, g, image, attributes);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2338,7 +2397,7 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, *dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes); }, g, image, attributes);
         }
         else if (argc >= 6 && Float_p(4, &argv[2])) {
             if (argc >= 7) {
@@ -2354,7 +2413,8 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, *dest_rect, NUM2SINGLE(argv[2]), NUM2SINGLE(argv[3]), NUM2SINGLE(argv[4]), NUM2SINGLE(argv[5]), unit, attributes);
+            float a2 = NUM2SINGLE(argv[2]), a3 = NUM2SINGLE(argv[3]), a4 = NUM2SINGLE(argv[4]), a5 = NUM2SINGLE(argv[5]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, *dest_rect, a2, a3, a4, a5, unit, attributes); }, g, image, attributes);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2383,7 +2443,7 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes); }, g, image, attributes);
         }
         else if (argc >= 9 && Integer_p(4, &argv[5])) {
             if (argc >= 10) {
@@ -2398,7 +2458,8 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, dest_rect, RB_NUM2INT(argv[5]), RB_NUM2INT(argv[6]), RB_NUM2INT(argv[7]), RB_NUM2INT(argv[8]), unit, attributes);
+            int a5 = RB_NUM2INT(argv[5]), a6 = RB_NUM2INT(argv[6]), a7 = RB_NUM2INT(argv[7]), a8 = RB_NUM2INT(argv[8]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, dest_rect, a5, a6, a7, a8, unit, attributes); }, g, image, attributes);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2427,7 +2488,7 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, dest_rect, src_rect->X, src_rect->Y, src_rect->Width, src_rect->Height, unit, attributes); }, g, image, attributes);
         }
         else if (argc >= 9 && Float_p(4, &argv[5])) {
             if (argc >= 10) {
@@ -2442,7 +2503,8 @@ gdip_graphics_draw_image_rect_rect(int argc, VALUE *argv, VALUE self)
                 }
             }
 
-            status = g->DrawImage(image, dest_rect, NUM2SINGLE(argv[5]), NUM2SINGLE(argv[6]), NUM2SINGLE(argv[7]), NUM2SINGLE(argv[8]), unit, attributes);
+            float a5 = NUM2SINGLE(argv[5]), a6 = NUM2SINGLE(argv[6]), a7 = NUM2SINGLE(argv[7]), a8 = NUM2SINGLE(argv[8]);
+            status = gdip_call_without_gvl([&]() { return g->DrawImage(image, dest_rect, a5, a6, a7, a8, unit, attributes); }, g, image, attributes);
         }
         else {
             rb_raise(rb_eTypeError, "wrong types of arguments");
@@ -2522,7 +2584,7 @@ gdip_graphics_draw_image_points_rect(int argc, VALUE *argv, VALUE self)
                     rb_raise(rb_eArgError, "The number of points should be 3.");
                 }
 
-                status = g->DrawImage(image, points, count, rect->X, rect->Y, rect->Width, rect->Height, unit, attributes);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, points, count, rect->X, rect->Y, rect->Width, rect->Height, unit, attributes); }, g, image, attributes);
                 ruby_xfree(points);
             }
             else {
@@ -2551,7 +2613,8 @@ gdip_graphics_draw_image_points_rect(int argc, VALUE *argv, VALUE self)
                     rb_raise(rb_eArgError, "The number of points should be 3.");
                 }
 
-                status = g->DrawImage(image, points, count, RB_NUM2INT(argv[2]), RB_NUM2INT(argv[3]), RB_NUM2INT(argv[4]), RB_NUM2INT(argv[5]), unit, attributes);
+                int a2 = RB_NUM2INT(argv[2]), a3 = RB_NUM2INT(argv[3]), a4 = RB_NUM2INT(argv[4]), a5 = RB_NUM2INT(argv[5]);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, points, count, a2, a3, a4, a5, unit, attributes); }, g, image, attributes);
                 ruby_xfree(points);
             }
             else {
@@ -2584,7 +2647,7 @@ gdip_graphics_draw_image_points_rect(int argc, VALUE *argv, VALUE self)
                     rb_raise(rb_eArgError, "The number of points should be 3.");
                 }
 
-                status = g->DrawImage(image, points, count, rect->X, rect->Y, rect->Width, rect->Height, unit, attributes);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, points, count, rect->X, rect->Y, rect->Width, rect->Height, unit, attributes); }, g, image, attributes);
                 ruby_xfree(points);
             }
             else {
@@ -2613,7 +2676,8 @@ gdip_graphics_draw_image_points_rect(int argc, VALUE *argv, VALUE self)
                     rb_raise(rb_eArgError, "The number of points should be 3.");
                 }
 
-                status = g->DrawImage(image, points, count, NUM2SINGLE(argv[2]), NUM2SINGLE(argv[3]), NUM2SINGLE(argv[4]), NUM2SINGLE(argv[5]), unit, attributes);
+                float a2 = NUM2SINGLE(argv[2]), a3 = NUM2SINGLE(argv[3]), a4 = NUM2SINGLE(argv[4]), a5 = NUM2SINGLE(argv[5]);
+                status = gdip_call_without_gvl([&]() { return g->DrawImage(image, points, count, a2, a3, a4, a5, unit, attributes); }, g, image, attributes);
                 ruby_xfree(points);
             }
             else {
@@ -2820,10 +2884,12 @@ gdip_graphics_m_set_clip(int argc, VALUE *argv, VALUE self)
     Status status = Ok;
     if (_KIND_OF(area, &tGraphics)) {
         Graphics *graphics = Data_Ptr<Graphics *>(area);
+        Check_NULL(graphics, "The graphics object does not exist.");
         status = g->SetClip(graphics, mode);
     }
     else if (_KIND_OF(area, &tGraphicsPath)) {
         GraphicsPath *path = Data_Ptr<GraphicsPath *>(area);
+        Check_NULL(path, "The GraphicsPath object does not exist.");
         status = g->SetClip(path, mode);
     }
     else if (_KIND_OF(area, &tRectangle)) {
@@ -2836,6 +2902,7 @@ gdip_graphics_m_set_clip(int argc, VALUE *argv, VALUE self)
     }
     else if (_KIND_OF(area, &tRegion)) {
         Region *region = Data_Ptr<Region *>(area);
+        Check_NULL(region, "The region object does not exist.");
         status = g->SetClip(region, mode);
     }
     else {
@@ -2871,6 +2938,7 @@ gdip_graphics_exclude_clip(VALUE self, VALUE area)
     }
     else if (_KIND_OF(area, &tRegion)) {
         Region *region = Data_Ptr<Region *>(area);
+        Check_NULL(region, "The region object does not exist.");
         status = g->ExcludeClip(region);
     }
     else {
@@ -2906,6 +2974,7 @@ gdip_graphics_intersect_clip(VALUE self, VALUE area)
     }
     else if (_KIND_OF(area, &tRegion)) {
         Region *region = Data_Ptr<Region *>(area);
+        Check_NULL(region, "The region object does not exist.");
         status = g->IntersectClip(region);
     }
     else {
@@ -3071,6 +3140,7 @@ gdip_graphics_multiply_transform(int argc, VALUE *argv, VALUE self)
     Graphics *g = Data_Ptr<Graphics *>(self);
     Check_NULL(g, "This Graphics object does not exist.");
     Matrix *matrix = Data_Ptr<Matrix *>(v_matrix);
+    Check_NULL(matrix, "The matrix object does not exist.");
     MatrixOrder order = MatrixOrderPrepend;
 
     if (!RB_NIL_P(v_order)) {
@@ -3303,7 +3373,7 @@ gdip_graphics_measure_string(int argc, VALUE *argv, VALUE self)
 
     if (argc == 2) {
         SizeF layout;
-        status = g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, layout, NULL, &size);
+        status = gdip_call([&]() { return g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, layout, NULL, &size); });
     }
     else if (argc == 3 || argc == 4) {
         StringFormat *format = NULL;
@@ -3320,16 +3390,16 @@ gdip_graphics_measure_string(int argc, VALUE *argv, VALUE self)
             float width = 0.0f;
             gdip_arg_to_single(argv[2], &width);
             SizeF layout(width, 1000000.0f);
-            status = g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, layout, format, &size);
+            status = gdip_call([&]() { return g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, layout, format, &size); });
         }
         else if (_KIND_OF(argv[2], &tSizeF)) {
             SizeF *p_layout = Data_Ptr<SizeF *>(argv[2]);
-            status = g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, *p_layout, format, &size);
+            status = gdip_call([&]() { return g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, *p_layout, format, &size); });
         }
         else if (_KIND_OF(argv[2], &tPointF)) {
             PointF *origin = Data_Ptr<PointF *>(argv[2]);
             RectF box;
-            status = g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, *origin, format, &box);
+            status = gdip_call([&]() { return g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, *origin, format, &box); });
             size.Width = box.Width;
             size.Height = box.Height;
         }
@@ -3358,7 +3428,7 @@ gdip_graphics_measure_string(int argc, VALUE *argv, VALUE self)
         SizeF *p_layout = Data_Ptr<SizeF *>(argv[2]);
         int charactersFitted = 0;
         int linesFilled = 0;
-        status = g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, *p_layout, format, &size, &charactersFitted, &linesFilled);
+        status = gdip_call([&]() { return g->MeasureString(RString_Ptr<WCHAR *>(wstr), length, font, *p_layout, format, &size, &charactersFitted, &linesFilled); });
 
         if (_RB_HASH_P(argv[4])) {
             rb_hash_aset(argv[4], rb_str_new_cstr("charactersFitted"), RB_INT2NUM(charactersFitted));
@@ -3456,11 +3526,60 @@ gdip_graphics_measure_character_ranges(VALUE self, VALUE str, VALUE v_font, VALU
     return r;
 }
 
+/**
+ * Runs all commands of a {Graphics::CommandBuffer} in one call.
+ * @param buffer [Graphics::CommandBuffer]
+ * @return [self]
+ */
+static VALUE
+gdip_graphics_execute(VALUE self, VALUE v_buffer)
+{
+    Graphics *g = Data_Ptr<Graphics *>(self);
+    Check_NULL(g, "This Graphics object does not exist.");
+    Status status = gdip_cmdbuf_execute(g, v_buffer);
+    Check_Status(status);
+    return self;
+}
+
+/**
+ * Creates a Graphics to draw on the image.
+ * With a block, the Graphics is disposed when the block exits.
+ * @overload FromImage(image)
+ *   @param image [Image]
+ *   @return [Graphics]
+ * @overload FromImage(image) {|g| ... }
+ *   @param image [Image]
+ *   @return [Object] the value of the block.
+ */
+static VALUE
+gdip_graphics_s_from_image(VALUE klass, VALUE v_image)
+{
+    if (!_KIND_OF(v_image, &tImage)) {
+        rb_raise(rb_eTypeError, "The argument should be Image.");
+    }
+    Image *image = Data_Ptr<Image *>(v_image);
+    Check_NULL(image, "The image object does not exist.");
+    VALUE r = gdip_graphics_from_image(v_image);
+    if (!rb_block_given_p()) {
+        return r;
+    }
+    return _rb_ensure(
+        [&]() -> VALUE {
+            return rb_yield(r);
+        },
+        [&]() -> VALUE {
+            gdip_obj_dispose(r);
+            return Qnil;
+        });
+}
+
 void
 Init_graphics()
 {
     cGraphics = rb_define_class_under(mGdiplus, "Graphics", cGpObject);
     rb_undef_alloc_func(cGraphics);
+    rb_define_singleton_method(cGraphics, "FromImage", RUBY_METHOD_FUNC(gdip_graphics_s_from_image), 1);
+    rb_define_alias(rb_singleton_class(cGraphics), "from_image", "FromImage");
 
     ATTR_RW(cGraphics, Clip, clip, graphics);
     ATTR_R(cGraphics, ClipBounds, clip_bounds, graphics);
@@ -3543,6 +3662,7 @@ Init_graphics()
     rb_define_alias(cGraphics, "draw_image_points_rect", "DrawImagePointsRect");
     rb_define_method(cGraphics, "DrawImage", RUBY_METHOD_FUNC(gdip_graphics_draw_image), -1);
     rb_define_alias(cGraphics, "draw_image", "DrawImage");
+    rb_define_method(cGraphics, "execute", RUBY_METHOD_FUNC(gdip_graphics_execute), 1);
 
     rb_define_method(cGraphics, "SetClip", RUBY_METHOD_FUNC(gdip_graphics_m_set_clip), -1);
     rb_define_alias(cGraphics, "set_clip", "SetClip");
@@ -6,7 +6,7 @@
 #include "ruby_gdiplus.h"
 
 const rb_data_type_t tGraphicsPath = _MAKE_DATA_TYPE(
-    "GraphicsPath", 0, GDIP_OBJ_FREE(GraphicsPath *), NULL, NULL, &cGraphicsPath);
+    "GraphicsPath", 0, GDIP_OBJ_FREE(GraphicsPath *), GDIP_OBJ_MEMSIZE(GraphicsPath *), NULL, &cGraphicsPath);
 
 
 struct gdipPathData {
@@ -20,14 +20,24 @@ static void
 gdip_pathdata_mark(gdipPathData *pathdata)
 {
     if (pathdata != NULL) {
-        rb_gc_mark(pathdata->v_points);
-        rb_gc_mark(pathdata->v_types);
+        _rb_gc_mark_movable(pathdata->v_points);
+        _rb_gc_mark_movable(pathdata->v_types);
+    }
+}
+
+static void
+gdip_pathdata_compact(gdipPathData *pathdata)
+{
+    if (pathdata != NULL) {
+        pathdata->v_points = _rb_gc_location(pathdata->v_points);
+        pathdata->v_types = _rb_gc_location(pathdata->v_types);
     }
 }
 
 static VALUE cPathData;
-const rb_data_type_t tPathData = _MAKE_DATA_TYPE(
-    "PathData", RUBY_DATA_FUNC(gdip_pathdata_mark), GDIP_DEFAULT_FREE(gdipPathData), NULL, NULL, &cPathData);
+const rb_data_type_t tPathData = _MAKE_DATA_TYPE_MOVABLE(
+    "PathData", RUBY_DATA_FUNC(gdip_pathdata_mark), GDIP_DEFAULT_FREE(gdipPathData), &typeddata_size<gdipPathData>,
+    RUBY_DATA_FUNC(gdip_pathdata_compact), NULL, &cPathData);
 
 static VALUE
 gdip_pathdata_create(PathData *pathdata)
@@ -37,8 +47,8 @@ gdip_pathdata_create(PathData *pathdata)
     int count = pathdata->Count;
     p->count = count;
     if (count <= 0) {
-        p->v_points = rb_ary_new();
-        p->v_types = rb_ary_new();
+        RB_OBJ_WRITE(r, &p->v_points, rb_ary_new());
+        RB_OBJ_WRITE(r, &p->v_types, rb_ary_new());
         RB_OBJ_FREEZE(p->v_points);
         RB_OBJ_FREEZE(p->v_types);
     }
@@ -51,8 +61,8 @@ gdip_pathdata_create(PathData *pathdata)
         }
         RB_OBJ_FREEZE(points);
         RB_OBJ_FREEZE(types);
-        p->v_points = points;
-        p->v_types = types;
+        RB_OBJ_WRITE(r, &p->v_points, points);
+        RB_OBJ_WRITE(r, &p->v_types, types);
     }
     return r;
 }
@@ -443,24 +453,25 @@ gdip_gpath_add_bezier(int argc, VALUE *argv, VALUE self)
 
 /**
  * @overload AddBeziers(points)
- *   @param points [Array<Point or PointF>] The number of points should be 1 + 3n (n >= 1: 4, 7, 10, 13, ...).
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*') The number of points should be 1 + 3n (n >= 1: 4, 7, 10, 13, ...).
  *   @return [self]
  */
 static VALUE
 gdip_gpath_add_beziers(VALUE self, VALUE ary)
 {
     Check_Frozen(self);
-    if (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(ary);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
 
     GraphicsPath *gp = Data_Ptr<GraphicsPath *>(self);
     Check_NULL(gp, "The GraphicsPath object does not exist.");
-    VALUE first = rb_ary_entry(ary, 0);
+    VALUE first = packed ? Qnil : rb_ary_entry(ary, 0);
 
-    if (_KIND_OF(first, &tPoint)) {
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(ary, count);
+        Point *points = packed ? alloc_packed_points(ary, count) : alloc_array_of<Point, &tPoint>(ary, count);
         if ((count - 1) % 3 == 0) {
             Status status = gp->AddBeziers(points, count);
             ruby_xfree(points);
@@ -471,16 +482,16 @@ gdip_gpath_add_beziers(VALUE self, VALUE ary)
             rb_raise(rb_eArgError, "wrong number of elements of the array (%d for 4, 7, 10, 13, ...)", count);
         }
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(ary, count);
+        PointF *points = packed ? get_packed_pointfs(ary, count) : alloc_array_of<PointF, &tPointF>(ary, count);
         if ((count - 1) % 3 == 0) {
             Status status = gp->AddBeziers(points, count);
-            ruby_xfree(points);
+            free_packed_points(ary, points);
             Check_Status(status);
         }
         else {
-            ruby_xfree(points);
+            free_packed_points(ary, points);
             rb_raise(rb_eArgError, "wrong number of elements of the array (%d for 4, 7, 10, 13, ...)", count);
         }
     }
@@ -493,7 +504,7 @@ gdip_gpath_add_beziers(VALUE self, VALUE ary)
 
 /**
  * @overload AddClosedCurve(points, tension=0.5)
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param tension [Float] 0.0-1.0
  *   @return [self]
  */
@@ -518,20 +529,21 @@ gdip_gpath_add_closed_curve(int argc, VALUE *argv, VALUE self)
         }
     }
 
-    if (_RB_ARRAY_P(v_ary) && RARRAY_LEN(v_ary) > 0) {
-        VALUE first = rb_ary_entry(v_ary, 0);
-        if (_KIND_OF(first, &tPoint)) {
+    PackedPointsType packed = gdip_packed_points_type(v_ary);
+    if (packed != PackedPointNone || (_RB_ARRAY_P(v_ary) && RARRAY_LEN(v_ary) > 0)) {
+        VALUE first = packed ? Qnil : rb_ary_entry(v_ary, 0);
+        if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
             int count;
-            Point *points = alloc_array_of<Point, &tPoint>(v_ary, count);
+            Point *points = packed ? alloc_packed_points(v_ary, count) : alloc_array_of<Point, &tPoint>(v_ary, count);
             Status status = gp->AddClosedCurve(points, count, tension);
             ruby_xfree(points);
             Check_Status(status);
         }
-        else if (_KIND_OF(first, &tPointF)) {
+        else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
             int count;
-            PointF *points = alloc_array_of<PointF, &tPointF>(v_ary, count);
+            PointF *points = packed ? get_packed_pointfs(v_ary, count) : alloc_array_of<PointF, &tPointF>(v_ary, count);
             Status status = gp->AddClosedCurve(points, count, tension);
-            ruby_xfree(points);
+            free_packed_points(v_ary, points);
             Check_Status(status);
         }
         else {
@@ -546,10 +558,10 @@ gdip_gpath_add_closed_curve(int argc, VALUE *argv, VALUE self)
 
 /**
  * @overload AddCurve(points, tension=0.5)
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param tension [Float] 0.0-1.0
  * @overload AddCurve(points, offset, num, tension=0.5)
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @param offset [Integer] start index of points
  *   @param num [Integer] number of segments
  *   @param tension [Float] 0.0-1.0
@@ -562,7 +574,8 @@ gdip_gpath_add_curve(int argc, VALUE *argv, VALUE self)
     if (argc < 1 || 4 < argc) {
         rb_raise(rb_eArgError, "wrong number of arguments (%d for 1..4)", argc);
     }
-    if (!_RB_ARRAY_P(argv[0]) || RARRAY_LEN(argv[0]) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(argv[0]);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(argv[0]) || RARRAY_LEN(argv[0]) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
     if (argc == 2 && !Float_p(argv[1])) {
@@ -583,7 +596,7 @@ gdip_gpath_add_curve(int argc, VALUE *argv, VALUE self)
     GraphicsPath *gp = Data_Ptr<GraphicsPath *>(self);
     Check_NULL(gp, "The GraphicsPath object does not exist.");
 
-    VALUE first = rb_ary_entry(argv[0], 0);
+    VALUE first = packed ? Qnil : rb_ary_entry(argv[0], 0);
     int offset = 0;
     int num = 0;
     if (argc > 2) {
@@ -600,9 +613,9 @@ gdip_gpath_add_curve(int argc, VALUE *argv, VALUE self)
         tension = clamp(NUM2SINGLE(argv[3]), 0.0f, 1.0f);
     }
 
-    if (_KIND_OF(first, &tPoint)) {
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(argv[0], count);
+        Point *points = packed ? alloc_packed_points(argv[0], count) : alloc_array_of<Point, &tPoint>(argv[0], count);
         Status status;
         if (argc > 2) {
             status = gp->AddCurve(points, count, offset, num, tension);
@@ -613,9 +626,9 @@ gdip_gpath_add_curve(int argc, VALUE *argv, VALUE self)
         ruby_xfree(points);
         Check_Status(status);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(argv[0], count);
+        PointF *points = packed ? get_packed_pointfs(argv[0], count) : alloc_array_of<PointF, &tPointF>(argv[0], count);
         Status status;
         if (argc > 2) {
             status = gp->AddCurve(points, count, offset, num, tension);
@@ -623,7 +636,7 @@ gdip_gpath_add_curve(int argc, VALUE *argv, VALUE self)
         else {
             status = gp->AddCurve(points, count, tension);
         }
-        ruby_xfree(points);
+        free_packed_points(argv[0], points);
         Check_Status(status);
     }
     else {
@@ -737,33 +750,34 @@ gdip_gpath_add_line(int argc, VALUE *argv, VALUE self)
 
 /**
  * @overload AddLines(points)
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @return [self]
  */
 static VALUE
 gdip_gpath_add_lines(VALUE self, VALUE ary)
 {
     Check_Frozen(self);
-    if (!_RB_ARRAY_P(ary) && RARRAY_LEN(ary) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(ary);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
 
     GraphicsPath *gp = Data_Ptr<GraphicsPath *>(self);
     Check_NULL(gp, "The GraphicsPath object does not exist.");
 
-    VALUE first = rb_ary_entry(ary, 0);
-    if (_KIND_OF(first, &tPoint)) {
+    VALUE first = packed ? Qnil : rb_ary_entry(ary, 0);
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(ary, count);
+        Point *points = packed ? alloc_packed_points(ary, count) : alloc_array_of<Point, &tPoint>(ary, count);
         Status status = gp->AddLines(points, count);
         ruby_xfree(points);
         Check_Status(status);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(ary, count);
+        PointF *points = packed ? get_packed_pointfs(ary, count) : alloc_array_of<PointF, &tPointF>(ary, count);
         Status status = gp->AddLines(points, count);
-        ruby_xfree(points);
+        free_packed_points(ary, points);
         Check_Status(status);
     }
     else {
@@ -845,33 +859,34 @@ gdip_gpath_add_pie(int argc, VALUE *argv, VALUE self)
 
 /**
  * @overload AddPolygon(points)
- *   @param points [Array<Point or PointF>]
+ *   @param points [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String] Points, a flat Array [x0, y0, x1, y1, ...] or pack('f*')
  *   @return [self]
  */
 static VALUE
 gdip_gpath_add_polygon(VALUE self, VALUE ary)
 {
     Check_Frozen(self);
-    if (!_RB_ARRAY_P(ary) && RARRAY_LEN(ary) == 0) {
+    PackedPointsType packed = gdip_packed_points_type(ary);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Point or PointF.");
     }
 
     GraphicsPath *gp = Data_Ptr<GraphicsPath *>(self);
     Check_NULL(gp, "The GraphicsPath object does not exist.");
 
-    VALUE first = rb_ary_entry(ary, 0);
-    if (_KIND_OF(first, &tPoint)) {
+    VALUE first = packed ? Qnil : rb_ary_entry(ary, 0);
+    if (packed == PackedPoint || _KIND_OF(first, &tPoint)) {
         int count;
-        Point *points = alloc_array_of<Point, &tPoint>(ary, count);
+        Point *points = packed ? alloc_packed_points(ary, count) : alloc_array_of<Point, &tPoint>(ary, count);
         Status status = gp->AddPolygon(points, count);
         ruby_xfree(points);
         Check_Status(status);
     }
-    else if (_KIND_OF(first, &tPointF)) {
+    else if (packed == PackedPointF || _KIND_OF(first, &tPointF)) {
         int count;
-        PointF *points = alloc_array_of<PointF, &tPointF>(ary, count);
+        PointF *points = packed ? get_packed_pointfs(ary, count) : alloc_array_of<PointF, &tPointF>(ary, count);
         Status status = gp->AddPolygon(points, count);
-        ruby_xfree(points);
+        free_packed_points(ary, points);
         Check_Status(status);
     }
     else {
@@ -935,20 +950,28 @@ gdip_gpath_add_rectangle(int argc, VALUE *argv, VALUE self)
 
 /**
  * @overload AddRectangles(rectangles)
- *   @param rectangles [Array<Rectangle or RectangleF>]
+ *   @param rectangles [Array<Rectangle or RectangleF>, RectFArray]
  *   @return [self]
  */
 static VALUE
 gdip_gpath_add_rectangles(VALUE self, VALUE ary)
 {
     Check_Frozen(self);
-    if (!_RB_ARRAY_P(ary) && RARRAY_LEN(ary) == 0) {
+    if (!_KIND_OF(ary, &tRectFArray) && (!_RB_ARRAY_P(ary) || RARRAY_LEN(ary) == 0)) {
         rb_raise(rb_eTypeError, "The second argument should be Array of Rectangle or RectangleF.");
     }
 
     GraphicsPath *gp = Data_Ptr<GraphicsPath *>(self);
     Check_NULL(gp, "The GraphicsPath object does not exist.");
 
+    if (_KIND_OF(ary, &tRectFArray)) {
+        int count;
+        RectF *rects = gdip_rectfarray_ptr(ary, count);
+        Status status = gp->AddRectangles(rects, count);
+        Check_Status(status);
+        return self;
+    }
+
     VALUE first = rb_ary_entry(ary, 0);
     if (_KIND_OF(first, &tRectangle)) {
         int count;
@@ -1235,6 +1258,7 @@ gdip_gpath_transform(VALUE self, VALUE v_matrix)
 
     if (_KIND_OF(v_matrix, &tMatrix)) {
         Matrix *matrix = Data_Ptr<Matrix *>(v_matrix);
+        Check_NULL(matrix, "The matrix object does not exist.");
         Status status = gp->Transform(matrix);
         Check_Status(status);
     }
@@ -1333,6 +1357,7 @@ gdip_gpath_widen(int argc, VALUE *argv, VALUE self)
     Pen *pen = NULL;
     if (_KIND_OF(v_pen, &tPen)) {
         pen = Data_Ptr<Pen *>(v_pen);
+        Check_NULL(pen, "The pen object does not exist.");
     }
     else {
         rb_raise(rb_eTypeError, "The first argument should be Pen.");
@@ -1395,6 +1420,7 @@ gdip_gpath_get_bounds(int argc, VALUE *argv, VALUE self)
     if (!RB_NIL_P(v_pen)) {
         if (_KIND_OF(v_pen, &tPen)) {
             pen = Data_Ptr<Pen *>(v_pen);
+            Check_NULL(pen, "The pen object does not exist.");
         }
         else {
             rb_raise(rb_eTypeError, "The second argument should be Pen.");
@@ -5,11 +5,9 @@
  */
 #include "ruby_gdiplus.h"
 #include "simplemap.h"
+#include "gdip_stream.h"
 
 
-static StrSortedArrayMap<GUID *> ext_clsid_table(11);
-static MemPtrSortedArrayMap<GUID *, CLSID *> imgfmt_clsid_table(5);
-
 enum Extname {
     ExtBmp,
     ExtJpeg,
@@ -39,34 +37,130 @@ struct ext_clsid {
     CLSID *guid;
 };
 
-static ext_clsid ext_clsid_map[] = {
+/* Sorted by str. */
+static constexpr ext_clsid ext_clsid_map[] = {
     {".bmp", &clsid_ary[ExtBmp]},
     {".dib", &clsid_ary[ExtBmp]},
-    {".rle", &clsid_ary[ExtBmp]},
-    {".jpg", &clsid_ary[ExtJpeg]},
-    {".jpeg", &clsid_ary[ExtJpeg]},
-    {".jpe", &clsid_ary[ExtJpeg]},
-    {".jfif", &clsid_ary[ExtJpeg]},
     {".gif", &clsid_ary[ExtGif]},
+    {".jfif", &clsid_ary[ExtJpeg]},
+    {".jpe", &clsid_ary[ExtJpeg]},
+    {".jpeg", &clsid_ary[ExtJpeg]},
+    {".jpg", &clsid_ary[ExtJpeg]},
+    {".png", &clsid_ary[ExtPng]},
+    {".rle", &clsid_ary[ExtBmp]},
     {".tif", &clsid_ary[ExtTiff]},
-    {".tiff", &clsid_ary[ExtTiff]},
-    {".png", &clsid_ary[ExtPng]}
+    {".tiff", &clsid_ary[ExtTiff]}
 };
 
-static void
-ext_clsid_table_init()
+typedef FlatMap<ext_clsid, const char *, &ext_clsid::str> ExtClsidMap;
+static_assert(ExtClsidMap::sorted(ext_clsid_map), "ext_clsid_map should be sorted by str.");
+
+static CLSID *
+imgfmt_to_clsid(const GUID *imgfmt)
 {
-    for (unsigned int i = 0; i < (sizeof(ext_clsid_map) / sizeof(ext_clsid)); ++i) {
-        ext_clsid_table.append(ext_clsid_map[i].str, ext_clsid_map[i].guid);
-    }
     for (int i = 0; i < 5; ++i) {
-        imgfmt_clsid_table.append(&imgfmt_ary[i], &clsid_ary[i]);
+        if (IsEqualGUID(*imgfmt, imgfmt_ary[i])) return &clsid_ary[i];
     }
+    return NULL;
 }
 
 const rb_data_type_t tImage = _MAKE_DATA_TYPE(
     "Image", 0, RUBY_NEVER_FREE, NULL, NULL, &cImage);
 
+/*
+ * Returns the encoder for +fmt+ (ImageFormat or ImageCodecInfo), or for the
+ * extension of +filename+ when +fmt+ is nil.
+ */
+CLSID *
+gdip_image_get_encoder_clsid(VALUE fmt, VALUE filename)
+{
+    CLSID *clsid = NULL;
+    if (RB_NIL_P(fmt)) {
+        char ext[6];
+        const ext_clsid *entry = util_extname(filename, ext) ? ExtClsidMap::find(ext_clsid_map, ext) : NULL;
+        if (entry == NULL) {
+            rb_raise(rb_eArgError, "failed to get an image format from a filename");
+        }
+        clsid = entry->guid;
+    }
+    else if (_KIND_OF(fmt, &tGuid)) { // rb_obj_is_kind_of(fmt, cImageFormat)
+        clsid = imgfmt_to_clsid(Data_Ptr<GUID *>(fmt));
+        if (clsid == NULL) {
+            rb_raise(rb_eArgError, "failed to get an image format from a ImageFormat");
+        }
+    }
+    else if (_KIND_OF(fmt, &tImageCodecInfo)) {
+        clsid = &Data_Ptr<ImageCodecInfo *>(fmt)->Clsid;
+    }
+    else {
+        rb_raise(rb_eTypeError, "unexpected type");
+    }
+    return clsid;
+}
+
+/*
+ * Resolves the encoder from the trailing arguments of save and to_blob:
+ * ([imgfmt or icinfo or params]) or (imgfmt or icinfo, params).
+ * +filename+ gives the format by its extension when neither ImageFormat nor ImageCodecInfo is given.
+ */
+static void
+gdip_image_get_encoder(int argc, VALUE *argv, VALUE filename, CLSID **clsid, EncoderParameters **params)
+{
+    VALUE fmt = Qnil;
+    *clsid = NULL;
+    *params = NULL;
+    if (argc > 2) {
+        rb_raise(rb_eArgError, "too many arguments");
+    }
+    if (argc >= 1) {
+        if (argc == 1 && _KIND_OF(argv[0], &tEncoderParameters)) {
+            *params = gdip_encprms_build_struct(argv[0]);
+        }
+        else if (_KIND_OF(argv[0], &tGuid) || _KIND_OF(argv[0], &tImageCodecInfo)) {
+            fmt = argv[0];
+        }
+        else {
+            rb_raise(rb_eTypeError, "unexpected type");
+        }
+    }
+    if (argc == 2) {
+        if (!_KIND_OF(argv[1], &tEncoderParameters)) {
+            rb_raise(rb_eTypeError, "unexpected type");
+        }
+        *params = gdip_encprms_build_struct(argv[1]);
+    }
+    *clsid = gdip_image_get_encoder_clsid(fmt, filename);
+}
+
+/*
+ * Encodes +image+ into +buffer+ through a MemoryStream.
+ * +buffer+ must be modifiable; it is returned as the result.
+ * With +keep_capa+, the caller reuses it and its capacity is kept.
+ * The busy set covers the image and the parameters; +buffer+ is locked by
+ * the stream for as long as the GVL is released.
+ */
+static VALUE
+gdip_image_encode(Image *image, CLSID *clsid, EncoderParameters *params, VALUE buffer, bool keep_capa=false)
+{
+    MemoryStream *stream = new MemoryStream(buffer, keep_capa);
+    Status status = Ok;
+    _rb_ensure(
+        [&]() -> VALUE {
+            stream->set_without_gvl(true);
+            status = gdip_call_without_gvl([&]() { return image->Save(stream, clsid, params); }, image, params);
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            stream->set_without_gvl(false);
+            stream->finish();
+            stream->Release();
+            return Qnil;
+        });
+    RB_GC_GUARD(buffer);
+    Check_Status(status);
+    return util_associate_binary(buffer);
+}
+
 /**
  *
  * @return [self]
@@ -89,12 +183,17 @@ const rb_data_type_t tImage = _MAKE_DATA_TYPE(
  *   @param filename [String]
  *   @param icinfo [ImageCodecInfo]
  *   @param params [EncoderParameters]
+ * @overload save(io, imgfmt, params=nil)
+ *   Encodes in memory and writes the result to +io+ with +write+.
+ *   imgfmt may be omitted if +io+ has a +path+ with a known extension.
+ *   @param io [IO]
+ *   @param imgfmt [ImageFormat or ImageCodecInfo]
+ *   @param params [EncoderParameters]
  */
 static VALUE
 gdip_image_save(int argc, VALUE *argv, VALUE self)
 {
     Image *image = Data_Ptr<Image *>(self);
-    GpStatus status;
     Check_NULL(image, "This image object does not exist.");
 
     if (argc == 0) {
@@ -103,81 +202,69 @@ gdip_image_save(int argc, VALUE *argv, VALUE self)
     else if (argc > 3) {
         rb_raise(rb_eArgError, "too many arguments");
     }
-    if (!_RB_STRING_P(argv[0])) { // or File
-        rb_raise(rb_eTypeError, "a first argument must be String");
-    }
-    VALUE wstr = util_utf16_str_new(argv[0]);
-    if (argc == 1) {
-        char ext[6];
-        CLSID *clsid;
-        if (util_extname(argv[0], ext) && ext_clsid_table.get(ext, clsid)) {
-            status = image->Save(RString_Ptr<WCHAR *>(wstr), clsid, NULL);
-            Check_Status(status);
-        }
-        else {
-            rb_raise(rb_eArgError, "failed to get an image format from a filename");
-        }
+
+    CLSID *clsid;
+    EncoderParameters *params;
+    if (_RB_STRING_P(argv[0])) {
+        gdip_image_get_encoder(argc - 1, argv + 1, argv[0], &clsid, &params);
+        VALUE wstr = util_utf16_str_new(argv[0]);
+        WCHAR *filename = RString_Ptr<WCHAR *>(wstr);
+        GpStatus status = gdip_call_without_gvl([&]() { return image->Save(filename, clsid, params); }, image, params);
+        RB_GC_GUARD(wstr);
+        Check_Status(status);
     }
-    else if (argc == 2) {
-        if (_KIND_OF(argv[1], &tGuid)) { // rb_obj_is_kind_of(argv[1], cImageFormat)
-            CLSID *clsid;
-            if (imgfmt_clsid_table.get(Data_Ptr<GUID *>(argv[1]), clsid)) {
-                status = image->Save(RString_Ptr<WCHAR *>(wstr), clsid, NULL);
-                Check_Status(status);
-            }
-            else {
-                rb_raise(rb_eArgError, "failed to get an image format from a ImageFormat");
-            }
-        }
-        else if (_KIND_OF(argv[1], &tImageCodecInfo)) {
-            ImageCodecInfo *icinfo = Data_Ptr<ImageCodecInfo *>(argv[1]);
-            status = image->Save(RString_Ptr<WCHAR *>(wstr), &icinfo->Clsid, NULL);
-            Check_Status(status);
-        }
-        else if (_KIND_OF(argv[1], &tEncoderParameters)) {
-            char ext[6];
-            CLSID *clsid;
-            if (util_extname(argv[0], ext) && ext_clsid_table.get(ext, clsid)) {
-                EncoderParameters *params = gdip_encprms_build_struct(argv[1]);
-                status = image->Save(RString_Ptr<WCHAR *>(wstr), clsid, params);
-                Check_Status(status);
-            }
-            else {
-                rb_raise(rb_eArgError, "failed to get a image format from a filename");
-            }
-        }
-        else {
-            rb_raise(rb_eTypeError, "unexpected type");
+    else if (rb_respond_to(argv[0], rb_intern("write"))) {
+        VALUE filename = Qnil;
+        if (rb_respond_to(argv[0], rb_intern("path"))) {
+            filename = rb_funcall(argv[0], rb_intern("path"), 0);
         }
+        gdip_image_get_encoder(argc - 1, argv + 1, filename, &clsid, &params);
+        VALUE blob = gdip_image_encode(image, clsid, params, rb_str_new(NULL, 0));
+        rb_funcall(argv[0], rb_intern("write"), 1, blob);
     }
-    else if (argc == 3) {
-        if (_KIND_OF(argv[1], &tGuid) && _KIND_OF(argv[2], &tEncoderParameters)) {
-            CLSID *clsid;
-            if (imgfmt_clsid_table.get(Data_Ptr<GUID *>(argv[1]), clsid)) {
-                status = image->Save(RString_Ptr<WCHAR *>(wstr), clsid, NULL);
-                Check_Status(status);
-            }
-            else {
-                rb_raise(rb_eArgError, "failed to get a image format from a ImageFormat");
-            }
-            EncoderParameters *params = gdip_encprms_build_struct(argv[2]);
-            status = image->Save(RString_Ptr<WCHAR *>(wstr), clsid, params);
-            Check_Status(status);
-        }
-        else if (_KIND_OF(argv[1], &tImageCodecInfo) && _KIND_OF(argv[2], &tEncoderParameters)) {
-            ImageCodecInfo *icinfo = Data_Ptr<ImageCodecInfo *>(argv[1]);
-            EncoderParameters *params = gdip_encprms_build_struct(argv[2]);
-            status = image->Save(RString_Ptr<WCHAR *>(wstr), &icinfo->Clsid, params);
-            Check_Status(status);
-        }
-        else {
-            rb_raise(rb_eTypeError, "unexpected type");
-        }
+    else {
+        rb_raise(rb_eTypeError, "The first argument should be String or IO.");
     }
-    RB_GC_GUARD(wstr);
     return self;
 }
 
+/**
+ * Encodes this image in memory.
+ * @overload to_blob(imgfmt, params=nil, buffer=nil)
+ *   @param imgfmt [ImageFormat or ImageCodecInfo]
+ *   @param params [EncoderParameters or nil]
+ *   @param buffer [String] The String to encode into.
+ *     Its capacity is kept, so passing the same buffer on every call avoids reallocating it.
+ *     The previous content is overwritten.
+ *   @return [String] The encoded bytes (ASCII-8BIT). This is +buffer+ if it is given.
+ * @example
+ *   buf = String.new
+ *   images.each {|img| sock.write(img.to_blob(ImageFormat.Png, nil, buf)) }
+ */
+static VALUE
+gdip_image_to_blob(int argc, VALUE *argv, VALUE self)
+{
+    Image *image = Data_Ptr<Image *>(self);
+    Check_NULL(image, "This image object does not exist.");
+
+    VALUE v_fmt, v_params, v_buffer;
+    rb_scan_args(argc, argv, "12", &v_fmt, &v_params, &v_buffer);
+    if (_KIND_OF(v_fmt, &tEncoderParameters)) {
+        rb_raise(rb_eTypeError, "The first argument should be ImageFormat or ImageCodecInfo.");
+    }
+    CLSID *clsid;
+    EncoderParameters *params;
+    VALUE args[2] = { v_fmt, v_params };
+    gdip_image_get_encoder(RB_NIL_P(v_params) ? 1 : 2, args, Qnil, &clsid, &params);
+
+    if (RB_NIL_P(v_buffer)) {
+        return gdip_image_encode(image, clsid, params, rb_str_new(NULL, 0));
+    }
+    StringValue(v_buffer);
+    rb_str_modify(v_buffer);
+    return gdip_image_encode(image, clsid, params, v_buffer, true);
+}
+
 /**
  * Gets the width of this image.
  * @return [Integer]
@@ -259,26 +346,120 @@ gdip_image_get_raw_format(VALUE self)
     return gdip_enum_guid_create(cImageFormat, &guid);
 }
 
+/*
+ * Deletes the native Graphics of +graphics+ now instead of at GC.
+ * A Graphics that another thread is drawing with is left to the GC.
+ */
+static void
+gdip_image_release_graphics(VALUE graphics)
+{
+    Graphics *g = Data_Ptr<Graphics *>(graphics);
+    if (g == NULL || gdip_busy_p(g)) return;
+    _DATA_PTR(graphics) = NULL;
+    gdip_obj_free<Graphics *>(g);
+}
+
 /**
- * @return [self]
- * @yieldparam g [Graphics]
- * 
+ * Yields a Graphics to draw on this image.
+ * The Graphics is deleted when the block exits; do not keep it.
+ * With +keep_graphics: true+ it is kept in this image and reused by the
+ * next +draw+, which saves repeated setup when the same canvas is redrawn
+ * every frame. Its state (transform, clip, modes, ...) is restored after
+ * each block. A later +draw+ without +keep_graphics+ releases it.
+ * @overload draw(keep_graphics: false)
+ *   @param keep_graphics [Boolean]
+ *   @return [self]
+ *   @yieldparam g [Graphics]
+ * @example
+ *   canvas = Bitmap.new(640, 480)
+ *   frames.each {|frame|
+ *     canvas.draw(keep_graphics: true) {|g| frame.render(g) }
+ *   }
  */
 static VALUE
-gdip_image_draw(VALUE self)
+gdip_image_draw(int argc, VALUE *argv, VALUE self)
 {
+    VALUE v_opts;
+    rb_scan_args(argc, argv, "01", &v_opts);
     Check_Frozen(self);
     Image *image = Data_Ptr<Image *>(self);
     Check_NULL(image, "This Image object does not exist.");
 
-    if (rb_block_given_p()) {
-        Graphics *g = Graphics::FromImage(image);
-        VALUE graphics = gdip_graphics_create(g);
-        rb_yield(graphics);
+    if (!rb_block_given_p()) {
+        return self;
     }
+    bool keep = false;
+    if (!RB_NIL_P(v_opts)) {
+        Check_Type(v_opts, T_HASH);
+        keep = RTEST(rb_hash_aref(v_opts, ID2SYM(rb_intern("keep_graphics"))));
+    }
+
+    ID id_graphics = rb_intern("__gdip_graphics__");
+    VALUE graphics = rb_attr_get(self, id_graphics);
+    Graphics *g = RB_NIL_P(graphics) ? NULL : Data_Ptr<Graphics *>(graphics);
+    if (g == NULL) {
+        graphics = gdip_graphics_from_image(self);
+        g = Data_Ptr<Graphics *>(graphics);
+    }
+    else if (gdip_busy_p(g)) {
+        rb_raise(eGdiplus, "The object is being used by another thread.");
+    }
+    rb_ivar_set(self, id_graphics, keep ? graphics : Qnil);
+
+    GraphicsState state = g->Save();
+    _rb_ensure(
+        [&]() -> VALUE {
+            rb_yield(graphics);
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            if (keep) {
+                Graphics *kept = Data_Ptr<Graphics *>(graphics);
+                if (kept != NULL && !gdip_busy_p(kept)) {
+                    kept->Restore(state);
+                }
+            }
+            else {
+                gdip_image_release_graphics(graphics);
+            }
+            return Qnil;
+        });
     return self;
 }
 
+/**
+ * Frees the image now, with the Graphics kept by {#draw} and the bytes it was
+ * read from. Raises GdiplusError while another Graphics draws on the image or
+ * its pixels are locked by {Bitmap#LockBits}.
+ * @return [nil]
+ */
+static VALUE
+gdip_image_dispose(VALUE self)
+{
+    Check_Frozen(self);
+    Image *image = Data_Ptr<Image *>(self);
+    if (image == NULL) return Qnil;
+    if (gdip_busy_p(image)) {
+        rb_raise(eGdiplus, "The object is being used by another thread.");
+    }
+    ID id_graphics = rb_intern("__gdip_graphics__");
+    VALUE graphics = rb_attr_get(self, id_graphics);
+    void *kept = RB_NIL_P(graphics) ? NULL : _DATA_PTR(graphics);
+    if (gdip_used_p(image, kept)) {
+        rb_raise(eGdiplus, "The object is being used by a Graphics or a BitmapData.");
+    }
+    if (!RB_NIL_P(graphics)) {
+        gdip_obj_dispose(graphics);
+        rb_ivar_set(self, id_graphics, Qnil);
+    }
+    gdip_obj_dispose(self);
+    ID id_source = rb_intern("__gdip_source__");
+    if (rb_ivar_defined(self, id_source)) {
+        rb_ivar_set(self, id_source, Qnil);
+    }
+    return Qnil;
+}
+
 static VALUE
 gdip_image_get_bounds(VALUE self)
 {
@@ -331,12 +512,15 @@ abstruct class
 */
 void Init_image()
 {
-    ext_clsid_table_init();
 
     cImage = rb_define_class_under(mGdiplus, "Image", cGpObject);
     rb_undef_alloc_func(cImage);
     rb_define_method(cImage, "save", RUBY_METHOD_FUNC(gdip_image_save), -1);
-    rb_define_method(cImage, "draw", RUBY_METHOD_FUNC(gdip_image_draw), 0);
+    rb_define_method(cImage, "to_blob", RUBY_METHOD_FUNC(gdip_image_to_blob), -1);
+    rb_define_method(cImage, "draw", RUBY_METHOD_FUNC(gdip_image_draw), -1);
+    rb_define_method(cImage, "Dispose", RUBY_METHOD_FUNC(gdip_image_dispose), 0);
+    rb_define_alias(cImage, "dispose", "Dispose");
+    rb_define_alias(cImage, "close", "Dispose");
 
     ATTR_R(cImage, Width, width, image);
     ATTR_R(cImage, Height, height, image);
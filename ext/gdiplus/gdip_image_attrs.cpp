@@ -6,17 +6,16 @@
 #include "ruby_gdiplus.h"
 
 const rb_data_type_t tImageAttributes = _MAKE_DATA_TYPE(
-    "ImageAttributes", 0, GDIP_OBJ_FREE(ImageAttributes *), NULL, NULL, &cImageAttributes);
+    "ImageAttributes", 0, GDIP_OBJ_FREE(ImageAttributes *), GDIP_OBJ_MEMSIZE(ImageAttributes *), NULL, &cImageAttributes);
 
-static VALUE cColorMatrix;
-static const rb_data_type_t tColorMatrix = _MAKE_DATA_TYPE(
-    "ColorMatrix", 0, GDIP_DEFAULT_FREE(ColorMatrix *), NULL, NULL, &cColorMatrix);
+const rb_data_type_t tColorMatrix = _MAKE_DATA_TYPE(
+    "ColorMatrix", 0, GDIP_DEFAULT_FREE(ColorMatrix *), &typeddata_size<ColorMatrix>, NULL, &cColorMatrix);
 
 static VALUE
 gdip_colormatrix_alloc(VALUE klass)
 {
-    dp("<%s> alloc", type_name<ColorMatrix *>());
     ColorMatrix *ptr = static_cast<ColorMatrix *>(RB_ZALLOC(ColorMatrix));
+    GDIP_TRACE(TraceAlloc, "ColorMatrix", ptr);
     for (int row = 0; row < 5; ++row) {
         for (int column = 0; column < 5; ++ column) {
             ptr->m[row][column] = row == column ? 1.0f : 0.0f;
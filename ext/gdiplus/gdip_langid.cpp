@@ -24,10 +24,8 @@ struct langid_data {
     const char *desc;
 };
 
-StrSortedArrayMap<langid_data *> name_map_table(351 + 2);
-SortedArrayMap<LCID, langid_data *> langid_map_table(351);
-
-static langid_data langid_map[] = {
+/* Sorted by name_n. */
+static constexpr langid_data langid_map[] = {
     {0x0036, "af", "af", "Afrikaans"},
     {0x0436, "af-ZA", "af_za", "Afrikaans (South Africa)"},
     {0x005e, "am", "am", "Amharic"},
@@ -371,9 +369,9 @@ static langid_data langid_map[] = {
     {0x046a, "yo-NG", "yo_ng", "Yoruba (Nigeria)"},
     {0x7804, "zh", "zh", "Chinese"},
     {0x0804, "zh-CN", "zh_cn", "Chinese (Simplified, PRC)"},
-    {0x0c04, "zh-HK", "zh_hk", "Chinese (Traditional, Hong Kong S.A.R.)"},
     {0x0004, "zh-Hans", "zh_hans", "Chinese (Simplified)"},
     {0x7c04, "zh-Hant", "zh_hant", "Chinese (Traditional)"},
+    {0x0c04, "zh-HK", "zh_hk", "Chinese (Traditional, Hong Kong S.A.R.)"},
     {0x1404, "zh-MO", "zh_mo", "Chinese (Traditional, Macao S.A.R.)"},
     {0x1004, "zh-SG", "zh_sg", "Chinese (Simplified, Singapore)"},
     {0x0404, "zh-TW", "zh_tw", "Chinese (Traditional, Taiwan)"},
@@ -381,32 +379,124 @@ static langid_data langid_map[] = {
     {0x0435, "zu-ZA", "zu_za", "isiZulu (South Africa)"},
 };
 
-#define ALIAS_LANGID_0    0x0004
-#define ALIAS_INDEX_0     0
-#define ALIAS_LANGID_1    0x7c04
-#define ALIAS_INDEX_1     1
+typedef FlatMap<langid_data, const char *, &langid_data::name_n> LangIdNameMap;
+static_assert(LangIdNameMap::sorted(langid_map), "langid_map should be sorted by name_n.");
+
+/* Old names of zh-Hans and zh-Hant. */
+static constexpr langid_data langid_aliases[] = {
+    {0x0004, "zh-CHS", "zh_chs", "Chinese (Simplified)"},
+    {0x7c04, "zh-CHT", "zh_cht", "Chinese (Traditional)"},
+};
+static_assert(LangIdNameMap::sorted(langid_aliases), "langid_aliases should be sorted by name_n.");
 
-static const char *aliases[] = {
-    "zh_chs",
-    "zh_cht",
-};  
+struct langid_index {
+    LCID langid;
+    const langid_data *data;
+};
 
-static void
-init_table()
+/* langid_map in LCID order. */
+static constexpr langid_index langid_order[] = {
+    {0x0001, &langid_map[4]}, {0x0002, &langid_map[34]}, {0x0003, &langid_map[48]}, {0x0004, &langid_map[343]},
+    {0x0005, &langid_map[52]}, {0x0006, &langid_map[56]}, {0x0007, &langid_map[58]}, {0x0008, &langid_map[68]},
+    {0x0009, &langid_map[70]}, {0x000a, &langid_map[87]}, {0x000b, &langid_map[114]}, {0x000c, &langid_map[120]},
+    {0x000d, &langid_map[142]}, {0x000e, &langid_map[151]}, {0x000f, &langid_map[161]}, {0x0010, &langid_map[163]},
+    {0x0011, &langid_map[171]}, {0x0012, &langid_map[183]}, {0x0013, &langid_map[221]}, {0x0014, &langid_map[226]},
+    {0x0015, &langid_map[235]}, {0x0016, &langid_map[241]}, {0x0017, &langid_map[250]}, {0x0018, &langid_map[252]},
+    {0x0019, &langid_map[254]}, {0x001a, &langid_map[146]}, {0x001b, &langid_map[268]}, {0x001c, &langid_map[282]},
+    {0x001d, &langid_map[295]}, {0x001e, &langid_map[309]}, {0x001f, &langid_map[315]}, {0x0020, &langid_map[326]},
+    {0x0021, &langid_map[155]}, {0x0022, &langid_map[324]}, {0x0023, &langid_map[32]}, {0x0024, &langid_map[270]},
+    {0x0025, &langid_map[108]}, {0x0026, &langid_map[195]}, {0x0027, &langid_map[193]}, {0x0028, &langid_map[306]},
+    {0x0029, &langid_map[112]}, {0x002a, &langid_map[333]}, {0x002b, &langid_map[153]}, {0x002c, &langid_map[25]},
+    {0x002d, &langid_map[110]}, {0x002e, &langid_map[149]}, {0x002f, &langid_map[199]}, {0x0032, &langid_map[313]},
+    {0x0034, &langid_map[337]}, {0x0035, &langid_map[349]}, {0x0036, &langid_map[0]}, {0x0037, &langid_map[173]},
+    {0x0038, &langid_map[118]}, {0x0039, &langid_map[144]}, {0x003a, &langid_map[215]}, {0x003b, &langid_map[262]},
+    {0x003c, &langid_map[129]}, {0x003e, &langid_map[212]}, {0x003f, &langid_map[175]}, {0x0040, &langid_map[187]},
+    {0x0041, &langid_map[298]}, {0x0042, &langid_map[311]}, {0x0043, &langid_map[328]}, {0x0044, &langid_map[317]},
+    {0x0045, &langid_map[36]}, {0x0046, &langid_map[233]}, {0x0047, &langid_map[137]}, {0x0048, &langid_map[231]},
+    {0x0049, &langid_map[302]}, {0x004a, &langid_map[304]}, {0x004b, &langid_map[181]}, {0x004c, &langid_map[201]},
+    {0x004d, &langid_map[23]}, {0x004e, &langid_map[210]}, {0x004f, &langid_map[258]}, {0x0050, &langid_map[203]},
+    {0x0051, &langid_map[39]}, {0x0052, &langid_map[54]}, {0x0053, &langid_map[179]}, {0x0054, &langid_map[191]},
+    {0x0056, &langid_map[133]}, {0x0057, &langid_map[185]}, {0x005a, &langid_map[300]}, {0x005b, &langid_map[266]},
+    {0x005d, &langid_map[166]}, {0x005e, &langid_map[2]}, {0x005f, &langid_map[319]}, {0x0061, &langid_map[219]},
+    {0x0062, &langid_map[127]}, {0x0063, &langid_map[239]}, {0x0064, &langid_map[116]}, {0x0065, &langid_map[66]},
+    {0x0068, &langid_map[139]}, {0x006a, &langid_map[339]}, {0x006b, &langid_map[246]}, {0x006c, &langid_map[227]},
+    {0x006d, &langid_map[30]}, {0x006e, &langid_map[189]}, {0x006f, &langid_map[177]}, {0x0070, &langid_map[157]},
+    {0x0078, &langid_map[159]}, {0x007a, &langid_map[21]}, {0x007c, &langid_map[208]}, {0x007e, &langid_map[41]},
+    {0x0080, &langid_map[322]}, {0x0081, &langid_map[197]}, {0x0082, &langid_map[229]}, {0x0083, &langid_map[50]},
+    {0x0084, &langid_map[135]}, {0x0085, &langid_map[260]}, {0x0086, &langid_map[244]}, {0x0087, &langid_map[256]},
+    {0x0088, &langid_map[335]}, {0x008c, &langid_map[237]}, {0x0091, &langid_map[131]}, {0x0401, &langid_map[17]},
+    {0x0402, &langid_map[35]}, {0x0403, &langid_map[49]}, {0x0404, &langid_map[348]}, {0x0405, &langid_map[53]},
+    {0x0406, &langid_map[57]}, {0x0407, &langid_map[61]}, {0x0408, &langid_map[69]}, {0x0409, &langid_map[84]},
+    {0x040b, &langid_map[115]}, {0x040c, &langid_map[124]}, {0x040d, &langid_map[143]}, {0x040e, &langid_map[152]},
+    {0x040f, &langid_map[162]}, {0x0410, &langid_map[165]}, {0x0411, &langid_map[172]}, {0x0412, &langid_map[184]},
+    {0x0413, &langid_map[223]}, {0x0414, &langid_map[218]}, {0x0415, &langid_map[236]}, {0x0416, &langid_map[242]},
+    {0x0417, &langid_map[251]}, {0x0418, &langid_map[253]}, {0x0419, &langid_map[255]}, {0x041a, &langid_map[148]},
+    {0x041b, &langid_map[269]}, {0x041c, &langid_map[283]}, {0x041d, &langid_map[297]}, {0x041e, &langid_map[310]},
+    {0x041f, &langid_map[316]}, {0x0420, &langid_map[327]}, {0x0421, &langid_map[156]}, {0x0422, &langid_map[325]},
+    {0x0423, &langid_map[33]}, {0x0424, &langid_map[271]}, {0x0425, &langid_map[109]}, {0x0426, &langid_map[196]},
+    {0x0427, &langid_map[194]}, {0x0428, &langid_map[308]}, {0x0429, &langid_map[113]}, {0x042a, &langid_map[334]},
+    {0x042b, &langid_map[154]}, {0x042c, &langid_map[29]}, {0x042d, &langid_map[111]}, {0x042e, &langid_map[150]},
+    {0x042f, &langid_map[200]}, {0x0432, &langid_map[314]}, {0x0434, &langid_map[338]}, {0x0435, &langid_map[350]},
+    {0x0436, &langid_map[1]}, {0x0437, &langid_map[174]}, {0x0438, &langid_map[119]}, {0x0439, &langid_map[145]},
+    {0x043a, &langid_map[216]}, {0x043b, &langid_map[264]}, {0x043e, &langid_map[214]}, {0x043f, &langid_map[176]},
+    {0x0440, &langid_map[188]}, {0x0441, &langid_map[299]}, {0x0442, &langid_map[312]}, {0x0443, &langid_map[332]},
+    {0x0444, &langid_map[318]}, {0x0445, &langid_map[38]}, {0x0446, &langid_map[234]}, {0x0447, &langid_map[138]},
+    {0x0448, &langid_map[232]}, {0x0449, &langid_map[303]}, {0x044a, &langid_map[305]}, {0x044b, &langid_map[182]},
+    {0x044c, &langid_map[202]}, {0x044d, &langid_map[24]}, {0x044e, &langid_map[211]}, {0x044f, &langid_map[259]},
+    {0x0450, &langid_map[205]}, {0x0451, &langid_map[40]}, {0x0452, &langid_map[55]}, {0x0453, &langid_map[180]},
+    {0x0454, &langid_map[192]}, {0x0456, &langid_map[134]}, {0x0457, &langid_map[186]}, {0x045a, &langid_map[301]},
+    {0x045b, &langid_map[267]}, {0x045d, &langid_map[168]}, {0x045e, &langid_map[3]}, {0x0461, &langid_map[220]},
+    {0x0462, &langid_map[128]}, {0x0463, &langid_map[240]}, {0x0464, &langid_map[117]}, {0x0465, &langid_map[67]},
+    {0x0468, &langid_map[141]}, {0x046a, &langid_map[340]}, {0x046b, &langid_map[247]}, {0x046c, &langid_map[228]},
+    {0x046d, &langid_map[31]}, {0x046e, &langid_map[190]}, {0x046f, &langid_map[178]}, {0x0470, &langid_map[158]},
+    {0x0478, &langid_map[160]}, {0x047a, &langid_map[22]}, {0x047c, &langid_map[209]}, {0x047e, &langid_map[42]},
+    {0x0480, &langid_map[323]}, {0x0481, &langid_map[198]}, {0x0482, &langid_map[230]}, {0x0483, &langid_map[51]},
+    {0x0484, &langid_map[136]}, {0x0485, &langid_map[261]}, {0x0486, &langid_map[245]}, {0x0487, &langid_map[257]},
+    {0x0488, &langid_map[336]}, {0x048c, &langid_map[238]}, {0x0491, &langid_map[132]}, {0x0801, &langid_map[9]},
+    {0x0804, &langid_map[342]}, {0x0807, &langid_map[60]}, {0x0809, &langid_map[75]}, {0x080a, &langid_map[98]},
+    {0x080c, &langid_map[121]}, {0x0810, &langid_map[164]}, {0x0813, &langid_map[222]}, {0x0814, &langid_map[225]},
+    {0x0816, &langid_map[243]}, {0x081a, &langid_map[292]}, {0x081d, &langid_map[296]}, {0x082c, &langid_map[27]},
+    {0x082e, &langid_map[65]}, {0x083b, &langid_map[265]}, {0x083c, &langid_map[130]}, {0x083e, &langid_map[213]},
+    {0x0843, &langid_map[330]}, {0x0845, &langid_map[37]}, {0x0850, &langid_map[207]}, {0x085d, &langid_map[170]},
+    {0x085f, &langid_map[321]}, {0x086b, &langid_map[248]}, {0x0c01, &langid_map[8]}, {0x0c04, &langid_map[345]},
+    {0x0c07, &langid_map[59]}, {0x0c09, &langid_map[72]}, {0x0c0a, &langid_map[95]}, {0x0c0c, &langid_map[122]},
+    {0x0c1a, &langid_map[287]}, {0x0c3b, &langid_map[263]}, {0x0c6b, &langid_map[249]}, {0x1001, &langid_map[13]},
+    {0x1004, &langid_map[347]}, {0x1007, &langid_map[63]}, {0x1009, &langid_map[74]}, {0x100a, &langid_map[96]},
+    {0x100c, &langid_map[123]}, {0x101a, &langid_map[147]}, {0x103b, &langid_map[276]}, {0x1401, &langid_map[7]},
+    {0x1404, &langid_map[346]}, {0x1407, &langid_map[62]}, {0x1409, &langid_map[80]}, {0x140a, &langid_map[92]},
+    {0x140c, &langid_map[125]}, {0x141a, &langid_map[47]}, {0x143b, &langid_map[277]}, {0x1801, &langid_map[14]},
+    {0x1809, &langid_map[76]}, {0x180a, &langid_map[100]}, {0x180c, &langid_map[126]}, {0x181a, &langid_map[291]},
+    {0x183b, &langid_map[273]}, {0x1c01, &langid_map[19]}, {0x1c09, &langid_map[85]}, {0x1c0a, &langid_map[93]},
+    {0x1c1a, &langid_map[286]}, {0x1c3b, &langid_map[274]}, {0x2001, &langid_map[15]}, {0x2009, &langid_map[78]},
+    {0x200a, &langid_map[107]}, {0x201a, &langid_map[45]}, {0x203b, &langid_map[281]}, {0x2401, &langid_map[20]},
+    {0x2409, &langid_map[71]}, {0x240a, &langid_map[91]}, {0x241a, &langid_map[294]}, {0x243b, &langid_map[279]},
+    {0x2801, &langid_map[18]}, {0x2809, &langid_map[73]}, {0x280a, &langid_map[101]}, {0x281a, &langid_map[289]},
+    {0x2c01, &langid_map[10]}, {0x2c09, &langid_map[83]}, {0x2c0a, &langid_map[88]}, {0x2c1a, &langid_map[293]},
+    {0x3001, &langid_map[12]}, {0x3009, &langid_map[86]}, {0x300a, &langid_map[94]}, {0x301a, &langid_map[288]},
+    {0x3401, &langid_map[11]}, {0x3409, &langid_map[81]}, {0x340a, &langid_map[90]}, {0x3801, &langid_map[5]},
+    {0x380a, &langid_map[106]}, {0x3c01, &langid_map[6]}, {0x3c0a, &langid_map[103]}, {0x4001, &langid_map[16]},
+    {0x4009, &langid_map[77]}, {0x400a, &langid_map[89]}, {0x4409, &langid_map[79]}, {0x440a, &langid_map[104]},
+    {0x4809, &langid_map[82]}, {0x480a, &langid_map[97]}, {0x4c0a, &langid_map[99]}, {0x500a, &langid_map[102]},
+    {0x540a, &langid_map[105]}, {0x641a, &langid_map[44]}, {0x681a, &langid_map[46]}, {0x6c1a, &langid_map[285]},
+    {0x701a, &langid_map[290]}, {0x703b, &langid_map[278]}, {0x742c, &langid_map[26]}, {0x743b, &langid_map[280]},
+    {0x7804, &langid_map[341]}, {0x7814, &langid_map[224]}, {0x781a, &langid_map[43]}, {0x782c, &langid_map[28]},
+    {0x783b, &langid_map[272]}, {0x7843, &langid_map[329]}, {0x7850, &langid_map[204]}, {0x785d, &langid_map[167]},
+    {0x7c04, &langid_map[344]}, {0x7c14, &langid_map[217]}, {0x7c1a, &langid_map[284]}, {0x7c28, &langid_map[307]},
+    {0x7c2e, &langid_map[64]}, {0x7c3b, &langid_map[275]}, {0x7c43, &langid_map[331]}, {0x7c50, &langid_map[206]},
+    {0x7c5d, &langid_map[169]}, {0x7c5f, &langid_map[320]}, {0x7c68, &langid_map[140]},
+};
+
+typedef FlatMap<langid_index, LCID, &langid_index::langid> LangIdOrderMap;
+static_assert(LangIdOrderMap::sorted(langid_order), "langid_order should be sorted by LCID.");
+
+static constexpr bool
+langid_order_matches(const langid_index *table, size_t n)
 {
-    for (unsigned int i = 0; i < (sizeof(langid_map) / sizeof(langid_data)); ++i) {
-        name_map_table.append(langid_map[i].name_n, &langid_map[i]);
-        switch (langid_map[i].langid) {
-            case ALIAS_LANGID_0:
-                name_map_table.append(aliases[ALIAS_INDEX_0], &langid_map[i]);
-                break;
-            case ALIAS_LANGID_1:
-                name_map_table.append(aliases[ALIAS_INDEX_1], &langid_map[i]);
-                break;
-        };
-        langid_map_table.append((LCID)langid_map[i].langid, &langid_map[i]);
-    } 
-}  
+    return n == 0 || (table[0].data->langid == table[0].langid && langid_order_matches(table + 1, n - 1));
+}
+static_assert(sizeof(langid_order) == sizeof(langid_map) / sizeof(langid_data) * sizeof(langid_index) &&
+              langid_order_matches(langid_order, sizeof(langid_order) / sizeof(langid_index)),
+              "langid_order should point to the entry of its LCID.");
 
 static char
 normalize_name_c(char c)
@@ -418,7 +508,7 @@ normalize_name_c(char c)
 
 #define MAX_NAME_LEN    12
 
-static langid_data *
+static const langid_data *
 table_lookup_by_name(const char *name)
 {
     char name_n[MAX_NAME_LEN] = {0};
@@ -427,8 +517,8 @@ table_lookup_by_name(const char *name)
         name_n[i] = normalize_name_c(name[i]);
     }
     if (i == MAX_NAME_LEN) return NULL;
-    langid_data *r = NULL;
-    name_map_table.get(name_n, r);
+    const langid_data *r = LangIdNameMap::find(langid_map, name_n);
+    if (r == NULL) r = LangIdNameMap::find(langid_aliases, name_n);
     return r;
 }  
 
@@ -463,7 +553,7 @@ gdip_langid_init(int argc, VALUE *argv, VALUE self)
             Data_Ptr_Set_As(self, RB_NUM2UINT(argv[0]) & 0xffff);
         }
         else if (_RB_STRING_P(argv[0])) {
-            langid_data *data = table_lookup_by_name(RSTRING_PTR(argv[0]));
+            const langid_data *data = table_lookup_by_name(RSTRING_PTR(argv[0]));
             if (data != NULL) {
                 Data_Ptr_Set_As(self, data->langid);
             }
@@ -486,13 +576,14 @@ static VALUE
 gdip_langid_inspect(VALUE self)
 {
     LCID langid = Data_Ptr_As<LCID>(self);
-    langid_data *data = NULL;
     VALUE r;
     if (langid == 0) {
         r = util_utf8_sprintf("#<%s 0x%04x NEUTRAL>", __class__(self), langid);
     }
     else {
-        if (langid_map_table.get(langid, data)) {
+        const langid_index *index = LangIdOrderMap::find(langid_order, langid);
+        if (index != NULL) {
+            const langid_data *data = index->data;
             r = util_utf8_sprintf("#<%s 0x%04x %s: %s>", __class__(self), langid, data->name, data->desc);
         }
         else {
@@ -529,7 +620,7 @@ static VALUE
 gdip_langid_s_get_langid(VALUE self)
 {
     const char *name = rb_id2name(rb_frame_this_func());
-    langid_data *data = table_lookup_by_name(name);
+    const langid_data *data = table_lookup_by_name(name);
     VALUE r = Qnil;
     if (data != NULL) {
         r = typeddata_alloc_null<&tLangId>(cLangId);
@@ -541,7 +632,48 @@ gdip_langid_s_get_langid(VALUE self)
     return r;
 }
 
-#define rb_define_singleton_method_ rb_define_singleton_method
+/* Whether +method+ is +name+ with '-' replaced by '_' (e.g. en_US for en-US). */
+static bool
+langid_method_name_p(const char *method, const char *name)
+{
+    for (; *name != 0; ++method, ++name) {
+        if (*method != (*name == '-' ? '_' : *name)) return false;
+    }
+    return *method == 0;
+}
+
+static const langid_data *
+langid_lookup_by_method(VALUE name)
+{
+    if (!RB_SYMBOL_P(name)) return NULL;
+    const char *method = rb_id2name(RB_SYM2ID(name));
+    if (method == NULL) return NULL;
+    const langid_data *data = table_lookup_by_name(method);
+    if (data == NULL || !langid_method_name_p(method, data->name)) return NULL;
+    return data;
+}
+
+/*
+ * LangId.en_US etc. are defined on first call instead of at load time.
+ */
+static VALUE
+gdip_langid_s_method_missing(int argc, VALUE *argv, VALUE self)
+{
+    const langid_data *data = argc == 1 ? langid_lookup_by_method(argv[0]) : NULL;
+    if (data != NULL) {
+        rb_define_singleton_method(cLangId, rb_id2name(RB_SYM2ID(argv[0])), RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
+        return gdip_langid_create(data->langid);
+    }
+    return rb_call_super(argc, argv);
+}
+
+static VALUE
+gdip_langid_s_respond_to_missing_p(VALUE self, VALUE name, VALUE include_private)
+{
+    if (langid_lookup_by_method(name) != NULL) return Qtrue;
+    VALUE args[2] = { name, include_private };
+    return rb_call_super(2, args);
+}
 
 
 /**
@@ -557,366 +689,15 @@ gdip_langid_s_get_langid(VALUE self)
 void
 Init_langid()
 {
-    init_table();
     cLangId = rb_define_class_under(mGdiplus, "LangId", rb_cObject);
     rb_define_alloc_func(cLangId, &typeddata_alloc_null<&tLangId>);
     rb_define_method(cLangId, "initialize", RUBY_METHOD_FUNC(gdip_langid_init), -1);
     rb_define_method(cLangId, "inspect", RUBY_METHOD_FUNC(gdip_langid_inspect), 0);
     rb_define_method(cLangId, "to_i", RUBY_METHOD_FUNC(gdip_langid_to_i), 0);
     rb_define_method(cLangId, "==", RUBY_METHOD_FUNC(gdip_langid_equal), 1);
-    
-    rb_define_singleton_method_(cLangId, "af", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "af_ZA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "am", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "am_ET", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_AE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_BH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_DZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_EG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_IQ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_JO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_KW", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_LB", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_LY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_MA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_OM", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_QA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_SA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_SY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_TN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ar_YE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "arn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "arn_CL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "as", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "as_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "az", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "az_Cyrl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "az_Cyrl_AZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "az_Latn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "az_Latn_AZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ba", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ba_RU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "be", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "be_BY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bg", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bg_BG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bn_BD", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bn_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bo", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bo_CN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "br", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "br_FR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bs", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bs_Cyrl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bs_Cyrl_BA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bs_Latn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "bs_Latn_BA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ca", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ca_ES", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "co", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "co_FR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "cs", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "cs_CZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "cy", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "cy_GB", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "da", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "da_DK", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "de", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "de_AT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "de_CH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "de_DE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "de_LI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "de_LU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "dsb", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "dsb_DE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "dv", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "dv_MV", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "el", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "el_GR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_029", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_AU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_BZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_CA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_GB", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_IE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_JM", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_MY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_NZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_PH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_SG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_TT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_US", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_ZA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "en_ZW", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_AR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_BO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_CL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_CO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_CR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_DO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_EC", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_ES", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_GT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_HN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_MX", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_NI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_PA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_PE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_PR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_PY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_SV", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_US", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_UY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "es_VE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "et", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "et_EE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "eu", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "eu_ES", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fa", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fa_IR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fi", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fi_FI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fil", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fil_PH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fo", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fo_FO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fr", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fr_BE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fr_CA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fr_CH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fr_FR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fr_LU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fr_MC", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fy", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "fy_NL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ga", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ga_IE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gd", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gd_GB", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gl_ES", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gsw", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gsw_FR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gu", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "gu_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ha", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ha_Latn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ha_Latn_NG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "he", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "he_IL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hi", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hi_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hr", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hr_BA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hr_HR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hsb", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hsb_DE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hu", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hu_HU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hy", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "hy_AM", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "id", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "id_ID", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ig", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ig_NG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ii", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ii_CN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "is", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "is_IS", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "it", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "it_CH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "it_IT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "iu", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "iu_Cans", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "iu_Cans_CA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "iu_Latn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "iu_Latn_CA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ja", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ja_JP", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ka", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ka_GE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kk", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kk_KZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kl_GL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "km", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "km_KH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kn_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ko", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ko_KR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kok", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "kok_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ky", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ky_KG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lb", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lb_LU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lo", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lo_LA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lt", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lt_LT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lv", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "lv_LV", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mi", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mi_NZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mk", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mk_MK", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ml", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ml_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mn_Cyrl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mn_MN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mn_Mong", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mn_Mong_CN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "moh", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "moh_CA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mr", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mr_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ms", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ms_BN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ms_MY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mt", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "mt_MT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nb", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nb_NO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ne", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ne_NP", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nl_BE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nl_NL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nn_NO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "no", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nso", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "nso_ZA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "oc", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "oc_FR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "or", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "or_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "pa", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "pa_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "pl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "pl_PL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "prs", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "prs_AF", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ps", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ps_AF", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "pt", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "pt_BR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "pt_PT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "qut", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "qut_GT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "quz", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "quz_BO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "quz_EC", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "quz_PE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "rm", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "rm_CH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ro", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ro_RO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ru", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ru_RU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "rw", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "rw_RW", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sa", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sa_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sah", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sah_RU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "se", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "se_FI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "se_NO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "se_SE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "si", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "si_LK", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sk", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sk_SK", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sl_SI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sma", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sma_NO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sma_SE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "smj", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "smj_NO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "smj_SE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "smn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "smn_FI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sms", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sms_FI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sq", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sq_AL", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Cyrl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Cyrl_BA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Cyrl_CS", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Cyrl_ME", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Cyrl_RS", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Latn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Latn_BA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Latn_CS", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Latn_ME", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sr_Latn_RS", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sv", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sv_FI", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sv_SE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sw", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "sw_KE", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "syr", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "syr_SY", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ta", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ta_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "te", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "te_IN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tg", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tg_Cyrl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tg_Cyrl_TJ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "th", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "th_TH", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tk", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tk_TM", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tn_ZA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tr", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tr_TR", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tt", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tt_RU", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tzm", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tzm_Latn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "tzm_Latn_DZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ug", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ug_CN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "uk", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "uk_UA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ur", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "ur_PK", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "uz", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "uz_Cyrl", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "uz_Cyrl_UZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "uz_Latn", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "uz_Latn_UZ", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "vi", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "vi_VN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "wo", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "wo_SN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "xh", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "xh_ZA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "yo", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "yo_NG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_CHS", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_CHT", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_CN", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_HK", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_Hans", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_Hant", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_MO", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_SG", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zh_TW", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zu", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
-    rb_define_singleton_method_(cLangId, "zu_ZA", RUBY_METHOD_FUNC(gdip_langid_s_get_langid), 0);
+    // @private
+    rb_define_singleton_method(cLangId, "method_missing", RUBY_METHOD_FUNC(gdip_langid_s_method_missing), -1);
+    // @private
+    rb_define_singleton_method(cLangId, "respond_to_missing?", RUBY_METHOD_FUNC(gdip_langid_s_respond_to_missing_p), 2);
 }
 
@@ -0,0 +1,332 @@
+/*
+ * gdip_live_objects.cpp
+ * Copyright (c) 2017 Yagi Sumiya
+ * Released under the MIT License.
+ */
+#include "ruby_gdiplus.h"
+
+bool gdip_live_enabled = false;
+long gdip_live_count = 0;
+
+static const int LiveBacktraceDepth = 32;
+
+struct gdipLiveEntry {
+    const char *type; // type_name<T>() of the GDI+ object
+    void *obj;
+    size_t size;
+    double created;   // seconds since the Unix epoch
+    VALUE backtrace;  // frozen Array of String
+    gdipLiveEntry *prev;
+    gdipLiveEntry *next;
+};
+
+/* GDI+ object => gdipLiveEntry, and all entries in creation order. Only touched with the GVL held. */
+static st_table *live_table = NULL;
+static gdipLiveEntry *live_first = NULL;
+static gdipLiveEntry *live_last = NULL;
+/* Hidden object that marks the backtraces. Created when tracking is first turned on. */
+static VALUE live_registry = Qnil;
+
+static void
+gdip_live_registry_mark(void *ptr)
+{
+    for (gdipLiveEntry *entry = live_first; entry != NULL; entry = entry->next) {
+        rb_gc_mark(entry->backtrace);
+    }
+}
+
+static const rb_data_type_t tLiveRegistry = _MAKE_DATA_TYPE(
+    "LiveRegistry", RUBY_DATA_FUNC(gdip_live_registry_mark), RUBY_NEVER_FREE, NULL, NULL, NULL);
+
+static double
+gdip_live_now()
+{
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    ULARGE_INTEGER t;
+    t.LowPart = ft.dwLowDateTime;
+    t.HighPart = ft.dwHighDateTime;
+    return static_cast<double>(t.QuadPart - 116444736000000000ULL) / 10000000.0; // 100 ns since 1601
+}
+
+static VALUE
+gdip_live_backtrace()
+{
+#if RUBY_API_VERSION_CODE >= 20000
+    VALUE backtrace = rb_funcall(rb_mKernel, rb_intern("caller"), 2, RB_INT2FIX(0), RB_INT2FIX(LiveBacktraceDepth));
+#else
+    VALUE backtrace = rb_funcall(rb_mKernel, rb_intern("caller"), 1, RB_INT2FIX(0));
+#endif
+    return RB_NIL_P(backtrace) ? rb_ary_new() : rb_obj_freeze(backtrace);
+}
+
+/*
+ * Registers a GDI+ object created while tracking is on (see gdip_obj_create).
+ * Called with the GVL held.
+ */
+void
+gdip_live_add(const char *type, void *obj, size_t size)
+{
+    VALUE backtrace = gdip_live_backtrace(); // may run GC, which removes entries
+    gdip_live_remove(obj);
+    gdipLiveEntry *entry = RB_ZALLOC(gdipLiveEntry);
+    entry->type = type;
+    entry->obj = obj;
+    entry->size = size;
+    entry->created = gdip_live_now();
+    entry->backtrace = Qnil;
+    entry->prev = live_last;
+    if (live_last != NULL) live_last->next = entry;
+    else live_first = entry;
+    live_last = entry;
+    st_insert(live_table, reinterpret_cast<st_data_t>(obj), reinterpret_cast<st_data_t>(entry));
+    RB_OBJ_WRITE(live_registry, &entry->backtrace, backtrace);
+    gdip_live_count += 1;
+}
+
+/*
+ * Unregisters a GDI+ object that is being deleted (see gdip_obj_free).
+ * Called from the free functions, so this must not allocate Ruby objects.
+ */
+void
+gdip_live_remove(void *obj)
+{
+    if (live_table == NULL) return;
+    st_data_t key = reinterpret_cast<st_data_t>(obj);
+    st_data_t data = 0;
+    if (!st_delete(live_table, &key, &data)) return;
+    gdipLiveEntry *entry = reinterpret_cast<gdipLiveEntry *>(data);
+    if (entry->prev != NULL) entry->prev->next = entry->next;
+    else live_first = entry->next;
+    if (entry->next != NULL) entry->next->prev = entry->prev;
+    else live_last = entry->prev;
+    ruby_xfree(entry);
+    gdip_live_count -= 1;
+}
+
+/* "Gdiplus::Bitmap*" => "Bitmap" */
+static VALUE
+gdip_live_type_name(const char *type)
+{
+    if (strncmp(type, "Gdiplus::", 9) == 0) type += 9;
+    long len = static_cast<long>(strlen(type));
+    while (len > 0 && (type[len - 1] == '*' || type[len - 1] == ' ')) len -= 1;
+    return rb_str_new(type, len);
+}
+
+/* A copy of a gdipLiveEntry that stays valid while the entry is unlinked. */
+struct gdipLiveSnapshot {
+    const char *type;
+    void *obj;
+    size_t size;
+    double created;
+    VALUE backtrace;
+};
+
+/*
+ * Runs +func+ for a copy of each registered entry, oldest first.
+ * +func+ may allocate or call Ruby, which can run GC or switch to a thread
+ * that disposes an object and unlinks its entry; the copies are taken
+ * first, by a walk that allocates nothing, and their backtraces are held
+ * in an Array meanwhile.
+ */
+template<typename F>
+static void
+gdip_live_each(F func)
+{
+    long count = gdip_live_count;
+    if (count <= 0) return;
+    VALUE tmp = Qnil;
+    gdipLiveSnapshot *snap = static_cast<gdipLiveSnapshot *>(_rb_alloc_tmp_buffer(&tmp, count * sizeof(gdipLiveSnapshot)));
+    VALUE backtraces = rb_ary_new_capa(count);
+    long n = 0;
+    for (gdipLiveEntry *entry = live_first; entry != NULL && n < count; entry = entry->next) {
+        snap[n].type = entry->type;
+        snap[n].obj = entry->obj;
+        snap[n].size = entry->size;
+        snap[n].created = entry->created;
+        snap[n].backtrace = entry->backtrace;
+        rb_ary_push(backtraces, entry->backtrace);
+        n += 1;
+    }
+    _rb_ensure(
+        [&]() -> VALUE {
+            for (long i = 0; i < n; ++i) {
+                func(&snap[i]);
+            }
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            _rb_free_tmp_buffer(&tmp);
+            return Qnil;
+        });
+    RB_GC_GUARD(backtraces);
+}
+
+/**
+ * Starts or stops recording the GDI+ objects created from now on, with their
+ * type, size, creation time and the Ruby backtrace of the creation.
+ * Stopping does not forget the objects recorded so far; they are removed when freed.
+ * Recording is off by default; while it is off creating an object only checks a flag.
+ * @param enabled [Boolean]
+ * @return [Boolean]
+ * @see live_objects
+ */
+static VALUE
+gdiplus_s_set_track_objects(VALUE self, VALUE enabled)
+{
+    if (RB_TEST(enabled) && RB_NIL_P(live_registry)) {
+        live_table = st_init_numtable();
+        live_registry = _Data_Wrap_Struct(0, &tLiveRegistry, NULL);
+        rb_gc_register_address(&live_registry);
+    }
+    gdip_live_enabled = RB_TEST(enabled);
+    return enabled;
+}
+
+/**
+ * @return [Boolean] whether GDI+ objects are being recorded.
+ */
+static VALUE
+gdiplus_s_get_track_objects(VALUE self)
+{
+    return gdip_live_enabled ? Qtrue : Qfalse;
+}
+
+/**
+ * Returns the recorded GDI+ objects that are still alive, oldest first.
+ * Only the objects created while {track_objects=} is on are recorded.
+ * @overload live_objects
+ *   @return [Array<Hash>] [{type: String, address: Integer, size: Integer, created_at: Time, backtrace: Array<String>}, ...]
+ * @overload live_objects(group_by: :type)
+ *   @return [Hash{String => Hash}] {type => {count: Integer, size: Integer}}
+ * @overload live_objects(group_by: :backtrace)
+ *   @return [Hash{Array<String> => Hash}] {backtrace => {count: Integer, size: Integer}}
+ * @example
+ *   Gdiplus.track_objects = true
+ *   ...
+ *   Gdiplus.live_objects(group_by: :type) # => {"Bitmap" => {count: 12, size: 48000384}, ...}
+ */
+static VALUE
+gdiplus_s_live_objects(int argc, VALUE *argv, VALUE self)
+{
+    VALUE v_opts;
+    rb_scan_args(argc, argv, "01", &v_opts);
+    VALUE group_by = Qnil;
+    if (!RB_NIL_P(v_opts)) {
+        Check_Type(v_opts, T_HASH);
+        group_by = rb_hash_aref(v_opts, ID2SYM(rb_intern("group_by")));
+    }
+    bool by_type = group_by == ID2SYM(rb_intern("type"));
+    bool by_backtrace = group_by == ID2SYM(rb_intern("backtrace"));
+    if (!RB_NIL_P(group_by) && !by_type && !by_backtrace) {
+        rb_raise(rb_eArgError, "group_by should be :type or :backtrace");
+    }
+
+    VALUE sym_count = ID2SYM(rb_intern("count"));
+    VALUE sym_size = ID2SYM(rb_intern("size"));
+    if (by_type || by_backtrace) {
+        VALUE r = rb_hash_new();
+        gdip_live_each([&](gdipLiveSnapshot *entry) {
+            VALUE key = by_type ? gdip_live_type_name(entry->type) : entry->backtrace;
+            VALUE group = rb_hash_aref(r, key);
+            if (RB_NIL_P(group)) {
+                group = rb_hash_new();
+                rb_hash_aset(group, sym_count, RB_INT2FIX(0));
+                rb_hash_aset(group, sym_size, RB_INT2FIX(0));
+                rb_hash_aset(r, key, group);
+            }
+            rb_hash_aset(group, sym_count, rb_funcall(rb_hash_aref(group, sym_count), '+', 1, RB_INT2FIX(1)));
+            rb_hash_aset(group, sym_size, rb_funcall(rb_hash_aref(group, sym_size), '+', 1, ULL2NUM(entry->size)));
+        });
+        return r;
+    }
+
+    VALUE sym_type = ID2SYM(rb_intern("type"));
+    VALUE sym_address = ID2SYM(rb_intern("address"));
+    VALUE sym_created_at = ID2SYM(rb_intern("created_at"));
+    VALUE sym_backtrace = ID2SYM(rb_intern("backtrace"));
+    VALUE r = rb_ary_new_capa(gdip_live_count);
+    gdip_live_each([&](gdipLiveSnapshot *entry) {
+        double sec = floor(entry->created);
+        VALUE h = rb_hash_new();
+        rb_hash_aset(h, sym_type, gdip_live_type_name(entry->type));
+        rb_hash_aset(h, sym_address, ULL2NUM(reinterpret_cast<uintptr_t>(entry->obj)));
+        rb_hash_aset(h, sym_size, ULL2NUM(entry->size));
+        rb_hash_aset(h, sym_created_at, rb_time_new(static_cast<time_t>(sec), static_cast<long>((entry->created - sec) * 1000000.0)));
+        rb_hash_aset(h, sym_backtrace, entry->backtrace);
+        rb_ary_push(r, h);
+    });
+    return r;
+}
+
+static void
+gdip_live_json_str(VALUE buf, VALUE str)
+{
+    str = util_encode_to_utf8(str);
+    const char *p = RSTRING_PTR(str);
+    long len = RSTRING_LEN(str);
+    long start = 0;
+    rb_str_cat(buf, "\"", 1);
+    for (long i = 0; i < len; ++i) {
+        unsigned char c = static_cast<unsigned char>(p[i]);
+        if (c != '"' && c != '\\' && c >= 0x20) continue;
+        rb_str_cat(buf, p + start, i - start);
+        char esc[8] = {0};
+        if (c == '"' || c == '\\') _snprintf(esc, 7, "\\%c", c);
+        else _snprintf(esc, 7, "\\u%04x", c);
+        rb_str_cat_cstr(buf, esc);
+        start = i + 1;
+    }
+    rb_str_cat(buf, p + start, len - start);
+    rb_str_cat(buf, "\"", 1);
+    RB_GC_GUARD(str);
+}
+
+/**
+ * Dumps the recorded live GDI+ objects as JSON, one object per line like
+ * ObjectSpace.dump_all:
+ *
+ *   {"address":"0x1d2e3f40", "type":"Bitmap", "size":4000096, "created_at":1508822400.123456, "backtrace":["app.rb:10:in `initialize'", ...]}
+ *
+ * @overload dump_live_objects
+ *   @return [String]
+ * @overload dump_live_objects(io)
+ *   Writes the dump to +io+ with +write+.
+ *   @param io [IO]
+ *   @return [IO] +io+
+ * @see live_objects
+ */
+static VALUE
+gdiplus_s_dump_live_objects(int argc, VALUE *argv, VALUE self)
+{
+    VALUE io;
+    rb_scan_args(argc, argv, "01", &io);
+    VALUE r = rb_utf8_str_new_cstr("");
+    gdip_live_each([&](gdipLiveSnapshot *entry) {
+        VALUE address = rb_funcall(ULL2NUM(reinterpret_cast<uintptr_t>(entry->obj)), rb_intern("to_s"), 1, RB_INT2FIX(16));
+        rb_str_cat_cstr(r, "{\"address\":\"0x");
+        rb_str_append(r, address);
+        rb_str_cat_cstr(r, "\", \"type\":");
+        gdip_live_json_str(r, gdip_live_type_name(entry->type));
+        rb_str_concat(r, util_utf8_sprintf(", \"size\":%llu, \"created_at\":%.6f, \"backtrace\":[",
+            static_cast<unsigned long long>(entry->size), entry->created));
+        for (long i = 0; i < RARRAY_LEN(entry->backtrace); ++i) {
+            if (i > 0) rb_str_cat(r, ",", 1);
+            gdip_live_json_str(r, rb_obj_as_string(rb_ary_entry(entry->backtrace, i)));
+        }
+        rb_str_cat_cstr(r, "]}\n");
+    });
+    if (RB_NIL_P(io)) return r;
+    rb_funcall(io, rb_intern("write"), 1, r);
+    return io;
+}
+
+void
+Init_live_objects()
+{
+    rb_define_module_function(mGdiplus, "track_objects=", RUBY_METHOD_FUNC(gdiplus_s_set_track_objects), 1);
+    rb_define_module_function(mGdiplus, "track_objects?", RUBY_METHOD_FUNC(gdiplus_s_get_track_objects), 0);
+    rb_define_module_function(mGdiplus, "live_objects", RUBY_METHOD_FUNC(gdiplus_s_live_objects), -1);
+    rb_define_module_function(mGdiplus, "dump_live_objects", RUBY_METHOD_FUNC(gdiplus_s_dump_live_objects), -1);
+}
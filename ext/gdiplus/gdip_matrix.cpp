@@ -6,7 +6,7 @@
 #include "ruby_gdiplus.h"
 
 const rb_data_type_t tMatrix = _MAKE_DATA_TYPE(
-    "Matrix", 0, GDIP_OBJ_FREE(Matrix *), NULL, NULL, &cMatrix);
+    "Matrix", 0, GDIP_OBJ_FREE(Matrix *), GDIP_OBJ_MEMSIZE(Matrix *), NULL, &cMatrix);
 
 static VALUE
 gdip_matrix_create(Matrix *matrix)
@@ -447,8 +447,13 @@ gdip_matrix_translate(int argc, VALUE *argv, VALUE self)
 /**
  * @overload TransformPoints(points)
  *   Returns the result of applying this matrix to the specified points.
- *   @param points[Array<Point or PointF>]
- *   @return [Array<Point or PointF>]
+ *   Packed points are returned in the same packed form: a flat Array of numbers,
+ *   a binary String of floats or a new PointFArray.
+ *   @param points[Array<Point or PointF>, PointFArray, Array<Integer or Float>, String]
+ *   @return [Array<Point or PointF>, PointFArray, Array<Integer or Float>, String]
+ *   @example
+ *     matrix.TransformPoints([0.0, 0.0, 10.0, 20.0]) # => [x0, y0, x1, y1]
+ *     matrix.TransformPoints([0.0, 0.0, 10.0, 20.0].pack('f*')).unpack('f*')
  */
 static VALUE
 gdip_matrix_transform_points(VALUE self, VALUE v_points)
@@ -456,13 +461,57 @@ gdip_matrix_transform_points(VALUE self, VALUE v_points)
     Matrix *matrix = Data_Ptr<Matrix *>(self);
     Check_NULL(matrix, "This Matrix object does not exist.");
     
-    if (!_RB_ARRAY_P(v_points) || RARRAY_LEN(v_points) < 1) {
+    PackedPointsType packed = gdip_packed_points_type(v_points);
+    if (packed == PackedPointNone && (!_RB_ARRAY_P(v_points) || RARRAY_LEN(v_points) < 1)) {
         rb_raise(rb_eTypeError, "The arguments should be Array of Point or PointF.");
     }
 
     VALUE r = Qnil;
-    VALUE first = rb_ary_entry(v_points, 0);
     Status status = Ok;
+    if (packed == PackedPoint) {
+        int count = 0;
+        Point *points = alloc_packed_points(v_points, count);
+        status = matrix->TransformPoints(points, count);
+        r = rb_ary_new_capa(count * 2);
+        for (int i = 0; i < count; ++i) {
+            rb_ary_push(r, RB_INT2NUM(points[i].X));
+            rb_ary_push(r, RB_INT2NUM(points[i].Y));
+        }
+        ruby_xfree(points);
+        Check_Status(status);
+        return r;
+    }
+    else if (_KIND_OF(v_points, &tPointFArray)) {
+        int count = 0;
+        PointF *points = gdip_pointfarray_ptr(v_points, count);
+        r = gdip_pointfarray_create(points, count);
+        points = gdip_pointfarray_ptr(r, count);
+        if (count > 0) {
+            status = matrix->TransformPoints(points, count);
+            Check_Status(status);
+        }
+        return r;
+    }
+    else if (packed == PackedPointF) {
+        int count = 0;
+        PointF *points = get_packed_pointfs(v_points, count);
+        status = matrix->TransformPoints(points, count);
+        if (_RB_STRING_P(v_points)) {
+            r = rb_str_new(reinterpret_cast<const char *>(points), count * sizeof(PointF));
+        }
+        else {
+            r = rb_ary_new_capa(count * 2);
+            for (int i = 0; i < count; ++i) {
+                rb_ary_push(r, SINGLE2NUM(points[i].X));
+                rb_ary_push(r, SINGLE2NUM(points[i].Y));
+            }
+        }
+        ruby_xfree(points);
+        Check_Status(status);
+        return r;
+    }
+
+    VALUE first = rb_ary_entry(v_points, 0);
     if (_KIND_OF(first, &tPoint)) {
         int count = 0;
         Point *points = alloc_array_of<Point, &tPoint>(v_points, count);
@@ -491,6 +540,31 @@ gdip_matrix_transform_points(VALUE self, VALUE v_points)
     return r;
 }
 
+/**
+ * @overload TransformPoints!(points)
+ *   Applies this matrix to the points in place.
+ *   @param points [PointFArray]
+ *   @return [PointFArray] points
+ */
+static VALUE
+gdip_matrix_transform_points_bang(VALUE self, VALUE v_points)
+{
+    Matrix *matrix = Data_Ptr<Matrix *>(self);
+    Check_NULL(matrix, "This Matrix object does not exist.");
+    if (!_KIND_OF(v_points, &tPointFArray)) {
+        rb_raise(rb_eTypeError, "The argument should be PointFArray.");
+    }
+    Check_Frozen(v_points);
+
+    int count = 0;
+    PointF *points = gdip_pointfarray_ptr(v_points, count);
+    if (count > 0) {
+        Status status = matrix->TransformPoints(points, count);
+        Check_Status(status);
+    }
+    return v_points;
+}
+
 /**
  * @overload TransformVectors(points)
  *   Returns the result of applying this matrix excluding translation to the specified points, ignoring translation (dx, dy).
@@ -574,6 +648,8 @@ Init_matrix()
     rb_define_alias(cMatrix, "translate", "Translate");
     rb_define_method(cMatrix, "TransformPoints", RUBY_METHOD_FUNC(gdip_matrix_transform_points), 1);
     rb_define_alias(cMatrix, "transform_points", "TransformPoints");
+    rb_define_method(cMatrix, "TransformPoints!", RUBY_METHOD_FUNC(gdip_matrix_transform_points_bang), 1);
+    rb_define_alias(cMatrix, "transform_points!", "TransformPoints!");
     rb_define_method(cMatrix, "TransformVectors", RUBY_METHOD_FUNC(gdip_matrix_transform_vectors), 1);
     rb_define_alias(cMatrix, "transform_points", "TransformVectors");
     rb_define_alias(cMatrix, "VectorTransformPoints", "TransformVectors");
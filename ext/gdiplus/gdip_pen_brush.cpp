@@ -8,7 +8,7 @@
 
 
 const rb_data_type_t tPen = _MAKE_DATA_TYPE(
-    "Pen", 0, GDIP_OBJ_FREE(Pen *), NULL, NULL, &cPen);
+    "Pen", 0, GDIP_OBJ_FREE(Pen *), GDIP_OBJ_MEMSIZE(Pen *), NULL, &cPen);
 
 /**
  *
@@ -47,6 +47,7 @@ gdip_pen_init(int argc, VALUE *argv, VALUE self)
     Color color;
     if (_KIND_OF(color_or_brush, &tBrush)) {
         Brush *brush = Data_Ptr<Brush *>(color_or_brush);
+        Check_NULL(brush, "The brush object does not exist.");
         _DATA_PTR(self) = gdip_obj_create<Pen *>(new Pen(brush, width));
     } else if (gdip_arg_to_color(color_or_brush, &color)) {
         _DATA_PTR(self) = gdip_obj_create<Pen *>(new Pen(color, width));
@@ -565,7 +566,7 @@ gdip_pen_set_start_cap(VALUE self, VALUE cap)
 //   //
 /////
 const rb_data_type_t tBrush = _MAKE_DATA_TYPE(
-    "Brush", 0, GDIP_OBJ_FREE(Brush *), NULL, NULL, &cBrush);
+    "Brush", 0, GDIP_OBJ_FREE(Brush *), GDIP_OBJ_MEMSIZE(Brush *), NULL, &cBrush);
 
 /**
  * Gets the tyep of this brush.
@@ -0,0 +1,583 @@
+/*
+ * gdip_pipeline.cpp
+ * Copyright (c) 2017 Yagi Sumiya
+ * Released under the MIT License.
+ */
+#include "ruby_gdiplus.h"
+
+/* Threads per stage; three stages must fit in one WaitForMultipleObjects. */
+static const int PipelineMaxThreads = MAXIMUM_WAIT_OBJECTS / 3;
+
+static VALUE cPipelineResult;
+
+enum PipelineStage {
+    StageDecode,
+    StageResize,
+    StageEncode
+};
+
+struct gdipThumbJob {
+    const WCHAR *src;
+    const WCHAR *dst; // NULL: encode into memory
+    CLSID *clsid;
+    Bitmap *image;    // the decoded image, then the thumbnail
+    IStream *blob;
+    Status status;
+    LONGLONG ticks[3];
+};
+
+/*
+ * Fixed-size queue of job indices between two stages.
+ * push blocks while it is full, pop blocks while it is empty.
+ */
+class gdipBoundedQueue {
+    CRITICAL_SECTION Lock;
+    HANDLE Slots;
+    HANDLE Items;
+    int *Buf;
+    int Capa;
+    int Head;
+    int Tail;
+public:
+    explicit gdipBoundedQueue(int capa) {
+        InitializeCriticalSection(&Lock);
+        Slots = CreateSemaphore(NULL, capa, capa, NULL);
+        Items = CreateSemaphore(NULL, 0, capa, NULL);
+        Buf = new int[capa];
+        Capa = capa;
+        Head = 0;
+        Tail = 0;
+    }
+    ~gdipBoundedQueue() {
+        if (Slots) CloseHandle(Slots);
+        if (Items) CloseHandle(Items);
+        delete[] Buf;
+        DeleteCriticalSection(&Lock);
+    }
+    bool valid() const {
+        return Slots != NULL && Items != NULL;
+    }
+    void push(int v) {
+        WaitForSingleObject(Slots, INFINITE);
+        EnterCriticalSection(&Lock);
+        Buf[Tail] = v;
+        Tail = (Tail + 1) % Capa;
+        LeaveCriticalSection(&Lock);
+        ReleaseSemaphore(Items, 1, NULL);
+    }
+    int pop() {
+        WaitForSingleObject(Items, INFINITE);
+        EnterCriticalSection(&Lock);
+        int v = Buf[Head];
+        Head = (Head + 1) % Capa;
+        LeaveCriticalSection(&Lock);
+        ReleaseSemaphore(Slots, 1, NULL);
+        return v;
+    }
+};
+
+struct gdipPipeline {
+    gdipThumbJob *jobs;
+    int count;
+    int threads;
+    UINT box_w;
+    UINT box_h;
+    InterpolationMode mode;
+    EncoderParameters *params;
+    bool started;
+    volatile LONG canceled;
+    volatile LONG next;
+    volatile LONG decoders;
+    volatile LONG resizers;
+    gdipBoundedQueue decoded;
+    gdipBoundedQueue resized;
+
+    gdipPipeline(gdipThumbJob *jobs_, int count_, int threads_) :
+        jobs(jobs_), count(count_), threads(threads_), box_w(0), box_h(0),
+        mode(InterpolationModeHighQualityBicubic), params(NULL), started(false),
+        canceled(0), next(0), decoders(threads_), resizers(threads_),
+        decoded(threads_ * 2), resized(threads_ * 2) {}
+
+    void run();
+    bool canceled_p() const { return canceled != 0; }
+};
+
+static inline LONGLONG
+pipeline_now()
+{
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return t.QuadPart;
+}
+
+static void
+pipeline_decode(gdipThumbJob *job)
+{
+    LONGLONG t0 = pipeline_now();
+    Bitmap *bmp = new Bitmap(job->src, FALSE);
+    Status status = bmp->GetLastStatus();
+    if (status != Ok) {
+        delete bmp;
+        bmp = NULL;
+    }
+    job->image = bmp;
+    job->status = status;
+    job->ticks[StageDecode] = pipeline_now() - t0;
+}
+
+/* Fits the image in box_w x box_h keeping its aspect ratio. Smaller images keep their size. */
+static void
+pipeline_resize(gdipThumbJob *job, UINT box_w, UINT box_h, InterpolationMode mode)
+{
+    if (job->status != Ok) return;
+    LONGLONG t0 = pipeline_now();
+    Bitmap *src = job->image;
+    UINT sw = src->GetWidth();
+    UINT sh = src->GetHeight();
+    UINT tw = sw;
+    UINT th = sh;
+    if (sw > box_w || sh > box_h) {
+        double scale = static_cast<double>(box_w) / sw;
+        double scale_h = static_cast<double>(box_h) / sh;
+        if (scale_h < scale) scale = scale_h;
+        tw = static_cast<UINT>(sw * scale + 0.5);
+        th = static_cast<UINT>(sh * scale + 0.5);
+        if (tw < 1) tw = 1;
+        if (th < 1) th = 1;
+    }
+    Bitmap *dst = new Bitmap(tw, th, PixelFormat32bppPARGB);
+    Status status = dst->GetLastStatus();
+    if (status == Ok) {
+        dst->SetResolution(src->GetHorizontalResolution(), src->GetVerticalResolution());
+        status = gdip_bitmap_resize(src, dst, mode, 1);
+    }
+    delete src;
+    if (status != Ok) {
+        delete dst;
+        dst = NULL;
+    }
+    job->image = dst;
+    job->status = status;
+    job->ticks[StageResize] = pipeline_now() - t0;
+}
+
+static void
+pipeline_encode(gdipThumbJob *job, EncoderParameters *params)
+{
+    if (job->status != Ok) return;
+    LONGLONG t0 = pipeline_now();
+    Status status;
+    if (job->dst) {
+        status = job->image->Save(job->dst, job->clsid, params);
+    }
+    else {
+        IStream *stream = NULL;
+        if (CreateStreamOnHGlobal(NULL, TRUE, &stream) != S_OK) {
+            status = OutOfMemory;
+        }
+        else {
+            status = job->image->Save(stream, job->clsid, params);
+            if (status == Ok) {
+                job->blob = stream;
+            }
+            else {
+                stream->Release();
+            }
+        }
+    }
+    delete job->image;
+    job->image = NULL;
+    job->status = status;
+    job->ticks[StageEncode] = pipeline_now() - t0;
+}
+
+/*
+ * The unblocking function of the batch: called on another thread when the
+ * calling Ruby thread is interrupted. The workers check the flag between jobs.
+ */
+static void
+pipeline_cancel(void *data)
+{
+    gdipPipeline *pipe = static_cast<gdipPipeline *>(data);
+    InterlockedExchange(&pipe->canceled, 1);
+}
+
+/*
+ * Gives up a job that was taken from a queue after the batch was canceled.
+ * The queues are still drained so that no thread blocks on a full one.
+ */
+static void
+pipeline_abort(gdipThumbJob *job)
+{
+    delete job->image;
+    job->image = NULL;
+    if (job->status == Ok) {
+        job->status = Aborted;
+    }
+}
+
+static DWORD WINAPI
+pipeline_decoder_proc(LPVOID param)
+{
+    gdipPipeline *pipe = static_cast<gdipPipeline *>(param);
+    if (!pipe->started) return 0;
+    while (!pipe->canceled_p()) {
+        LONG i = InterlockedIncrement(&pipe->next) - 1;
+        if (i >= pipe->count) break;
+        pipeline_decode(&pipe->jobs[i]);
+        pipe->decoded.push(i);
+    }
+    if (InterlockedDecrement(&pipe->decoders) == 0) {
+        for (int k = 0; k < pipe->threads; ++k) {
+            pipe->decoded.push(-1);
+        }
+    }
+    return 0;
+}
+
+static DWORD WINAPI
+pipeline_resizer_proc(LPVOID param)
+{
+    gdipPipeline *pipe = static_cast<gdipPipeline *>(param);
+    if (!pipe->started) return 0;
+    for (int i = pipe->decoded.pop(); i >= 0; i = pipe->decoded.pop()) {
+        if (pipe->canceled_p()) {
+            pipeline_abort(&pipe->jobs[i]);
+        }
+        else {
+            pipeline_resize(&pipe->jobs[i], pipe->box_w, pipe->box_h, pipe->mode);
+        }
+        pipe->resized.push(i);
+    }
+    if (InterlockedDecrement(&pipe->resizers) == 0) {
+        for (int k = 0; k < pipe->threads; ++k) {
+            pipe->resized.push(-1);
+        }
+    }
+    return 0;
+}
+
+static DWORD WINAPI
+pipeline_encoder_proc(LPVOID param)
+{
+    gdipPipeline *pipe = static_cast<gdipPipeline *>(param);
+    if (!pipe->started) return 0;
+    for (int i = pipe->resized.pop(); i >= 0; i = pipe->resized.pop()) {
+        if (pipe->canceled_p()) {
+            pipeline_abort(&pipe->jobs[i]);
+        }
+        else {
+            pipeline_encode(&pipe->jobs[i], pipe->params);
+        }
+    }
+    return 0;
+}
+
+/*
+ * Runs +threads+ decoders, resizers and encoders connected by the two queues.
+ * The threads are created suspended; if any of them cannot be created, they
+ * all exit at once and the jobs run one by one on the calling thread.
+ */
+void
+gdipPipeline::run()
+{
+    static LPTHREAD_START_ROUTINE procs[3] = { pipeline_encoder_proc, pipeline_resizer_proc, pipeline_decoder_proc };
+    HANDLE handles[PipelineMaxThreads * 3];
+    int n = 0;
+    bool ok = decoded.valid() && resized.valid();
+    for (int s = 0; ok && s < 3; ++s) {
+        for (int k = 0; ok && k < threads; ++k) {
+            HANDLE h = CreateThread(NULL, 0, procs[s], this, CREATE_SUSPENDED, NULL);
+            if (h == NULL) {
+                ok = false;
+            }
+            else {
+                handles[n++] = h;
+            }
+        }
+    }
+    started = ok;
+    for (int i = 0; i < n; ++i) {
+        ResumeThread(handles[i]);
+    }
+    if (n > 0) {
+        WaitForMultipleObjects(n, handles, TRUE, INFINITE);
+        for (int i = 0; i < n; ++i) {
+            CloseHandle(handles[i]);
+        }
+    }
+    if (!ok) {
+        for (; next < count && !canceled_p(); ++next) {
+            pipeline_decode(&jobs[next]);
+            pipeline_resize(&jobs[next], box_w, box_h, mode);
+            pipeline_encode(&jobs[next], params);
+        }
+    }
+}
+
+static VALUE
+pipeline_opt(VALUE opts, const char *name)
+{
+    return RB_NIL_P(opts) ? Qnil : rb_hash_aref(opts, ID2SYM(rb_intern(name)));
+}
+
+static VALUE
+pipeline_blob_to_str(IStream *stream)
+{
+    HGLOBAL hg;
+    STATSTG stat;
+    if (GetHGlobalFromStream(stream, &hg) != S_OK || stream->Stat(&stat, STATFLAG_NONAME) != S_OK) {
+        return Qnil;
+    }
+    void *ptr = GlobalLock(hg);
+    VALUE str = rb_str_new(static_cast<char *>(ptr), static_cast<long>(stat.cbSize.QuadPart));
+    GlobalUnlock(hg);
+    return util_associate_binary(str);
+}
+
+/**
+ * Makes thumbnails of many files. Decoding, resizing and encoding run as
+ * overlapping stages on native threads without the GVL, so one file is
+ * decoded while others are scaled and encoded.
+ * Every item gets a {Result}; a file that fails does not stop the others.
+ * When the calling thread is interrupted, the workers stop between files;
+ * if the interrupt does not raise (e.g. a trap handler), the files that were
+ * not made get the status +:Aborted+.
+ * @overload thumbnail(inputs, size:, format: nil, quality: nil, params: nil, mode: InterpolationMode.HighQualityBicubic, threads: nil)
+ *   @param inputs [Array] Each item is +[src, dst]+ to write the thumbnail to the file +dst+,
+ *     or +src+ alone to encode it into {Result#data}.
+ *   @param size [Integer or Size or Array] The box the thumbnail fits in, keeping the aspect ratio.
+ *     An Integer is the longest side. Smaller images are not enlarged.
+ *   @param format [ImageFormat or ImageCodecInfo] The format of every output.
+ *     If nil, it is taken from the extension of +dst+; it is required for the items without +dst+.
+ *   @param quality [Integer] JPEG quality from 0 to 100.
+ *   @param params [EncoderParameters] Encoder parameters; cannot be given with +quality+.
+ *   @param mode [InterpolationMode]
+ *   @param threads [Integer] Threads per stage; the number of cores if nil.
+ *   @return [Array<Result>] in the order of +inputs+.
+ * @example
+ *   files = Dir["photos/*.jpg"].map {|f| [f, "thumbs/" + File.basename(f)] }
+ *   results = Gdiplus::Pipeline.thumbnail(files, size: 256, quality: 80)
+ *   results.reject(&:ok?).each {|r| warn "#{r.input}: #{r.status}" }
+ */
+static VALUE
+gdip_pipeline_s_thumbnail(int argc, VALUE *argv, VALUE self)
+{
+    VALUE v_inputs, v_opts;
+    rb_scan_args(argc, argv, "11", &v_inputs, &v_opts);
+    Check_Type(v_inputs, T_ARRAY);
+    if (!RB_NIL_P(v_opts)) {
+        Check_Type(v_opts, T_HASH);
+    }
+    GdiplusEnsureStarted();
+
+    int box_w, box_h;
+    VALUE v_size = pipeline_opt(v_opts, "size");
+    if (_RB_INTEGER_P(v_size)) {
+        box_w = box_h = RB_NUM2INT(v_size);
+    }
+    else if (_KIND_OF(v_size, &tSize)) {
+        Size *size = Data_Ptr<Size *>(v_size);
+        box_w = size->Width;
+        box_h = size->Height;
+    }
+    else if (_RB_ARRAY_P(v_size) && RARRAY_LEN(v_size) == 2) {
+        box_w = RB_NUM2INT(rb_ary_entry(v_size, 0));
+        box_h = RB_NUM2INT(rb_ary_entry(v_size, 1));
+    }
+    else {
+        rb_raise(rb_eArgError, "size: should be Integer, Size or [width, height].");
+    }
+    if (box_w <= 0 || box_h <= 0) {
+        rb_raise(rb_eArgError, "size: should be greater than 0.");
+    }
+
+    VALUE v_format = pipeline_opt(v_opts, "format");
+    CLSID *fmt_clsid = RB_NIL_P(v_format) ? NULL : gdip_image_get_encoder_clsid(v_format, Qnil);
+
+    VALUE v_quality = pipeline_opt(v_opts, "quality");
+    VALUE v_params = pipeline_opt(v_opts, "params");
+    EncoderParameters *params = NULL;
+    EncoderParameters quality_params;
+    ULONG quality;
+    if (!RB_NIL_P(v_quality)) {
+        if (!RB_NIL_P(v_params)) {
+            rb_raise(rb_eArgError, "quality: and params: cannot be given together.");
+        }
+        quality = clamp(RB_NUM2INT(v_quality), 0, 100);
+        quality_params.Count = 1;
+        quality_params.Parameter[0].Guid = EncoderQuality;
+        quality_params.Parameter[0].NumberOfValues = 1;
+        quality_params.Parameter[0].Type = EncoderParameterValueTypeLong;
+        quality_params.Parameter[0].Value = &quality;
+        params = &quality_params;
+    }
+    else if (!RB_NIL_P(v_params)) {
+        params = gdip_encprms_build_struct(v_params);
+    }
+
+    InterpolationMode mode = InterpolationModeHighQualityBicubic;
+    VALUE v_mode = pipeline_opt(v_opts, "mode");
+    if (!RB_NIL_P(v_mode)) {
+        gdip_arg_to_enumint(cInterpolationMode, v_mode, &mode, "mode: should be InterpolationMode.");
+    }
+
+    int threads;
+    VALUE v_threads = pipeline_opt(v_opts, "threads");
+    if (RB_NIL_P(v_threads)) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        threads = static_cast<int>(info.dwNumberOfProcessors);
+    }
+    else {
+        threads = RB_NUM2INT(v_threads);
+    }
+    threads = clamp(threads, 1, PipelineMaxThreads);
+
+    int count = static_cast<int>(RARRAY_LEN(v_inputs));
+    VALUE r = rb_ary_new_capa(count);
+    if (count == 0) return r;
+
+    VALUE tmp;
+    gdipThumbJob *jobs = static_cast<gdipThumbJob *>(_rb_alloc_tmp_buffer(&tmp, sizeof(gdipThumbJob) * count));
+    memset(jobs, 0, sizeof(gdipThumbJob) * count);
+    VALUE keep = rb_ary_new_capa(count * 2);
+    for (int i = 0; i < count; ++i) {
+        VALUE item = rb_ary_entry(v_inputs, i);
+        VALUE v_src = item;
+        VALUE v_dst = Qnil;
+        if (_RB_ARRAY_P(item) && RARRAY_LEN(item) == 2) {
+            v_src = rb_ary_entry(item, 0);
+            v_dst = rb_ary_entry(item, 1);
+        }
+        if (!_RB_STRING_P(v_src) || !(RB_NIL_P(v_dst) || _RB_STRING_P(v_dst))) {
+            rb_raise(rb_eTypeError, "Each input should be a filename or [src, dst] filenames.");
+        }
+        rb_ary_push(keep, util_utf16_str_new(v_src));
+        if (RB_NIL_P(v_dst)) {
+            if (fmt_clsid == NULL) {
+                rb_raise(rb_eArgError, "format: is required for an input without dst.");
+            }
+            jobs[i].clsid = fmt_clsid;
+            rb_ary_push(keep, Qnil);
+        }
+        else {
+            jobs[i].clsid = fmt_clsid ? fmt_clsid : gdip_image_get_encoder_clsid(Qnil, v_dst);
+            rb_ary_push(keep, util_utf16_str_new(v_dst));
+        }
+        jobs[i].status = GenericError;
+    }
+
+    /*
+     * The workers read the names without the GVL, while another thread may
+     * run GC.compact and move short (embedded) Strings, so they get copies.
+     */
+    long names_len = 0;
+    for (long k = 0; k < RARRAY_LEN(keep); ++k) {
+        VALUE wstr = rb_ary_entry(keep, k);
+        if (!RB_NIL_P(wstr)) names_len += RSTRING_LEN(wstr);
+    }
+    VALUE tmp_names;
+    char *names = static_cast<char *>(_rb_alloc_tmp_buffer(&tmp_names, names_len));
+    for (int i = 0; i < count; ++i) {
+        VALUE wsrc = rb_ary_entry(keep, i * 2);
+        memcpy(names, RSTRING_PTR(wsrc), RSTRING_LEN(wsrc));
+        jobs[i].src = reinterpret_cast<WCHAR *>(names);
+        names += RSTRING_LEN(wsrc);
+        VALUE wdst = rb_ary_entry(keep, i * 2 + 1);
+        if (!RB_NIL_P(wdst)) {
+            memcpy(names, RSTRING_PTR(wdst), RSTRING_LEN(wdst));
+            jobs[i].dst = reinterpret_cast<WCHAR *>(names);
+            names += RSTRING_LEN(wdst);
+        }
+    }
+
+    gdipPipeline pipe(jobs, count, threads);
+    pipe.box_w = box_w;
+    pipe.box_h = box_h;
+    pipe.mode = mode;
+    pipe.params = params;
+    bool done = false;
+    _rb_ensure(
+        [&]() -> VALUE {
+            gdip_call_without_gvl_ubf([&]() { pipe.run(); return Ok; }, pipeline_cancel, &pipe, params);
+            done = true;
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            if (!done) {
+                // interrupted by an exception: nobody will read the encoded data
+                for (int i = 0; i < count; ++i) {
+                    if (jobs[i].blob) {
+                        jobs[i].blob->Release();
+                        jobs[i].blob = NULL;
+                    }
+                }
+            }
+            return Qnil;
+        });
+    RB_GC_GUARD(v_params);
+    for (int i = pipe.next; i < count; ++i) {
+        jobs[i].status = Aborted;
+    }
+
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    double unit = 1.0 / static_cast<double>(freq.QuadPart);
+    for (int i = 0; i < count; ++i) {
+        gdipThumbJob *job = &jobs[i];
+        VALUE data = Qnil;
+        if (job->blob) {
+            data = pipeline_blob_to_str(job->blob);
+            job->blob->Release();
+            job->blob = NULL;
+        }
+        VALUE item = rb_ary_entry(v_inputs, i);
+        VALUE input = item;
+        VALUE output = Qnil;
+        if (_RB_ARRAY_P(item)) {
+            input = rb_ary_entry(item, 0);
+            output = rb_ary_entry(item, 1);
+        }
+        const char *status = job->status < 22 ? GpStatusStrs[job->status] : "UnknownError";
+        rb_ary_push(r, rb_struct_new(cPipelineResult, input, output, ID2SYM(rb_intern(status)), data,
+            DBL2NUM(job->ticks[StageDecode] * unit),
+            DBL2NUM(job->ticks[StageResize] * unit),
+            DBL2NUM(job->ticks[StageEncode] * unit)));
+    }
+    _rb_free_tmp_buffer(&tmp_names);
+    _rb_free_tmp_buffer(&tmp);
+    return r;
+}
+
+/*
+ * @return [Boolean] true if the thumbnail was written.
+ */
+static VALUE
+gdip_pipeline_result_ok_p(VALUE self)
+{
+    return rb_struct_aref(self, RB_INT2FIX(2)) == ID2SYM(rb_intern("Ok")) ? Qtrue : Qfalse;
+}
+
+/*
+Document-module: Gdiplus::Pipeline
+Batch image processing on native threads.
+*/
+/*
+Document-class: Gdiplus::Pipeline::Result
+The outcome of one input of {Pipeline.thumbnail}.
++status+ is the name of the GDI+ status as a Symbol (+:Ok+, +:FileNotFound+, ...).
++data+ is the encoded thumbnail for an input without a destination file.
++decode_time+, +resize_time+ and +encode_time+ are in seconds.
+*/
+void
+Init_pipeline()
+{
+    mPipeline = rb_define_module_under(mGdiplus, "Pipeline");
+    rb_define_module_function(mPipeline, "thumbnail", RUBY_METHOD_FUNC(gdip_pipeline_s_thumbnail), -1);
+
+    cPipelineResult = rb_struct_define(NULL, "input", "output", "status", "data",
+        "decode_time", "resize_time", "encode_time", NULL);
+    rb_define_const(mPipeline, "Result", cPipelineResult);
+    rb_define_method(cPipelineResult, "ok?", RUBY_METHOD_FUNC(gdip_pipeline_result_ok_p), 0);
+}
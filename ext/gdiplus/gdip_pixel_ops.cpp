@@ -0,0 +1,477 @@
+/*
+ * gdip_pixel_ops.cpp
+ * Copyright (c) 2017 Yagi Sumiya
+ * Released under the MIT License.
+ */
+#include "ruby_gdiplus.h"
+#include <math.h>
+
+/*
+ * Per-pixel kernels over 32bpp ARGB scanlines (bytes B, G, R, A).
+ * The vector paths are chosen at compile time: AVX2 when the extension is
+ * built with --enable-avx2, SSE2 on every x64 build, and scalar otherwise.
+ */
+#if defined(__AVX2__)
+#define GDIP_PIXEL_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GDIP_PIXEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+static const UINT32 AlphaMask = 0xff000000U;
+
+static inline UINT32
+gray_pixel(UINT32 c)
+{
+    UINT32 b = c & 0xff;
+    UINT32 g = (c >> 8) & 0xff;
+    UINT32 r = (c >> 16) & 0xff;
+    UINT32 y = (77 * r + 150 * g + 29 * b + 128) >> 8;
+    return (c & AlphaMask) | (y << 16) | (y << 8) | y;
+}
+
+/* y = (77R + 150G + 29B + 128) / 256; every product and the sum fit in the low 16 bits of each lane. */
+static void
+kernel_grayscale(UINT32 *px, UINT n)
+{
+    UINT i = 0;
+#if GDIP_PIXEL_AVX2
+    {
+        const __m256i lo8 = _mm256_set1_epi32(0xff);
+        const __m256i alpha = _mm256_set1_epi32(static_cast<int>(AlphaMask));
+        const __m256i kb = _mm256_set1_epi32(29);
+        const __m256i kg = _mm256_set1_epi32(150);
+        const __m256i kr = _mm256_set1_epi32(77);
+        const __m256i half = _mm256_set1_epi32(128);
+        for (; i + 8 <= n; i += 8) {
+            __m256i p = _mm256_loadu_si256(reinterpret_cast<__m256i *>(px + i));
+            __m256i b = _mm256_and_si256(p, lo8);
+            __m256i g = _mm256_and_si256(_mm256_srli_epi32(p, 8), lo8);
+            __m256i r = _mm256_and_si256(_mm256_srli_epi32(p, 16), lo8);
+            __m256i y = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi16(b, kb), _mm256_mullo_epi16(g, kg)),
+                                         _mm256_add_epi32(_mm256_mullo_epi16(r, kr), half));
+            y = _mm256_srli_epi32(y, 8);
+            y = _mm256_or_si256(_mm256_or_si256(y, _mm256_slli_epi32(y, 8)), _mm256_slli_epi32(y, 16));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(px + i), _mm256_or_si256(_mm256_and_si256(p, alpha), y));
+        }
+    }
+#endif
+#if GDIP_PIXEL_SSE2
+    {
+        const __m128i lo8 = _mm_set1_epi32(0xff);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(AlphaMask));
+        const __m128i kb = _mm_set1_epi32(29);
+        const __m128i kg = _mm_set1_epi32(150);
+        const __m128i kr = _mm_set1_epi32(77);
+        const __m128i half = _mm_set1_epi32(128);
+        for (; i + 4 <= n; i += 4) {
+            __m128i p = _mm_loadu_si128(reinterpret_cast<__m128i *>(px + i));
+            __m128i b = _mm_and_si128(p, lo8);
+            __m128i g = _mm_and_si128(_mm_srli_epi32(p, 8), lo8);
+            __m128i r = _mm_and_si128(_mm_srli_epi32(p, 16), lo8);
+            __m128i y = _mm_add_epi32(_mm_add_epi32(_mm_mullo_epi16(b, kb), _mm_mullo_epi16(g, kg)),
+                                      _mm_add_epi32(_mm_mullo_epi16(r, kr), half));
+            y = _mm_srli_epi32(y, 8);
+            y = _mm_or_si128(_mm_or_si128(y, _mm_slli_epi32(y, 8)), _mm_slli_epi32(y, 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(px + i), _mm_or_si128(_mm_and_si128(p, alpha), y));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        px[i] = gray_pixel(px[i]);
+    }
+}
+
+/* Each color component greater than +t+ becomes 255, the others 0. */
+static void
+kernel_threshold(UINT32 *px, UINT n, BYTE t)
+{
+    UINT i = 0;
+#if GDIP_PIXEL_AVX2
+    {
+        const __m256i sign = _mm256_set1_epi8(static_cast<char>(0x80));
+        const __m256i limit = _mm256_set1_epi8(static_cast<char>(t ^ 0x80));
+        const __m256i alpha = _mm256_set1_epi32(static_cast<int>(AlphaMask));
+        for (; i + 8 <= n; i += 8) {
+            __m256i p = _mm256_loadu_si256(reinterpret_cast<__m256i *>(px + i));
+            __m256i gt = _mm256_cmpgt_epi8(_mm256_xor_si256(p, sign), limit);
+            __m256i r = _mm256_or_si256(_mm256_andnot_si256(alpha, gt), _mm256_and_si256(alpha, p));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(px + i), r);
+        }
+    }
+#endif
+#if GDIP_PIXEL_SSE2
+    {
+        const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(t ^ 0x80));
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(AlphaMask));
+        for (; i + 4 <= n; i += 4) {
+            __m128i p = _mm_loadu_si128(reinterpret_cast<__m128i *>(px + i));
+            __m128i gt = _mm_cmpgt_epi8(_mm_xor_si128(p, sign), limit);
+            __m128i r = _mm_or_si128(_mm_andnot_si128(alpha, gt), _mm_and_si128(alpha, p));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(px + i), r);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        UINT32 c = px[i];
+        UINT32 r = c & AlphaMask;
+        if ((c & 0xff) > t) r |= 0xff;
+        if (((c >> 8) & 0xff) > t) r |= 0xff00;
+        if (((c >> 16) & 0xff) > t) r |= 0xff0000;
+        px[i] = r;
+    }
+}
+
+/* c * a / 255 with rounding, computed as (t + (t >> 8)) >> 8 where t = c * a + 128 */
+static inline UINT32
+mul_div255(UINT32 c, UINT32 a)
+{
+    UINT32 t = c * a + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+static void
+kernel_premultiply(UINT32 *px, UINT n)
+{
+    UINT i = 0;
+#if GDIP_PIXEL_AVX2
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i half = _mm256_set1_epi16(128);
+        const __m256i alpha16 = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+        for (; i + 8 <= n; i += 8) {
+            __m256i p = _mm256_loadu_si256(reinterpret_cast<__m256i *>(px + i));
+            __m256i halves[2] = { _mm256_unpacklo_epi8(p, zero), _mm256_unpackhi_epi8(p, zero) };
+            for (int k = 0; k < 2; ++k) {
+                __m256i c = halves[k];
+                __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(c, a), half);
+                t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+                halves[k] = _mm256_or_si256(_mm256_andnot_si256(alpha16, t), _mm256_and_si256(alpha16, c));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(px + i), _mm256_packus_epi16(halves[0], halves[1]));
+        }
+    }
+#endif
+#if GDIP_PIXEL_SSE2
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i half = _mm_set1_epi16(128);
+        const __m128i alpha16 = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        for (; i + 4 <= n; i += 4) {
+            __m128i p = _mm_loadu_si128(reinterpret_cast<__m128i *>(px + i));
+            __m128i halves[2] = { _mm_unpacklo_epi8(p, zero), _mm_unpackhi_epi8(p, zero) };
+            for (int k = 0; k < 2; ++k) {
+                __m128i c = halves[k];
+                __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), half);
+                t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+                halves[k] = _mm_or_si128(_mm_andnot_si128(alpha16, t), _mm_and_si128(alpha16, c));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(px + i), _mm_packus_epi16(halves[0], halves[1]));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        UINT32 c = px[i];
+        UINT32 a = c >> 24;
+        px[i] = (c & AlphaMask) | (mul_div255((c >> 16) & 0xff, a) << 16) | (mul_div255((c >> 8) & 0xff, a) << 8) | mul_div255(c & 0xff, a);
+    }
+}
+
+/* Applies a 256-entry table to B, G and R. */
+static void
+kernel_lut(UINT32 *px, UINT n, const BYTE *lut)
+{
+    for (UINT i = 0; i < n; ++i) {
+        UINT32 c = px[i];
+        px[i] = (c & AlphaMask) | (lut[(c >> 16) & 0xff] << 16) | (lut[(c >> 8) & 0xff] << 8) | lut[c & 0xff];
+    }
+}
+
+struct RemapEntry {
+    UINT32 from;
+    UINT32 to;
+};
+
+static void
+kernel_remap(UINT32 *px, UINT n, const RemapEntry *table, int count)
+{
+    UINT32 last_from = 0;
+    UINT32 last_to = 0;
+    bool cached = false;
+    for (UINT i = 0; i < n; ++i) {
+        UINT32 c = px[i];
+        if (cached && c == last_from) {
+            px[i] = last_to;
+            continue;
+        }
+        int lo = 0;
+        int hi = count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (table[mid].from < c) lo = mid + 1;
+            else hi = mid;
+        }
+        last_from = c;
+        last_to = (lo < count && table[lo].from == c) ? table[lo].to : c;
+        cached = true;
+        px[i] = last_to;
+    }
+}
+
+/*
+ * The rows of a ColorMatrix rearranged into the B, G, R, A order of a pixel.
+ * rows[k] holds the contribution of input channel k (B, G, R, A) to each output channel,
+ * bias is the fifth row scaled to 0-255.
+ */
+struct PixelMatrix {
+    float rows[4][4];
+    float bias[4];
+};
+
+static inline BYTE
+clamp_byte(float v)
+{
+    if (v <= 0.0f) return 0;
+    if (v >= 255.0f) return 255;
+    return static_cast<BYTE>(lrintf(v));
+}
+
+static void
+kernel_color_matrix(UINT32 *px, UINT n, const PixelMatrix& m)
+{
+    UINT i = 0;
+#if GDIP_PIXEL_SSE2
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 rb = _mm_loadu_ps(m.rows[0]);
+        const __m128 rg = _mm_loadu_ps(m.rows[1]);
+        const __m128 rr = _mm_loadu_ps(m.rows[2]);
+        const __m128 ra = _mm_loadu_ps(m.rows[3]);
+        const __m128 bias = _mm_loadu_ps(m.bias);
+        const __m128 fmin = _mm_setzero_ps();
+        const __m128 fmax = _mm_set1_ps(255.0f);
+        for (; i + 4 <= n; i += 4) {
+            __m128i p = _mm_loadu_si128(reinterpret_cast<__m128i *>(px + i));
+            __m128i p16[2] = { _mm_unpacklo_epi8(p, zero), _mm_unpackhi_epi8(p, zero) };
+            __m128i out[4];
+            for (int k = 0; k < 4; ++k) {
+                __m128i c32 = (k & 1) ? _mm_unpackhi_epi16(p16[k >> 1], zero) : _mm_unpacklo_epi16(p16[k >> 1], zero);
+                __m128 c = _mm_cvtepi32_ps(c32);
+                __m128 v = _mm_add_ps(bias, _mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)), rb));
+                v = _mm_add_ps(v, _mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)), rg));
+                v = _mm_add_ps(v, _mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)), rr));
+                v = _mm_add_ps(v, _mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3)), ra));
+                out[k] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, fmin), fmax));
+            }
+            __m128i lo = _mm_packs_epi32(out[0], out[1]);
+            __m128i hi = _mm_packs_epi32(out[2], out[3]);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(px + i), _mm_packus_epi16(lo, hi));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        UINT32 c = px[i];
+        float in[4] = {
+            static_cast<float>(c & 0xff), static_cast<float>((c >> 8) & 0xff),
+            static_cast<float>((c >> 16) & 0xff), static_cast<float>(c >> 24) };
+        UINT32 r = 0;
+        for (int ch = 0; ch < 4; ++ch) {
+            float v = m.bias[ch] + in[0] * m.rows[0][ch] + in[1] * m.rows[1][ch] + in[2] * m.rows[2][ch] + in[3] * m.rows[3][ch];
+            r |= static_cast<UINT32>(clamp_byte(v)) << (8 * ch);
+        }
+        px[i] = r;
+    }
+}
+
+/*
+ * Locks the whole bitmap as 32bpp ARGB and runs +kernel+ on each scanline
+ * without the GVL. A scanline narrower than the vector width runs only the
+ * scalar loop, which the tests use to check the vector paths against it.
+ */
+template<typename F>
+static void
+gdip_bitmap_pixel_op(VALUE self, F kernel)
+{
+    Bitmap *bmp = Data_Ptr<Bitmap *>(self);
+    Check_NULL(bmp, "The Bitmap object does not exist.");
+
+    Status status = gdip_call_without_gvl([&]() -> Status {
+        Rect rect(0, 0, bmp->GetWidth(), bmp->GetHeight());
+        BitmapData data;
+        Status st = bmp->LockBits(&rect, ImageLockModeRead | ImageLockModeWrite, PixelFormat32bppARGB, &data);
+        if (st != Ok) return st;
+        BYTE *row = static_cast<BYTE *>(data.Scan0);
+        for (UINT y = 0; y < data.Height; ++y) {
+            kernel(reinterpret_cast<UINT32 *>(row), data.Width);
+            row += data.Stride;
+        }
+        return bmp->UnlockBits(&data);
+    }, bmp);
+    Check_Status(status);
+}
+
+/**
+ * Converts the pixels to grayscale in place, with the weights 0.299, 0.587 and 0.114.
+ * @return [self]
+ */
+static VALUE
+gdip_bitmap_grayscale_bang(VALUE self)
+{
+    Check_Frozen(self);
+    gdip_bitmap_pixel_op(self, [](UINT32 *px, UINT n) { kernel_grayscale(px, n); });
+    return self;
+}
+
+/**
+ * Sets each color component to 255 if it is greater than the threshold, otherwise to 0.
+ * The same as ImageAttributes#SetThreshold.
+ * @param threshold [Float] 0.0-1.0
+ * @return [self]
+ */
+static VALUE
+gdip_bitmap_threshold_bang(VALUE self, VALUE v_threshold)
+{
+    Check_Frozen(self);
+    float threshold = 0.5f;
+    gdip_arg_to_single(v_threshold, &threshold, "The argument should be Float.");
+    BYTE t = static_cast<BYTE>(clamp(threshold, 0.0f, 1.0f) * 255.0f);
+    gdip_bitmap_pixel_op(self, [t](UINT32 *px, UINT n) { kernel_threshold(px, n, t); });
+    return self;
+}
+
+/**
+ * Applies the gamma to the color components. The same as ImageAttributes#SetGamma.
+ * @param gamma [Float]
+ * @return [self]
+ */
+static VALUE
+gdip_bitmap_gamma_bang(VALUE self, VALUE v_gamma)
+{
+    Check_Frozen(self);
+    float gamma = 1.0f;
+    gdip_arg_to_single(v_gamma, &gamma, "The argument should be Float.");
+    if (gamma <= 0.0f) {
+        rb_raise(rb_eArgError, "The gamma should be greater than 0.");
+    }
+    BYTE lut[256];
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = clamp_byte(255.0f * powf(i / 255.0f, gamma));
+    }
+    gdip_bitmap_pixel_op(self, [&lut](UINT32 *px, UINT n) { kernel_lut(px, n, lut); });
+    return self;
+}
+
+/**
+ * Multiplies the color components by the alpha.
+ * The bitmap keeps the format 32bpp ARGB; use this to export premultiplied pixels.
+ * @return [self]
+ */
+static VALUE
+gdip_bitmap_premultiply_bang(VALUE self)
+{
+    Check_Frozen(self);
+    gdip_bitmap_pixel_op(self, [](UINT32 *px, UINT n) { kernel_premultiply(px, n); });
+    return self;
+}
+
+static int
+remap_entry_cmp(const void *a, const void *b)
+{
+    UINT32 x = static_cast<const RemapEntry *>(a)->from;
+    UINT32 y = static_cast<const RemapEntry *>(b)->from;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/**
+ * Replaces the colors exactly. The same as ImageAttributes#SetRemapTable.
+ * @param color_map [Hash] old Color => new Color
+ * @return [self]
+ */
+static VALUE
+gdip_bitmap_remap_bang(VALUE self, VALUE color_map)
+{
+    Check_Frozen(self);
+    if (!_RB_HASH_P(color_map)) {
+        rb_raise(rb_eTypeError, "The argument should be Hash.");
+    }
+    long size = RHASH_SIZE(color_map);
+    VALUE tmp = Qnil;
+    RemapEntry *table = static_cast<RemapEntry *>(_rb_alloc_tmp_buffer(&tmp, (size > 0 ? size : 1) * sizeof(RemapEntry)));
+    int count = 0;
+    bool valid = true;
+    _rb_hash_foreach(color_map, [&](VALUE key, VALUE val) -> int {
+        Color old_color;
+        Color new_color;
+        if (count >= size) return ST_STOP;
+        if (!gdip_arg_to_color(key, &old_color, NULL, ArgOptionAcceptInt) ||
+            !gdip_arg_to_color(val, &new_color, NULL, ArgOptionAcceptInt)) {
+            valid = false;
+            return ST_STOP;
+        }
+        table[count].from = old_color.GetValue();
+        table[count].to = new_color.GetValue();
+        count += 1;
+        return ST_CONTINUE;
+    });
+    if (!valid || count == 0) {
+        _rb_free_tmp_buffer(&tmp);
+        rb_raise(rb_eTypeError, "The key and value of Hash should be Color.");
+    }
+    qsort(table, count, sizeof(RemapEntry), remap_entry_cmp);
+    gdip_bitmap_pixel_op(self, [table, count](UINT32 *px, UINT n) { kernel_remap(px, n, table, count); });
+    _rb_free_tmp_buffer(&tmp);
+    return self;
+}
+
+/**
+ * Applies the color matrix to the pixels. The same as ImageAttributes#SetColorMatrix.
+ * @param color_matrix [ColorMatrix]
+ * @return [self]
+ */
+static VALUE
+gdip_bitmap_apply_color_matrix_bang(VALUE self, VALUE v_matrix)
+{
+    Check_Frozen(self);
+    if (!_KIND_OF(v_matrix, &tColorMatrix)) {
+        rb_raise(rb_eTypeError, "The argument should be ColorMatrix.");
+    }
+    ColorMatrix *cm = Data_Ptr<ColorMatrix *>(v_matrix);
+    /* ColorMatrix rows and columns are in R, G, B, A order */
+    static const int order[4] = { 2, 1, 0, 3 };
+    PixelMatrix m;
+    for (int in = 0; in < 4; ++in) {
+        for (int out = 0; out < 4; ++out) {
+            m.rows[in][out] = cm->m[order[in]][order[out]];
+        }
+    }
+    for (int out = 0; out < 4; ++out) {
+        m.bias[out] = cm->m[4][order[out]] * 255.0f;
+    }
+    gdip_bitmap_pixel_op(self, [&m](UINT32 *px, UINT n) { kernel_color_matrix(px, n, m); });
+    return self;
+}
+
+void
+Init_pixel_ops()
+{
+#if GDIP_PIXEL_AVX2
+    const char *simd = "avx2";
+#elif GDIP_PIXEL_SSE2
+    const char *simd = "sse2";
+#else
+    const char *simd = "scalar";
+#endif
+    rb_define_const(cBitmap, "PixelKernels", rb_obj_freeze(rb_str_new_cstr(simd)));
+
+    rb_define_method(cBitmap, "apply_color_matrix!", RUBY_METHOD_FUNC(gdip_bitmap_apply_color_matrix_bang), 1);
+    rb_define_method(cBitmap, "gamma!", RUBY_METHOD_FUNC(gdip_bitmap_gamma_bang), 1);
+    rb_define_method(cBitmap, "threshold!", RUBY_METHOD_FUNC(gdip_bitmap_threshold_bang), 1);
+    rb_define_method(cBitmap, "remap!", RUBY_METHOD_FUNC(gdip_bitmap_remap_bang), 1);
+    rb_define_method(cBitmap, "premultiply!", RUBY_METHOD_FUNC(gdip_bitmap_premultiply_bang), 0);
+    rb_define_method(cBitmap, "grayscale!", RUBY_METHOD_FUNC(gdip_bitmap_grayscale_bang), 0);
+}
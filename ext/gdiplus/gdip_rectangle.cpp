@@ -5,23 +5,25 @@
  */
 #include "ruby_gdiplus.h"
 
-const rb_data_type_t tPoint = _MAKE_DATA_TYPE(
-    "Point", 0, GDIP_DEFAULT_FREE(Point), &typeddata_size<Point>, NULL, &cPoint);
+/* The value types are embedded in their objects on Ruby 3.3+, see _MAKE_DATA_TYPE_EMBEDDABLE. */
 
-const rb_data_type_t tPointF = _MAKE_DATA_TYPE(
-    "PointF", 0, GDIP_DEFAULT_FREE(PointF), &typeddata_size<PointF>, NULL, &cPointF);
+const rb_data_type_t tPoint = _MAKE_DATA_TYPE_EMBEDDABLE(
+    "Point", &typeddata_size<Point>, &cPoint);
 
-const rb_data_type_t tSize = _MAKE_DATA_TYPE(
-    "Size", 0, GDIP_DEFAULT_FREE(Size), &typeddata_size<Size>, NULL, &cSize);
+const rb_data_type_t tPointF = _MAKE_DATA_TYPE_EMBEDDABLE(
+    "PointF", &typeddata_size<PointF>, &cPointF);
 
-const rb_data_type_t tSizeF = _MAKE_DATA_TYPE(
-    "SizeF", 0, GDIP_DEFAULT_FREE(SizeF), &typeddata_size<SizeF>, NULL, &cSizeF);
+const rb_data_type_t tSize = _MAKE_DATA_TYPE_EMBEDDABLE(
+    "Size", &typeddata_size<Size>, &cSize);
 
-const rb_data_type_t tRectangle = _MAKE_DATA_TYPE(
-    "Rectangle", 0, GDIP_DEFAULT_FREE(Rect), &typeddata_size<Rect>, NULL, &cRectangle);
+const rb_data_type_t tSizeF = _MAKE_DATA_TYPE_EMBEDDABLE(
+    "SizeF", &typeddata_size<SizeF>, &cSizeF);
 
-const rb_data_type_t tRectangleF = _MAKE_DATA_TYPE(
-    "RectangleF", 0, GDIP_DEFAULT_FREE(RectF), &typeddata_size<RectF>, NULL, &cRectangleF);
+const rb_data_type_t tRectangle = _MAKE_DATA_TYPE_EMBEDDABLE(
+    "Rectangle", &typeddata_size<Rect>, &cRectangle);
+
+const rb_data_type_t tRectangleF = _MAKE_DATA_TYPE_EMBEDDABLE(
+    "RectangleF", &typeddata_size<RectF>, &cRectangleF);
 
 
 VALUE
@@ -6,7 +6,7 @@
 #include "ruby_gdiplus.h"
 
 const rb_data_type_t tRegion = _MAKE_DATA_TYPE(
-    "Region", 0, GDIP_OBJ_FREE(Region *), NULL, NULL, &cRegion);
+    "Region", 0, GDIP_OBJ_FREE(Region *), GDIP_OBJ_MEMSIZE(Region *), NULL, &cRegion);
 
 struct RegionData {
     BYTE *data;
@@ -21,9 +21,16 @@ gdip_regiondata_free(RegionData *ptr)
     ruby_xfree(ptr);
 }
 
+static size_t
+gdip_regiondata_memsize(const void *ptr)
+{
+    const RegionData *data = static_cast<const RegionData *>(ptr);
+    return sizeof(RegionData) + data->count;
+}
+
 static VALUE cRegionData;
 static const rb_data_type_t tRegionData = _MAKE_DATA_TYPE(
-    "RegionData", 0, RUBY_DATA_FUNC(gdip_regiondata_free), NULL, NULL, &cRegionData);
+    "RegionData", 0, RUBY_DATA_FUNC(gdip_regiondata_free), gdip_regiondata_memsize, NULL, &cRegionData);
 
 static VALUE
 gdip_regiondata_create(BYTE *data, unsigned int count)
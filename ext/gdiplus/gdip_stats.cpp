@@ -0,0 +1,295 @@
+/*
+ * gdip_stats.cpp
+ * Copyright (c) 2017 Yagi Sumiya
+ * Released under the MIT License.
+ */
+#include "ruby_gdiplus.h"
+
+bool gdip_stats_enabled = false;
+
+/* Upper bounds of the latency buckets are 1, 2, 4, ... 2**(StatsBuckets - 2) usec; the last one is unbounded. */
+static const int StatsBuckets = 22;
+static const int StatsStatuses = 23; // GpStatusStrs and one for unknown statuses
+
+struct gdipStatsEntry {
+    VALUE klass;      // class of the receiver, or the receiver itself for singleton methods
+    ID mid;
+    bool singleton;
+    unsigned long calls;
+    LONGLONG ticks;
+    unsigned long buckets[StatsBuckets];
+    unsigned long failures[StatsStatuses];
+    gdipStatsEntry *next; // another class with the same method name
+    gdipStatsEntry *all_next;
+};
+
+/* Method ID => gdipStatsEntry list, and all entries in creation order. Only touched with the GVL held. */
+static st_table *stats_table = NULL;
+static gdipStatsEntry *stats_first = NULL;
+static gdipStatsEntry **stats_last = &stats_first;
+static double stats_usec_per_tick = 0.0;
+/* Hidden object that marks the classes of the entries. */
+static VALUE stats_registry = Qnil;
+
+static void
+gdip_stats_registry_mark(void *ptr)
+{
+    for (gdipStatsEntry *entry = stats_first; entry != NULL; entry = entry->all_next) {
+        _rb_gc_mark_movable(entry->klass);
+    }
+}
+
+static void
+gdip_stats_registry_compact(void *ptr)
+{
+    for (gdipStatsEntry *entry = stats_first; entry != NULL; entry = entry->all_next) {
+        entry->klass = _rb_gc_location(entry->klass);
+    }
+}
+
+static const rb_data_type_t tStatsRegistry = _MAKE_DATA_TYPE_MOVABLE(
+    "StatsRegistry", RUBY_DATA_FUNC(gdip_stats_registry_mark), RUBY_NEVER_FREE, NULL,
+    RUBY_DATA_FUNC(gdip_stats_registry_compact), NULL, NULL);
+
+static gdipStatsEntry *
+gdip_stats_entry(VALUE klass, ID mid, bool singleton)
+{
+    st_data_t data = 0;
+    st_lookup(stats_table, static_cast<st_data_t>(mid), &data);
+    gdipStatsEntry *head = reinterpret_cast<gdipStatsEntry *>(data);
+    for (gdipStatsEntry *entry = head; entry != NULL; entry = entry->next) {
+        if (entry->klass == klass && entry->singleton == singleton) return entry;
+    }
+    gdipStatsEntry *entry = RB_ZALLOC(gdipStatsEntry);
+    entry->klass = Qnil;
+    entry->mid = mid;
+    entry->singleton = singleton;
+    entry->next = head;
+    RB_OBJ_WRITE(stats_registry, &entry->klass, klass);
+    st_insert(stats_table, static_cast<st_data_t>(mid), reinterpret_cast<st_data_t>(entry));
+    *stats_last = entry;
+    stats_last = &entry->all_next;
+    return entry;
+}
+
+/*
+ * Counts a native call of the currently running method.
+ * Called with the GVL held, from the C function of the method.
+ */
+void
+gdip_stats_record(LONGLONG ticks, Status status)
+{
+    ID mid = rb_frame_this_func();
+    if (mid == 0) return;
+    VALUE klass = Qnil;
+    bool singleton = false;
+#if RUBY_API_VERSION_CODE >= 20300
+    VALUE recv = rb_current_receiver();
+    singleton = RB_TYPE_P(recv, RUBY_T_CLASS) || RB_TYPE_P(recv, RUBY_T_MODULE);
+    klass = singleton ? recv : rb_obj_class(recv);
+#endif
+    gdipStatsEntry *entry = gdip_stats_entry(klass, mid, singleton);
+    entry->calls += 1;
+    entry->ticks += ticks;
+    double usec = ticks * stats_usec_per_tick;
+    int bucket = 0;
+    for (double bound = 1.0; bucket < StatsBuckets - 1 && usec > bound; bound *= 2.0) {
+        bucket += 1;
+    }
+    entry->buckets[bucket] += 1;
+    if (status != Ok) {
+        entry->failures[static_cast<unsigned int>(status) < StatsStatuses - 1 ? status : StatsStatuses - 1] += 1;
+    }
+}
+
+static VALUE
+gdip_stats_entry_name(gdipStatsEntry *entry)
+{
+    if (RB_NIL_P(entry->klass)) {
+        return rb_str_new_cstr(rb_id2name(entry->mid));
+    }
+    VALUE name = rb_str_dup(rb_class_name(entry->klass));
+    rb_str_cat_cstr(name, entry->singleton ? "." : "#");
+    rb_str_cat_cstr(name, rb_id2name(entry->mid));
+    return name;
+}
+
+static const char *
+gdip_stats_status_name(int idx)
+{
+    return idx < StatsStatuses - 1 ? GpStatusStrs[idx] : "Unknown";
+}
+
+template<typename F>
+static void
+gdip_stats_each(F func)
+{
+    for (gdipStatsEntry *entry = stats_first; entry != NULL; entry = entry->all_next) {
+        if (entry->calls > 0) func(entry);
+    }
+}
+
+/**
+ * Starts counting native calls. Stats are off by default.
+ * @return [nil]
+ */
+static VALUE
+gdip_stats_s_enable(VALUE self)
+{
+    gdip_stats_enabled = true;
+    return Qnil;
+}
+
+/**
+ * Stops counting native calls. The counts so far are kept.
+ * @return [nil]
+ */
+static VALUE
+gdip_stats_s_disable(VALUE self)
+{
+    gdip_stats_enabled = false;
+    return Qnil;
+}
+
+/**
+ * @return [Boolean]
+ */
+static VALUE
+gdip_stats_s_enabled_p(VALUE self)
+{
+    return gdip_stats_enabled ? Qtrue : Qfalse;
+}
+
+/**
+ * Clears all counts.
+ * @return [nil]
+ */
+static VALUE
+gdip_stats_s_reset(VALUE self)
+{
+    gdip_stats_each([](gdipStatsEntry *entry) {
+        entry->calls = 0;
+        entry->ticks = 0;
+        memset(entry->buckets, 0, sizeof(entry->buckets));
+        memset(entry->failures, 0, sizeof(entry->failures));
+    });
+    return Qnil;
+}
+
+/**
+ * Returns the counts by method, e.g. "Gdiplus::Graphics#DrawImage".
+ * +histogram+ has the number of calls in each bucket of {BUCKET_USEC}.
+ * +failures+ has the number of calls by the name of the failed status.
+ * @return [Hash{String => Hash}] {name => {calls: Integer, time: Float (sec), histogram: Array<Integer>, failures: Hash{String => Integer}}}
+ * @example
+ *   Gdiplus::Stats.enable
+ *   bmp.draw {|g| g.DrawImage(img, 0, 0) }
+ *   Gdiplus::Stats.to_h["Gdiplus::Graphics#DrawImage"][:calls] # => 1
+ */
+static VALUE
+gdip_stats_s_to_h(VALUE self)
+{
+    VALUE r = rb_hash_new();
+    VALUE sym_calls = ID2SYM(rb_intern("calls"));
+    VALUE sym_time = ID2SYM(rb_intern("time"));
+    VALUE sym_histogram = ID2SYM(rb_intern("histogram"));
+    VALUE sym_failures = ID2SYM(rb_intern("failures"));
+    gdip_stats_each([&](gdipStatsEntry *entry) {
+        VALUE histogram = rb_ary_new_capa(StatsBuckets);
+        for (int i = 0; i < StatsBuckets; ++i) {
+            rb_ary_push(histogram, RB_ULONG2NUM(entry->buckets[i]));
+        }
+        VALUE failures = rb_hash_new();
+        for (int i = 0; i < StatsStatuses; ++i) {
+            if (entry->failures[i] > 0) {
+                rb_hash_aset(failures, rb_str_new_cstr(gdip_stats_status_name(i)), RB_ULONG2NUM(entry->failures[i]));
+            }
+        }
+        VALUE h = rb_hash_new();
+        rb_hash_aset(h, sym_calls, RB_ULONG2NUM(entry->calls));
+        rb_hash_aset(h, sym_time, DBL2NUM(entry->ticks * stats_usec_per_tick / 1000000.0));
+        rb_hash_aset(h, sym_histogram, histogram);
+        rb_hash_aset(h, sym_failures, failures);
+        rb_hash_aset(r, gdip_stats_entry_name(entry), h);
+    });
+    return r;
+}
+
+/**
+ * Returns the counts in the Prometheus text exposition format:
+ * +gdiplus_call_duration_seconds+ (histogram) and +gdiplus_call_failures_total+ (counter),
+ * labeled with +binding+ and +status+.
+ * @return [String]
+ */
+static VALUE
+gdip_stats_s_to_prometheus(VALUE self)
+{
+    VALUE r = rb_str_new_cstr(
+        "# HELP gdiplus_call_duration_seconds Time spent in GDI+ by binding.\n"
+        "# TYPE gdiplus_call_duration_seconds histogram\n");
+    VALUE failures = rb_str_new_cstr(
+        "# HELP gdiplus_call_failures_total GDI+ calls that returned a status other than Ok.\n"
+        "# TYPE gdiplus_call_failures_total counter\n");
+    gdip_stats_each([&](gdipStatsEntry *entry) {
+        VALUE name = gdip_stats_entry_name(entry);
+        const char *binding = RSTRING_PTR(name);
+        unsigned long cumulative = 0;
+        double bound = 1.0;
+        for (int i = 0; i < StatsBuckets - 1; ++i, bound *= 2.0) {
+            cumulative += entry->buckets[i];
+            rb_str_concat(r, util_utf8_sprintf("gdiplus_call_duration_seconds_bucket{binding=\"%s\",le=\"%g\"} %lu\n",
+                binding, bound / 1000000.0, cumulative));
+        }
+        rb_str_concat(r, util_utf8_sprintf("gdiplus_call_duration_seconds_bucket{binding=\"%s\",le=\"+Inf\"} %lu\n", binding, entry->calls));
+        rb_str_concat(r, util_utf8_sprintf("gdiplus_call_duration_seconds_sum{binding=\"%s\"} %.9f\n",
+            binding, entry->ticks * stats_usec_per_tick / 1000000.0));
+        rb_str_concat(r, util_utf8_sprintf("gdiplus_call_duration_seconds_count{binding=\"%s\"} %lu\n", binding, entry->calls));
+        for (int i = 0; i < StatsStatuses; ++i) {
+            if (entry->failures[i] > 0) {
+                rb_str_concat(failures, util_utf8_sprintf("gdiplus_call_failures_total{binding=\"%s\",status=\"%s\"} %lu\n",
+                    binding, gdip_stats_status_name(i), entry->failures[i]));
+            }
+        }
+        RB_GC_GUARD(name);
+    });
+    rb_str_concat(r, failures);
+    return r;
+}
+
+/*
+Document-module: Gdiplus::Stats
+Call counts, time and failures of the GDI+ calls made by each method.
+Counting is off until {Stats.enable}; while it is off a call only checks a flag.
+Only the calls that take the most time are counted: drawing images and paths,
+loading and saving images, strings, command buffers and pixel operations.
+@example
+  Gdiplus::Stats.enable
+  ...
+  puts Gdiplus::Stats.to_prometheus
+*/
+void
+Init_stats()
+{
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    stats_usec_per_tick = 1000000.0 / static_cast<double>(freq.QuadPart);
+    stats_table = st_init_numtable();
+    stats_registry = _Data_Wrap_Struct(0, &tStatsRegistry, NULL);
+    rb_gc_register_address(&stats_registry);
+
+    VALUE mStats = rb_define_module_under(mGdiplus, "Stats");
+    rb_define_module_function(mStats, "enable", RUBY_METHOD_FUNC(gdip_stats_s_enable), 0);
+    rb_define_module_function(mStats, "disable", RUBY_METHOD_FUNC(gdip_stats_s_disable), 0);
+    rb_define_module_function(mStats, "enabled?", RUBY_METHOD_FUNC(gdip_stats_s_enabled_p), 0);
+    rb_define_module_function(mStats, "reset", RUBY_METHOD_FUNC(gdip_stats_s_reset), 0);
+    rb_define_module_function(mStats, "to_h", RUBY_METHOD_FUNC(gdip_stats_s_to_h), 0);
+    rb_define_module_function(mStats, "to_prometheus", RUBY_METHOD_FUNC(gdip_stats_s_to_prometheus), 0);
+
+    VALUE bounds = rb_ary_new_capa(StatsBuckets);
+    for (int i = 0; i < StatsBuckets - 1; ++i) {
+        rb_ary_push(bounds, RB_INT2NUM(1 << i));
+    }
+    rb_ary_push(bounds, Qnil);
+    /* Upper bounds of the histogram buckets in usec. nil for the last, unbounded one. */
+    rb_define_const(mStats, "BUCKET_USEC", rb_obj_freeze(bounds));
+}
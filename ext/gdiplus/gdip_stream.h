@@ -0,0 +1,262 @@
+/*
+ * gdip_stream.h
+ * Copyright (c) 2017 Yagi Sumiya
+ * Released under the MIT License.
+ */
+#ifndef GDIP_STREAM_H
+#define GDIP_STREAM_H
+
+#include "ruby_gdiplus.h"
+#include <string.h>
+
+/*
+ * IStream over memory that belongs to Ruby.
+ * The read-only stream reads the bytes of a String in place. GDI+ may keep
+ * reading the stream until the Image is deleted, so the caller must keep
+ * the (frozen) String alive as long as the Image. A String whose bytes are
+ * embedded in the object moves with it under GC.compact; copy_of() gives a
+ * stream owning a copy of such bytes.
+ * The writable stream encodes into a String, reusing the capacity it already
+ * has; finish() sets its length to the written size and returns it. The
+ * capacity is kept for a buffer given by the caller, and trimmed otherwise.
+ */
+class MemoryStream : public IStream {
+protected:
+    LONG Ref;
+    BYTE *Data;
+    ULONG Size;
+    ULONG Pos;
+    ULONG Capa;
+    VALUE Str; // Qnil for a read-only stream
+    ULONG NewCapa;
+    bool WithoutGVL;
+    bool Owned; // Data was allocated by copy_of()
+    bool KeepCapa;
+
+    static void *resize_str(void *data) {
+        MemoryStream *stream = static_cast<MemoryStream *>(data);
+        int state = 0;
+        if (stream->WithoutGVL) rb_str_unlocktmp(stream->Str);
+        _rb_protect([&]() -> VALUE { return rb_str_resize(stream->Str, static_cast<long>(stream->NewCapa)); }, &state);
+        if (stream->WithoutGVL) rb_str_locktmp(stream->Str);
+        if (state) {
+            rb_set_errinfo(Qnil);
+            return NULL;
+        }
+        return data;
+    }
+
+    bool reserve(ULONGLONG need) {
+        if (need <= Capa) return true;
+        if (need > 0xffffffffULL) return false;
+        ULONGLONG capa = static_cast<ULONGLONG>(Capa) * 2;
+        if (capa < need) capa = need;
+        if (capa > 0xffffffffULL) capa = 0xffffffffULL;
+        NewCapa = static_cast<ULONG>(capa);
+        void *ok;
+#if RUBY_API_VERSION_CODE >= 20000
+        if (WithoutGVL) {
+            ok = rb_thread_call_with_gvl(resize_str, this);
+        }
+        else
+#endif
+        {
+            ok = resize_str(this);
+        }
+        if (ok == NULL) return false;
+        Data = RString_Ptr<BYTE *>(Str);
+        Capa = NewCapa;
+        return true;
+    }
+public:
+    MemoryStream(const void *data, ULONG size) {
+        dp("MemoryStream(%p, %lu)", data, size);
+        Ref = 1;
+        Data = static_cast<BYTE *>(const_cast<void *>(data));
+        Size = size;
+        Pos = 0;
+        Capa = size;
+        Str = Qnil;
+        NewCapa = 0;
+        WithoutGVL = false;
+        Owned = false;
+        KeepCapa = false;
+    }
+    /* +str+ must be modifiable (rb_str_modify) */
+    explicit MemoryStream(VALUE str, bool keep_capa=false) {
+#if RUBY_API_VERSION_CODE >= 10900
+        long capa = static_cast<long>(rb_str_capacity(str));
+#else
+        long capa = RSTRING_LEN(str);
+#endif
+        if (capa < 0x1000) capa = 0x1000;
+        rb_str_resize(str, capa);
+        dp("MemoryStream(capa=%ld)", capa);
+        Ref = 1;
+        Data = RString_Ptr<BYTE *>(str);
+        Size = 0;
+        Pos = 0;
+        Capa = static_cast<ULONG>(capa);
+        Str = str;
+        NewCapa = 0;
+        WithoutGVL = false;
+        Owned = false;
+        KeepCapa = keep_capa;
+    }
+    virtual ~MemoryStream() {
+        dp("~MemoryStream()");
+        if (Owned) delete[] Data;
+    }
+
+    /* Read-only stream over a copy of +size+ bytes. */
+    static MemoryStream *copy_of(const void *data, ULONG size) {
+        BYTE *copy = new BYTE[size > 0 ? size : 1];
+        memcpy(copy, data, size);
+        MemoryStream *stream = new MemoryStream(copy, size);
+        stream->Owned = true;
+        return stream;
+    }
+
+    /*
+     * Set while GDI+ writes to the stream without the GVL; growing the String then reacquires it.
+     * The String is locked meanwhile (rb_str_locktmp), so that Ruby threads
+     * cannot reallocate it under the encoder.
+     */
+    void set_without_gvl(bool b) {
+        if (b == WithoutGVL || RB_NIL_P(Str)) return;
+        if (b) {
+            rb_str_locktmp(Str);
+        }
+        else {
+            rb_str_unlocktmp(Str);
+        }
+        WithoutGVL = b;
+    }
+
+    /*
+     * Sets the length of the String to the written bytes and returns it.
+     * A caller's buffer keeps its capacity for the next encode; a String made
+     * for this stream is trimmed, since it may be up to twice the size.
+     */
+    VALUE finish() {
+        set_without_gvl(false);
+#if RUBY_API_VERSION_CODE >= 10900
+        if (KeepCapa) {
+            rb_str_set_len(Str, Size);
+            return Str;
+        }
+#endif
+        rb_str_resize(Str, Size);
+        return Str;
+    }
+
+    /* IUnknown */
+    virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppv) {
+        if (ppv == NULL) return E_POINTER;
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(ISequentialStream) || riid == __uuidof(IStream)) {
+            *ppv = static_cast<IStream *>(this);
+            AddRef();
+            return S_OK;
+        }
+        *ppv = NULL;
+        return E_NOINTERFACE;
+    }
+    virtual ULONG STDMETHODCALLTYPE AddRef() {
+        return InterlockedIncrement(&Ref);
+    }
+    virtual ULONG STDMETHODCALLTYPE Release() {
+        LONG ref = InterlockedDecrement(&Ref);
+        if (ref == 0) {
+            delete this;
+        }
+        return ref;
+    }
+
+    /* ISequentialStream */
+    virtual HRESULT STDMETHODCALLTYPE Read(void *pv, ULONG cb, ULONG *pcbRead) {
+        if (pv == NULL) return STG_E_INVALIDPOINTER;
+        ULONG n = Pos < Size ? Size - Pos : 0;
+        if (cb < n) n = cb;
+        memcpy(pv, Data + Pos, n);
+        Pos += n;
+        if (pcbRead) *pcbRead = n;
+        return n < cb ? S_FALSE : S_OK;
+    }
+    virtual HRESULT STDMETHODCALLTYPE Write(const void *pv, ULONG cb, ULONG *pcbWritten) {
+        if (pcbWritten) *pcbWritten = 0;
+        if (RB_NIL_P(Str)) return STG_E_ACCESSDENIED;
+        if (pv == NULL) return STG_E_INVALIDPOINTER;
+        ULONGLONG end = static_cast<ULONGLONG>(Pos) + cb;
+        if (!reserve(end)) return STG_E_MEDIUMFULL;
+        if (Pos > Size) {
+            memset(Data + Size, 0, Pos - Size);
+        }
+        memcpy(Data + Pos, pv, cb);
+        Pos = static_cast<ULONG>(end);
+        if (Pos > Size) Size = Pos;
+        if (pcbWritten) *pcbWritten = cb;
+        return S_OK;
+    }
+
+    /* IStream */
+    virtual HRESULT STDMETHODCALLTYPE Seek(LARGE_INTEGER dlibMove, DWORD dwOrigin, ULARGE_INTEGER *plibNewPosition) {
+        LONGLONG base;
+        switch (dwOrigin) {
+            case STREAM_SEEK_SET: base = 0; break;
+            case STREAM_SEEK_CUR: base = Pos; break;
+            case STREAM_SEEK_END: base = Size; break;
+            default: return STG_E_INVALIDFUNCTION;
+        }
+        LONGLONG pos = base + dlibMove.QuadPart;
+        if (pos < 0 || pos > 0xffffffffLL) return STG_E_INVALIDFUNCTION;
+        Pos = static_cast<ULONG>(pos);
+        if (plibNewPosition) plibNewPosition->QuadPart = Pos;
+        return S_OK;
+    }
+    virtual HRESULT STDMETHODCALLTYPE SetSize(ULARGE_INTEGER libNewSize) {
+        if (RB_NIL_P(Str)) return STG_E_ACCESSDENIED;
+        if (!reserve(libNewSize.QuadPart)) return STG_E_MEDIUMFULL;
+        ULONG size = static_cast<ULONG>(libNewSize.QuadPart);
+        if (size > Size) {
+            memset(Data + Size, 0, size - Size);
+        }
+        Size = size;
+        return S_OK;
+    }
+    virtual HRESULT STDMETHODCALLTYPE CopyTo(IStream *pstm, ULARGE_INTEGER cb, ULARGE_INTEGER *pcbRead, ULARGE_INTEGER *pcbWritten) {
+        if (pstm == NULL) return STG_E_INVALIDPOINTER;
+        ULONG n = Pos < Size ? Size - Pos : 0;
+        if (cb.QuadPart < n) n = static_cast<ULONG>(cb.QuadPart);
+        ULONG written = 0;
+        HRESULT hr = pstm->Write(Data + Pos, n, &written);
+        Pos += n;
+        if (pcbRead) pcbRead->QuadPart = n;
+        if (pcbWritten) pcbWritten->QuadPart = written;
+        return hr;
+    }
+    virtual HRESULT STDMETHODCALLTYPE Commit(DWORD grfCommitFlags) { return S_OK; }
+    virtual HRESULT STDMETHODCALLTYPE Revert() { return S_OK; }
+    virtual HRESULT STDMETHODCALLTYPE LockRegion(ULARGE_INTEGER libOffset, ULARGE_INTEGER cb, DWORD dwLockType) {
+        return STG_E_INVALIDFUNCTION;
+    }
+    virtual HRESULT STDMETHODCALLTYPE UnlockRegion(ULARGE_INTEGER libOffset, ULARGE_INTEGER cb, DWORD dwLockType) {
+        return STG_E_INVALIDFUNCTION;
+    }
+    virtual HRESULT STDMETHODCALLTYPE Stat(STATSTG *pstatstg, DWORD grfStatFlag) {
+        if (pstatstg == NULL) return STG_E_INVALIDPOINTER;
+        memset(pstatstg, 0, sizeof(STATSTG));
+        pstatstg->type = STGTY_STREAM;
+        pstatstg->cbSize.QuadPart = Size;
+        return S_OK;
+    }
+    virtual HRESULT STDMETHODCALLTYPE Clone(IStream **ppstm) {
+        if (ppstm == NULL) return STG_E_INVALIDPOINTER;
+        if (!RB_NIL_P(Str)) return STG_E_INVALIDFUNCTION;
+        MemoryStream *stream = Owned ? copy_of(Data, Size) : new MemoryStream(Data, Size);
+        stream->Pos = Pos;
+        *ppstm = stream;
+        return S_OK;
+    }
+};
+
+#endif /* GDIP_STREAM_H */
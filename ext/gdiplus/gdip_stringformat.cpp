@@ -7,7 +7,7 @@
 
 
 const rb_data_type_t tStringFormat = _MAKE_DATA_TYPE(
-    "StringFormat", 0, GDIP_OBJ_FREE(StringFormat *), NULL, NULL, &cStringFormat);
+    "StringFormat", 0, GDIP_OBJ_FREE(StringFormat *), GDIP_OBJ_MEMSIZE(StringFormat *), NULL, &cStringFormat);
 
 
 /**
@@ -27,6 +27,15 @@ util_associate_utf8(VALUE str)
     return str;
 }
 
+VALUE
+util_associate_binary(VALUE str)
+{
+    #ifdef HAVE_RUBY_ENCODING_H
+    str = rb_enc_associate_index(str, rb_ascii8bit_encindex());
+    #endif
+    return str;
+}
+
 VALUE
 util_utf8_sprintf(const char* format, ...)
 {
@@ -7,6 +7,7 @@
 
 VALUE mGdiplus;
 VALUE mInternals;
+VALUE mPipeline;
 VALUE cGpObject;
 VALUE eGdiplus;
 
@@ -14,6 +15,7 @@ VALUE cGuid;
 VALUE cImageCodecInfo;
 VALUE cImage;
 VALUE cBitmap;
+VALUE cBitmapData;
 VALUE cPixelFormat;
 VALUE cEncoderParameterValueType;
 VALUE cBrushType;
@@ -53,6 +55,7 @@ VALUE cWrapMode;
 VALUE cColorAdjustType;
 VALUE cColorChannelFlag;
 VALUE cColorMatrixFlag;
+VALUE cImageLockMode;
 
 VALUE cEncoder;
 VALUE cEncoderValue;
@@ -83,9 +86,14 @@ VALUE cGraphicsPath;
 VALUE cMatrix;
 VALUE cRegion;
 VALUE cImageAttributes;
+VALUE cCommandBuffer;
+VALUE cPointFArray;
+VALUE cRectFArray;
+VALUE cColorMatrix;
 
 int gdip_refcount = 0;
 bool gdip_end_flag = false;
+bool gdip_started = false;
 static ULONG_PTR gdiplus_token = 0;
 
 const char *GpStatusStrs[22] = {
@@ -144,6 +152,124 @@ class LastCheck {
 static LastCheck lastcheck;
 #endif
 
+#if GDIPLUS_TRACE
+bool gdip_trace_enabled = false;
+
+static const char *TraceEventStrs[] = {
+    "alloc", "null", "free", "new", "delete", "map new", "map delete"
+};
+
+void
+gdip_trace(TraceEvent event, const char *name, const void *ptr)
+{
+    char buf[128] = {0};
+    _snprintf(buf, 127, "<%s> %s %p", name, TraceEventStrs[event], ptr);
+    OutputDebugString(buf);
+}
+#endif
+
+/**
+ * Turns the trace points on object churn on or off. They are reported with
+ * OutputDebugString (see DebugView). Only extensions built with +--enable-trace+
+ * or +--enable-debug+ have them; otherwise this does nothing and {trace?} stays false.
+ * @param enabled [Boolean]
+ * @return [Boolean]
+ */
+static VALUE
+gdiplus_s_set_trace(VALUE self, VALUE enabled)
+{
+#if GDIPLUS_TRACE
+    gdip_trace_enabled = RB_TEST(enabled);
+#else
+    if (RB_TEST(enabled)) {
+        _WARNING("Gdiplus is built without trace points. (extconf.rb --enable-trace)");
+    }
+#endif
+    return enabled;
+}
+
+/**
+ * @return [Boolean] whether the trace points are on.
+ */
+static VALUE
+gdiplus_s_get_trace(VALUE self)
+{
+#if GDIPLUS_TRACE
+    return gdip_trace_enabled ? Qtrue : Qfalse;
+#else
+    return Qfalse;
+#endif
+}
+
+/*
+ * Time and allocated objects of each Init_* at load time, and of GdiplusStartup
+ * when the first GDI+ object is created. See Gdiplus.init_profile.
+ */
+struct InitProfileEntry {
+    const char *name;
+    LONGLONG ticks;
+    size_t objects;
+};
+static InitProfileEntry init_profile[24];
+static int init_profile_len = 0;
+
+static inline size_t
+init_profile_allocated()
+{
+#if RUBY_API_VERSION_CODE >= 20100
+    static VALUE key = Qnil;
+    if (RB_NIL_P(key)) key = ID2SYM(rb_intern("total_allocated_objects"));
+    return rb_gc_stat(key);
+#else
+    return 0;
+#endif
+}
+
+template<typename F>
+static void
+init_profile_run(const char *name, F func)
+{
+    LARGE_INTEGER t0, t1;
+    size_t n0 = init_profile_allocated();
+    QueryPerformanceCounter(&t0);
+    func();
+    QueryPerformanceCounter(&t1);
+    if (init_profile_len < static_cast<int>(sizeof(init_profile) / sizeof(InitProfileEntry))) {
+        InitProfileEntry *entry = &init_profile[init_profile_len];
+        entry->name = name;
+        entry->ticks = t1.QuadPart - t0.QuadPart;
+        entry->objects = init_profile_allocated() - n0;
+        init_profile_len += 1;
+    }
+}
+#define INIT_PROFILE(func) init_profile_run(#func, func)
+
+/**
+ * Returns how long each part of loading the extension took.
+ * GdiplusStartup is listed once the first GDI+ object has been created.
+ * @return [Hash{String => Hash}] {"Init_codec" => {usec: Float, objects: Integer}, ...} in call order.
+ *   +objects+ is always 0 before Ruby 2.1.
+ * @example
+ *   Gdiplus.init_profile.each {|name, prof| printf("%-20s %8.1f us %6d\n", name, prof[:usec], prof[:objects]) }
+ */
+static VALUE
+gdiplus_s_init_profile(VALUE self)
+{
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    double unit = 1000000.0 / static_cast<double>(freq.QuadPart);
+    VALUE sym_usec = ID2SYM(rb_intern("usec"));
+    VALUE sym_objects = ID2SYM(rb_intern("objects"));
+    VALUE r = rb_hash_new();
+    for (int i = 0; i < init_profile_len; ++i) {
+        VALUE prof = rb_hash_new();
+        rb_hash_aset(prof, sym_usec, DBL2NUM(init_profile[i].ticks * unit));
+        rb_hash_aset(prof, sym_objects, RB_ULONG2NUM(static_cast<unsigned long>(init_profile[i].objects)));
+        rb_hash_aset(r, rb_str_new_cstr(init_profile[i].name), prof);
+    }
+    return r;
+}
+
 static void
 gdiplus_init()
 {
@@ -155,10 +281,22 @@ gdiplus_init()
     }
 }
 
+/*
+ * GDI+ is started when the first GDI+ object is created, not at require time,
+ * so that a process which never draws (or a parent before fork) does not pay for it.
+ */
+void
+gdiplus_startup()
+{
+    if (gdip_started) return;
+    init_profile_run("GdiplusStartup", gdiplus_init);
+    gdip_started = true;
+}
+
 void
 gdiplus_shutdown(){
     dp("%s (gdip_refcount: %d)", __FUNCTION__, gdip_refcount);
-    if (gdip_end_flag && gdip_refcount == 0) {
+    if (gdip_started && gdip_end_flag && gdip_refcount == 0) {
         dp("GdiplusShutdown");
         GdiplusShutdown(gdiplus_token);
     }
@@ -171,6 +309,152 @@ gdiplus_end(VALUE self)
     gdiplus_shutdown();
 }
 
+/*
+ * GDI+ objects used by a call running without the GVL (see gdip_call_without_gvl).
+ * Only touched with the GVL held.
+ */
+static void **busy_objs = NULL;
+static int busy_len = 0;
+static int busy_capa = 0;
+
+bool
+gdip_busy_p(void *obj)
+{
+    if (obj == NULL) return false;
+    for (int i = 0; i < busy_len; ++i) {
+        if (busy_objs[i] == obj) return true;
+    }
+    return false;
+}
+
+static void
+gdip_busy_add(void *obj)
+{
+    if (obj == NULL) return;
+    if (busy_len == busy_capa) {
+        busy_capa = busy_capa == 0 ? 16 : busy_capa * 2;
+        busy_objs = static_cast<void **>(ruby_xrealloc(busy_objs, busy_capa * sizeof(void *)));
+    }
+    busy_objs[busy_len] = obj;
+    busy_len += 1;
+}
+
+static void
+gdip_busy_remove(void *obj)
+{
+    if (obj == NULL) return;
+    for (int i = 0; i < busy_len; ++i) {
+        if (busy_objs[i] == obj) {
+            busy_objs[i] = busy_objs[busy_len - 1];
+            busy_len -= 1;
+            return;
+        }
+    }
+}
+
+/*
+ * Marks +objs+ busy, or raises if one of them already is.
+ * NULLs and repeated objects are allowed.
+ */
+void
+gdip_busy_enter_all(void **objs, long count)
+{
+    for (long i = 0; i < count; ++i) {
+        if (gdip_busy_p(objs[i])) {
+            rb_raise(eGdiplus, "The object is being used by another thread.");
+        }
+    }
+    for (long i = 0; i < count; ++i) {
+        if (!gdip_busy_p(objs[i])) gdip_busy_add(objs[i]);
+    }
+}
+
+void
+gdip_busy_leave_all(void **objs, long count)
+{
+    for (long i = 0; i < count; ++i) {
+        gdip_busy_remove(objs[i]);
+    }
+}
+
+void
+gdip_busy_enter(void *obj1, void *obj2, void *obj3, void *obj4)
+{
+    void *objs[] = {obj1, obj2, obj3, obj4};
+    gdip_busy_enter_all(objs, 4);
+}
+
+void
+gdip_busy_leave(void *obj1, void *obj2, void *obj3, void *obj4)
+{
+    void *objs[] = {obj1, obj2, obj3, obj4};
+    gdip_busy_leave_all(objs, 4);
+}
+
+/*
+ * Native objects that use another one for their whole lifetime: a Graphics
+ * drawing on an Image, a BitmapData locking a Bitmap. The used object cannot
+ * be disposed while it has users. Only touched with the GVL held.
+ */
+struct gdipUse {
+    void *user;
+    void *obj;
+};
+static gdipUse *uses = NULL;
+static int uses_capa = 0;
+int gdip_uses_len = 0;
+
+void
+gdip_use_attach(void *user, void *obj)
+{
+    if (gdip_uses_len == uses_capa) {
+        uses_capa = uses_capa == 0 ? 16 : uses_capa * 2;
+        uses = static_cast<gdipUse *>(ruby_xrealloc(uses, uses_capa * sizeof(gdipUse)));
+    }
+    uses[gdip_uses_len].user = user;
+    uses[gdip_uses_len].obj = obj;
+    gdip_uses_len += 1;
+}
+
+/* The object used by +user+, or NULL if it has been deleted or was never attached. */
+void *
+gdip_use_target(void *user)
+{
+    for (int i = 0; i < gdip_uses_len; ++i) {
+        if (uses[i].user == user) return uses[i].obj;
+    }
+    return NULL;
+}
+
+bool
+gdip_used_p(void *obj, void *except_user)
+{
+    if (obj == NULL) return false;
+    for (int i = 0; i < gdip_uses_len; ++i) {
+        if (uses[i].obj == obj && uses[i].user != except_user) return true;
+    }
+    return false;
+}
+
+/*
+ * Drops the uses by +ptr+ and of +ptr+ when it is deleted.
+ * Called from the free functions, so this must not allocate.
+ */
+void
+gdip_use_forget(void *ptr)
+{
+    int i = 0;
+    while (i < gdip_uses_len) {
+        if (uses[i].user == ptr || uses[i].obj == ptr) {
+            uses[i] = uses[gdip_uses_len - 1];
+            gdip_uses_len -= 1;
+        }
+        else {
+            i += 1;
+        }
+    }
+}
+
 bool
 gdip_arg_to_double(VALUE v, double *dbl, const char *raise_msg)
 {
@@ -249,6 +533,112 @@ alloc_array_of_single(VALUE ary, int& count)
     return tary;
 }
 
+/*
+ * Packed points are a flat Array of numbers [x0, y0, x1, y1, ...], a binary
+ * String of native floats (Array#pack('f*')) or a PointFArray. They don't need
+ * a Point object per vertex. An Array of Integers gives Point; an Array with
+ * any Float in it gives PointF.
+ */
+PackedPointsType
+gdip_packed_points_type(VALUE v)
+{
+    if (_RB_STRING_P(v) || _KIND_OF(v, &tPointFArray)) {
+        return PackedPointF;
+    }
+    else if (_RB_ARRAY_P(v) && RARRAY_LEN(v) > 0) {
+        VALUE first = rb_ary_entry(v, 0);
+        if (!Integer_p(first) && !Float_p(first)) return PackedPointNone;
+        for (long i = 0; i < RARRAY_LEN(v); ++i) {
+            if (Float_p(rb_ary_entry(v, i))) return PackedPointF;
+        }
+        return PackedPoint;
+    }
+    return PackedPointNone;
+}
+
+static long
+gdip_packed_points_len(VALUE v)
+{
+    long len = RARRAY_LEN(v);
+    if (len % 2 != 0) {
+        rb_raise(rb_eArgError, "The packed points should have an even number of coordinates.");
+    }
+    if (len / 2 > INT_MAX) {
+        rb_raise(rb_eArgError, "Too many points.");
+    }
+    return len / 2;
+}
+
+Point *
+alloc_packed_points(VALUE v, int& count)
+{
+    count = static_cast<int>(gdip_packed_points_len(v));
+    Point *tary = static_cast<Point *>(ruby_xcalloc(count, sizeof(Point)));
+    bool converted = false;
+    _rb_ensure(
+        [&]() -> VALUE {
+            for (int i = 0; i < count; ++i) {
+                tary[i].X = RB_NUM2INT(rb_ary_entry(v, 2 * i));
+                tary[i].Y = RB_NUM2INT(rb_ary_entry(v, 2 * i + 1));
+            }
+            converted = true;
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            if (!converted) ruby_xfree(tary);
+            return Qnil;
+        });
+    return tary;
+}
+
+/* The storage of a PointFArray is returned as it is; release the result with free_packed_points. */
+PointF *
+get_packed_pointfs(VALUE v, int& count)
+{
+    if (_KIND_OF(v, &tPointFArray)) {
+        return gdip_pointfarray_ptr(v, count);
+    }
+    else if (_RB_STRING_P(v)) {
+        long len = RSTRING_LEN(v);
+        if (len % sizeof(PointF) != 0) {
+            rb_raise(rb_eArgError, "The length of the packed points should be a multiple of %d.", static_cast<int>(sizeof(PointF)));
+        }
+        if (static_cast<unsigned long>(len / sizeof(PointF)) > INT_MAX) {
+            rb_raise(rb_eArgError, "Too many points.");
+        }
+        count = static_cast<int>(len / sizeof(PointF));
+        PointF *tary = static_cast<PointF *>(ruby_xcalloc(count, sizeof(PointF)));
+        memcpy(tary, RSTRING_PTR(v), count * sizeof(PointF));
+        return tary;
+    }
+
+    count = static_cast<int>(gdip_packed_points_len(v));
+    PointF *tary = static_cast<PointF *>(ruby_xcalloc(count, sizeof(PointF)));
+    bool converted = false;
+    _rb_ensure(
+        [&]() -> VALUE {
+            for (int i = 0; i < count; ++i) {
+                tary[i].X = NUM2SINGLE(rb_ary_entry(v, 2 * i));
+                tary[i].Y = NUM2SINGLE(rb_ary_entry(v, 2 * i + 1));
+            }
+            converted = true;
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            if (!converted) ruby_xfree(tary);
+            return Qnil;
+        });
+    return tary;
+}
+
+void
+free_packed_points(VALUE v, void *points)
+{
+    if (!_KIND_OF(v, &tPointFArray)) {
+        ruby_xfree(points);
+    }
+}
+
 /**
  * @return [Integer]
  */
@@ -263,6 +653,89 @@ gdip_gpobject_object_id(VALUE self)
     }
 }
 
+/*
+ * Frees the native object of +self+ now with the free function of its data type.
+ * Returns false if it was already disposed.
+ */
+bool
+gdip_obj_dispose(VALUE self)
+{
+    Check_Frozen(self);
+    void *ptr = _DATA_PTR(self);
+    if (ptr == NULL) return false;
+    if (gdip_busy_p(ptr)) {
+        rb_raise(eGdiplus, "The object is being used by another thread.");
+    }
+    if (gdip_used_p(ptr)) {
+        rb_raise(eGdiplus, "The object is being used by a Graphics or a BitmapData.");
+    }
+#ifdef HAVE_TYPE_RB_DATA_TYPE_T
+    RUBY_DATA_FUNC dfree = RTYPEDDATA_TYPE(self)->function.dfree;
+#else
+    RUBY_DATA_FUNC dfree = RDATA(self)->dfree;
+#endif
+    _DATA_PTR(self) = NULL;
+    if (dfree == RUBY_DEFAULT_FREE) {
+        ruby_xfree(ptr);
+    }
+    else if (dfree != RUBY_NEVER_FREE) {
+        (*dfree)(ptr);
+    }
+    return true;
+}
+
+/**
+ * Frees the native GDI+ object now instead of when it is garbage collected.
+ * Using this object afterwards raises {GdiplusError}. Disposing twice does nothing.
+ * @return [nil]
+ */
+static VALUE
+gdip_gpobject_dispose(VALUE self)
+{
+    gdip_obj_dispose(self);
+    return Qnil;
+}
+
+/**
+ * @return [Boolean] true if this object has been disposed.
+ */
+static VALUE
+gdip_gpobject_disposed_p(VALUE self)
+{
+    return _DATA_PTR(self) == NULL ? Qtrue : Qfalse;
+}
+
+/**
+ * Creates an object with the arguments of +new+. With a block, yields it and
+ * disposes it when the block exits, so that its native memory is freed at once.
+ * @overload open(*args)
+ *   @return [GpObject]
+ * @overload open(*args) {|obj| ... }
+ *   @return [Object] the value of the block.
+ * @example
+ *   Bitmap.open("photo.jpg") {|bmp|
+ *     bmp.save("photo.png")
+ *   }
+ */
+static VALUE
+gdip_gpobject_s_open(int argc, VALUE *argv, VALUE klass)
+{
+    VALUE obj = rb_class_new_instance(argc, argv, klass);
+    if (!rb_block_given_p()) {
+        return obj;
+    }
+    return _rb_ensure(
+        [&]() -> VALUE {
+            return rb_yield(obj);
+        },
+        [&]() -> VALUE {
+            if (!RB_OBJ_FROZEN(obj)) {
+                rb_funcall(obj, rb_intern("dispose"), 0);
+            }
+            return Qnil;
+        });
+}
+
 VALUE
 gdip_class_const_get(VALUE klass)
 {
@@ -277,23 +750,41 @@ Init_gdiplus(void)
     mInternals = rb_define_module_under(mGdiplus, "Internals");
     cGpObject = rb_define_class_under(mInternals, "GpObject", rb_cObject);
     rb_define_method(cGpObject, "gdiplus_id", RUBY_METHOD_FUNC(gdip_gpobject_object_id), 0);
+    rb_define_method(cGpObject, "Dispose", RUBY_METHOD_FUNC(gdip_gpobject_dispose), 0);
+    rb_define_alias(cGpObject, "dispose", "Dispose");
+    rb_define_alias(cGpObject, "close", "Dispose");
+    rb_define_method(cGpObject, "disposed?", RUBY_METHOD_FUNC(gdip_gpobject_disposed_p), 0);
+    rb_define_singleton_method(cGpObject, "open", RUBY_METHOD_FUNC(gdip_gpobject_s_open), -1);
+
+    rb_define_module_function(mGdiplus, "init_profile", RUBY_METHOD_FUNC(gdiplus_s_init_profile), 0);
+    rb_define_module_function(mGdiplus, "trace=", RUBY_METHOD_FUNC(gdiplus_s_set_trace), 1);
+    rb_define_module_function(mGdiplus, "trace?", RUBY_METHOD_FUNC(gdiplus_s_get_trace), 0);
+    /* true if built with --enable-debug */
+    rb_define_const(mGdiplus, "DEBUG_BUILD", GDIPLUS_DEBUG ? Qtrue : Qfalse);
+    /* true if built with the trace points (--enable-trace or --enable-debug) */
+    rb_define_const(mGdiplus, "TRACE_BUILD", GDIPLUS_TRACE ? Qtrue : Qfalse);
 
     rb_set_end_proc(gdiplus_end, Qnil);
-    gdiplus_init();
-
-    Init_codec();
-    Init_image();
-    Init_bitmap();
-    Init_enum();
-    Init_color();
-    Init_pen_brush();
-    Init_graphics();
-    Init_rectangle();
-    Init_font();
-    Init_langid();
-    Init_stringformat();
-    Init_graphicspath();
-    Init_matrix();
-    Init_region();
-    Init_image_attrs();
+
+    INIT_PROFILE(Init_codec);
+    INIT_PROFILE(Init_image);
+    INIT_PROFILE(Init_bitmap);
+    INIT_PROFILE(Init_enum);
+    INIT_PROFILE(Init_color);
+    INIT_PROFILE(Init_pen_brush);
+    INIT_PROFILE(Init_graphics);
+    INIT_PROFILE(Init_rectangle);
+    INIT_PROFILE(Init_font);
+    INIT_PROFILE(Init_langid);
+    INIT_PROFILE(Init_stringformat);
+    INIT_PROFILE(Init_graphicspath);
+    INIT_PROFILE(Init_matrix);
+    INIT_PROFILE(Init_region);
+    INIT_PROFILE(Init_image_attrs);
+    INIT_PROFILE(Init_command_buffer);
+    INIT_PROFILE(Init_geometry_array);
+    INIT_PROFILE(Init_pixel_ops);
+    INIT_PROFILE(Init_pipeline);
+    INIT_PROFILE(Init_stats);
+    INIT_PROFILE(Init_live_objects);
 }
@@ -243,13 +243,51 @@
         parent_type_ptr, klass_ptr\
     }
 #else
+    /* Write-barrier protected: every store to a VALUE member must use RB_OBJ_WRITE. */
     #define _MAKE_DATA_TYPE(name, mark, free, size, parent_type_ptr, klass_ptr) {\
         name,\
         {mark, free, size,},\
         parent_type_ptr, klass_ptr,\
-        RUBY_TYPED_FREE_IMMEDIATELY\
+        RUBY_TYPED_FREE_IMMEDIATELY | RUBY_TYPED_WB_PROTECTED\
     }
 #endif /* RUBY_API_VERSION_CODE < 20200 */
+#ifndef RB_OBJ_WRITE
+#define RB_OBJ_WRITE(a, slot, b) (*(slot) = (b))
+#endif
+#if RUBY_API_VERSION_CODE >= 20700
+    /* For a mark function using _rb_gc_mark_movable; compact updates the moved VALUEs with _rb_gc_location. */
+    #define _MAKE_DATA_TYPE_MOVABLE(name, mark, free, size, compact, parent_type_ptr, klass_ptr) {\
+        name,\
+        {mark, free, size, compact,},\
+        parent_type_ptr, klass_ptr,\
+        RUBY_TYPED_FREE_IMMEDIATELY | RUBY_TYPED_WB_PROTECTED\
+    }
+#define _rb_gc_mark_movable(v) rb_gc_mark_movable(v)
+#define _rb_gc_location(v) rb_gc_location(v)
+#else
+    #define _MAKE_DATA_TYPE_MOVABLE(name, mark, free, size, compact, parent_type_ptr, klass_ptr) \
+        _MAKE_DATA_TYPE(name, mark, free, size, parent_type_ptr, klass_ptr)
+#define _rb_gc_mark_movable(v) rb_gc_mark(v)
+#define _rb_gc_location(v) (v)
+#endif /* RUBY_API_VERSION_CODE >= 20700 */
+#if RUBY_API_VERSION_CODE >= 30300
+    /*
+     * For small value structs without VALUE members. The struct is allocated in the
+     * object slot and freed with it, so there is no dsize and no free function.
+     */
+    #define _MAKE_DATA_TYPE_EMBEDDABLE(name, size, klass_ptr) {\
+        name,\
+        {0, RUBY_TYPED_DEFAULT_FREE, NULL,},\
+        NULL, klass_ptr,\
+        RUBY_TYPED_FREE_IMMEDIATELY | RUBY_TYPED_WB_PROTECTED | RUBY_TYPED_EMBEDDABLE\
+    }
+/* Reads the struct pointer; the data of an embedded object is not in RTYPEDDATA(v)->data. */
+#define _DATA_GET_PTR(v) RTYPEDDATA_GET_DATA(v)
+#else
+    #define _MAKE_DATA_TYPE_EMBEDDABLE(name, size, klass_ptr) \
+        _MAKE_DATA_TYPE(name, 0, RUBY_TYPED_DEFAULT_FREE, size, NULL, klass_ptr)
+#define _DATA_GET_PTR(v) _DATA_PTR(v)
+#endif /* RUBY_API_VERSION_CODE >= 30300 */
     static inline VALUE
     _KLASS(const rb_data_type_t *type)
     {
@@ -10,6 +10,9 @@
 #include "ruby_ext_utils.hpp"
 #include <ruby.h>
 #include "ruby_compatible.h"
+#if RUBY_API_VERSION_CODE >= 20000
+#include <ruby/thread.h>
+#endif
 #include "gdip_utils.h"
 #include <windows.h>
 #include <rpc.h>
@@ -24,6 +27,7 @@ using namespace Gdiplus;
 
 extern VALUE mGdiplus;
 extern VALUE mInternals;
+extern VALUE mPipeline;
 extern VALUE cGpObject;
 extern VALUE eGdiplus;
 
@@ -31,6 +35,7 @@ extern VALUE cGuid;
 extern VALUE cImageCodecInfo;
 extern VALUE cImage;
 extern VALUE cBitmap;
+extern VALUE cBitmapData;
 extern VALUE cPixelFormat;
 extern VALUE cEncoderParameterValueType;
 extern VALUE cEncoder;
@@ -88,6 +93,7 @@ extern VALUE cWrapMode;
 extern VALUE cColorAdjustType;
 extern VALUE cColorChannelFlag;
 extern VALUE cColorMatrixFlag;
+extern VALUE cImageLockMode;
 
 extern VALUE cFontFamily;
 extern VALUE cFontCollection;
@@ -100,11 +106,16 @@ extern VALUE cGraphicsPath;
 extern VALUE cMatrix;
 extern VALUE cRegion;
 extern VALUE cImageAttributes;
+extern VALUE cCommandBuffer;
+extern VALUE cPointFArray;
+extern VALUE cRectFArray;
+extern VALUE cColorMatrix;
 
 extern const rb_data_type_t tGuid;
 extern const rb_data_type_t tImageCodecInfo;
 extern const rb_data_type_t tImage;
 extern const rb_data_type_t tBitmap;
+extern const rb_data_type_t tBitmapData;
 extern const rb_data_type_t tEnumInt;
 extern const rb_data_type_t tEncoderParameter;
 extern const rb_data_type_t tEncoderParameters;
@@ -130,6 +141,10 @@ extern const rb_data_type_t tPathData;
 extern const rb_data_type_t tMatrix;
 extern const rb_data_type_t tRegion;
 extern const rb_data_type_t tImageAttributes;
+extern const rb_data_type_t tCommandBuffer;
+extern const rb_data_type_t tPointFArray;
+extern const rb_data_type_t tRectFArray;
+extern const rb_data_type_t tColorMatrix;
 
 void Init_codec();
 void Init_image();
@@ -146,6 +161,12 @@ void Init_graphicspath();
 void Init_matrix();
 void Init_region();
 void Init_image_attrs();
+void Init_command_buffer();
+void Init_geometry_array();
+void Init_pixel_ops();
+void Init_pipeline();
+void Init_stats();
+void Init_live_objects();
 
 /* gdip_enum.cpp */
 extern ID ID_UNKNOWN;
@@ -191,13 +212,36 @@ enum ArgOption {
 extern const char *GpStatusStrs[22];
 extern int gdip_refcount;
 extern bool gdip_end_flag;
+extern bool gdip_started;
+void gdiplus_startup();
 void gdiplus_shutdown();
+bool gdip_busy_p(void *obj);
+void gdip_busy_enter(void *obj1, void *obj2=NULL, void *obj3=NULL, void *obj4=NULL);
+void gdip_busy_leave(void *obj1, void *obj2=NULL, void *obj3=NULL, void *obj4=NULL);
+void gdip_busy_enter_all(void **objs, long count);
+void gdip_busy_leave_all(void **objs, long count);
+extern int gdip_uses_len;
+void gdip_use_attach(void *user, void *obj);
+void *gdip_use_target(void *user);
+bool gdip_used_p(void *obj, void *except_user=NULL);
+void gdip_use_forget(void *ptr);
 
 bool gdip_arg_to_double(VALUE v, double *dbl, const char *raise_msg=NULL);
 bool gdip_arg_to_single(VALUE v, float *flt, const char *raise_msg=NULL);
 float *alloc_array_of_single(VALUE ary, int& count);
+enum PackedPointsType {
+    PackedPointNone = 0,
+    PackedPoint,
+    PackedPointF
+};
+PackedPointsType gdip_packed_points_type(VALUE v);
+Point *alloc_packed_points(VALUE v, int& count);
+PointF *get_packed_pointfs(VALUE v, int& count);
+void free_packed_points(VALUE v, void *points);
+bool gdip_obj_dispose(VALUE self);
 VALUE gdip_class_const_get(VALUE klass);
 
+static inline void GdiplusEnsureStarted() { if (!gdip_started) gdiplus_startup(); }
 static inline void GdiplusAddRef() { ++gdip_refcount; }
 static inline void GdiplusRelease() {
     --gdip_refcount;
@@ -216,8 +260,23 @@ VALUE gdip_enumint_create(VALUE klass, int num);
 int gdip_arg_to_enumint(VALUE klass, VALUE arg, void *enumint, const char *raise_msg=NULL, int option=ArgOptionAcceptInt);
 VALUE gdip_enum_guid_create(VALUE klass, GUID *guid);
 
+/* gdip_image.cpp */
+CLSID *gdip_image_get_encoder_clsid(VALUE fmt, VALUE filename);
+
+/* gdip_bitmap.cpp */
+Status gdip_bitmap_resize(Bitmap *src, Bitmap *dst, InterpolationMode mode, int threads=0);
+
 /* gdip_graphics.cpp */
 VALUE gdip_graphics_create(Graphics *g);
+VALUE gdip_graphics_from_image(VALUE v_image);
+
+/* gdip_command_buffer.cpp */
+Status gdip_cmdbuf_execute(Graphics *g, VALUE v_cmdbuf);
+
+/* gdip_geometry_array.cpp */
+PointF *gdip_pointfarray_ptr(VALUE v, int& count);
+RectF *gdip_rectfarray_ptr(VALUE v, int& count);
+VALUE gdip_pointfarray_create(const PointF *points, int count);
 
 /* gdip_color.cpp */
 VALUE gdip_color_create(ARGB argb);
@@ -245,6 +304,7 @@ bool gdip_arg_to_langid(VALUE arg, LANGID *langid, const char *raise_msg=NULL, i
 /* gdip_utils.cpp */
 VALUE util_encode_to_utf8(VALUE str);
 VALUE util_associate_utf8(VALUE str);
+VALUE util_associate_binary(VALUE str);
 VALUE util_utf8_sprintf(const char* format, ...);
 VALUE util_utf16_str_new(VALUE v);
 VALUE util_utf8_str_new_from_wstr(const wchar_t * wstr);
@@ -312,17 +372,42 @@ bool util_extname(VALUE str, char (&ext)[6]);
 #define CLASS_ATTR_R(...) GET_MACRO((__VA_ARGS__, CLASS_ATTR_R5, CLASS_ATTR_R4))(__VA_ARGS__)
 
 /* Debug */
-// #define GDIPLUS_DEBUG 1 // moved in extconf.rb
+// GDIPLUS_DEBUG and GDIPLUS_TRACE are set by extconf.rb (--enable-debug, --enable-trace)
 
 #ifndef GDIPLUS_DEBUG
 #define GDIPLUS_DEBUG 0
 #endif
+#ifndef GDIPLUS_TRACE
+#define GDIPLUS_TRACE GDIPLUS_DEBUG
+#endif
 #if GDIPLUS_DEBUG
     void dp(const char *fmt, ...);
 #else
     #define dp(...)
 #endif
 
+/*
+ * Trace points of object churn. Without GDIPLUS_TRACE they are compiled out.
+ * With it, each is one branch on gdip_trace_enabled (Gdiplus.trace = true), and
+ * the arguments are evaluated and reported with OutputDebugString only when it is on.
+ */
+enum TraceEvent {
+    TraceAlloc = 0, // Ruby object with native data
+    TraceNull,      // Ruby object for a GDI+ object
+    TraceFree,      // native data freed
+    TraceNew,       // GDI+ object created
+    TraceDelete,    // GDI+ object deleted
+    TraceMapNew,
+    TraceMapDelete
+};
+#if GDIPLUS_TRACE
+    extern bool gdip_trace_enabled;
+    void gdip_trace(TraceEvent event, const char *name, const void *ptr);
+    #define GDIP_TRACE(event, name, ptr) do { if (gdip_trace_enabled) gdip_trace((event), (name), (ptr)); } while (0)
+#else
+    #define GDIP_TRACE(event, name, ptr) ((void)0)
+#endif
+
 template<typename T>
 static inline T 
 Data_Ptr(VALUE obj)
@@ -330,7 +415,7 @@ Data_Ptr(VALUE obj)
     if (!RB_TYPE_P(obj, RUBY_T_DATA)) {
         rb_raise(rb_eTypeError, "wrong argument type");
     }
-    return static_cast<T>(_DATA_PTR(obj));
+    return static_cast<T>(_DATA_GET_PTR(obj));
 }
 
 template<typename TA, typename TB>
@@ -370,7 +455,7 @@ template<typename T>
 static inline void
 Data_Ptr_Set_Data(VALUE v, T ptr)
 {
-    *static_cast<T>(_DATA_PTR(v)) = *ptr;
+    *static_cast<T>(_DATA_GET_PTR(v)) = *ptr;
 }
 
 template<typename T>
@@ -385,8 +470,15 @@ static VALUE
 typeddata_alloc(VALUE klass=Qnil)
 {
     if (RB_NIL_P(klass)) klass = *static_cast<VALUE *>(type->data);
+#if RUBY_API_VERSION_CODE >= 30300
+    if (type->flags & RUBY_TYPED_EMBEDDABLE) {
+        VALUE r = rb_data_typed_object_zalloc(klass, sizeof(T), type);
+        GDIP_TRACE(TraceAlloc, type->wrap_struct_name, _DATA_GET_PTR(r));
+        return r;
+    }
+#endif
     void *ptr = RB_ZALLOC(T);
-    dp("<%s> alloc", type_name<T>());
+    GDIP_TRACE(TraceAlloc, type->wrap_struct_name, ptr);
     VALUE r = _Data_Wrap_Struct(klass, type, ptr);
     return r;
 }
@@ -396,7 +488,9 @@ static VALUE
 typeddata_alloc_null(VALUE klass=Qnil)
 {
     if (RB_NIL_P(klass)) klass = *static_cast<VALUE *>(type->data);
-    dp("<%s> null", type->wrap_struct_name);
+    GDIP_TRACE(TraceNull, type->wrap_struct_name, NULL);
+    /* GDI+ objects are wrapped in a null object first. */
+    GdiplusEnsureStarted();
     VALUE r = _Data_Wrap_Struct(klass, type, NULL);
     return r;
 }
@@ -434,15 +528,104 @@ template<typename T>
 static void
 gdip_default_free(void *ptr)
 {
-    dp("<%s> free", type_name<T>());
+    GDIP_TRACE(TraceFree, type_name<T>(), ptr);
     ruby_xfree(ptr);
 }
-#if GDIPLUS_DEBUG
+#if GDIPLUS_TRACE
 #define GDIP_DEFAULT_FREE(T) (&gdip_default_free<T>)
 #else
 #define GDIP_DEFAULT_FREE(T) RUBY_DEFAULT_FREE
 #endif
 
+/*
+ * Bytes held by a GDI+ object besides the object itself.
+ * Pixel data for bitmaps, points and types for paths, and the serialized
+ * data for regions. Objects that another thread is using are not asked.
+ */
+template<typename T>
+static inline size_t
+gdip_native_memsize(T obj)
+{
+    return 0;
+}
+
+static inline size_t
+gdip_native_memsize(Image *image)
+{
+    if (gdip_busy_p(image) || image->GetType() != ImageTypeBitmap) return 0;
+    return static_cast<size_t>(image->GetWidth()) * image->GetHeight() * GetPixelFormatSize(image->GetPixelFormat()) / 8;
+}
+
+static inline size_t
+gdip_native_memsize(Bitmap *bmp)
+{
+    return gdip_native_memsize(static_cast<Image *>(bmp));
+}
+
+static inline size_t
+gdip_native_memsize(GraphicsPath *path)
+{
+    if (gdip_busy_p(path)) return 0;
+    return static_cast<size_t>(path->GetPointCount()) * (sizeof(PointF) + sizeof(BYTE));
+}
+
+static inline size_t
+gdip_native_memsize(Region *region)
+{
+    if (gdip_busy_p(region)) return 0;
+    return region->GetDataSize();
+}
+
+/*
+ * The part of gdip_native_memsize that is reported to the GC when the object
+ * is created and freed (rb_gc_adjust_memory_usage). Only images qualify:
+ * the size of a path or a region changes after creation, so it is left to dsize.
+ */
+template<typename T>
+static inline size_t
+gdip_external_memsize(T obj)
+{
+    return 0;
+}
+
+static inline size_t
+gdip_external_memsize(Image *image)
+{
+    return gdip_native_memsize(image);
+}
+
+static inline size_t
+gdip_external_memsize(Bitmap *bmp)
+{
+    return gdip_native_memsize(bmp);
+}
+
+static inline void
+gdip_adjust_memory_usage(ssize_t diff)
+{
+#if RUBY_API_VERSION_CODE >= 20400
+    if (diff != 0) {
+        rb_gc_adjust_memory_usage(diff);
+    }
+#endif
+}
+
+template<typename T>
+static size_t
+gdip_obj_memsize(const void *ptr)
+{
+    T obj = static_cast<T>(const_cast<void *>(ptr));
+    if (obj == NULL) return 0;
+    return sizeof(*obj) + gdip_native_memsize(obj);
+}
+#define GDIP_OBJ_MEMSIZE(T) (&gdip_obj_memsize<T>)
+
+/* gdip_live_objects.cpp */
+extern bool gdip_live_enabled;
+extern long gdip_live_count;
+void gdip_live_add(const char *type, void *obj, size_t size);
+void gdip_live_remove(void *obj);
+
 template<typename T>
 static inline T
 gdip_obj_create(T obj, bool ignore_status=false)
@@ -454,8 +637,10 @@ gdip_obj_create(T obj, bool ignore_status=false)
     }
     Status status = obj->GetLastStatus();
     if (status == Ok || ignore_status) {
-        dp("<%s> new", type_name<T>());
+        GDIP_TRACE(TraceNew, type_name<T>(), obj);
         GdiplusAddRef();
+        gdip_adjust_memory_usage(static_cast<ssize_t>(gdip_external_memsize(obj)));
+        if (gdip_live_enabled) gdip_live_add(type_name<T>(), obj, gdip_obj_memsize<T>(obj));
         return obj;
     }
     dp("<%s> error (status: %d)", type_name<T>(), status);
@@ -475,7 +660,10 @@ gdip_obj_free(void *ptr)
 {
     T obj = static_cast<T>(ptr);
     if (obj != NULL) {
-        dp("<%s> delete", type_name<T>());
+        GDIP_TRACE(TraceDelete, type_name<T>(), obj);
+        gdip_adjust_memory_usage(-static_cast<ssize_t>(gdip_external_memsize(obj)));
+        if (gdip_live_count > 0) gdip_live_remove(obj);
+        if (gdip_uses_len > 0) gdip_use_forget(obj);
         delete obj;
         GdiplusRelease();
     }
@@ -527,5 +715,97 @@ Check_Status(Status status) {
 
 #define NOT_IMPLEMENTED_ERROR rb_raise(rb_eNotImpError, "not implemented yet")
 
+/* gdip_stats.cpp */
+extern bool gdip_stats_enabled;
+void gdip_stats_record(LONGLONG ticks, Status status);
+
+static inline LONGLONG
+gdip_stats_now()
+{
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return t.QuadPart;
+}
+
+/*
+ * Runs a GDI+ call with the GVL and counts it in Gdiplus::Stats under the
+ * calling method when stats are enabled.
+ */
+template<typename T>
+static inline Status
+gdip_call(T func)
+{
+    if (!gdip_stats_enabled) return func();
+    LONGLONG t0 = gdip_stats_now();
+    Status status = func();
+    gdip_stats_record(gdip_stats_now() - t0, status);
+    return status;
+}
+
+struct gdip_nogvl_call {
+    std::function<Status ()> func;
+    Status status;
+    bool stats;
+    LONGLONG ticks;
+};
+
+static void *
+gdip_nogvl_call_run(void *data)
+{
+    gdip_nogvl_call *call = static_cast<gdip_nogvl_call *>(data);
+    if (call->stats) {
+        LONGLONG t0 = gdip_stats_now();
+        call->status = call->func();
+        call->ticks = gdip_stats_now() - t0;
+    }
+    else {
+        call->status = call->func();
+    }
+    return NULL;
+}
+
+/*
+ * Runs a long GDI+ call without the GVL so that other Ruby threads can run.
+ * The GDI+ objects it uses are marked busy meanwhile; using them from another
+ * thread raises GdiplusError instead of racing inside GDI+.
+ * +func+ must not touch Ruby objects. Convert the arguments before calling this.
+ * +ubf+ is called with +ubf_data+ when the thread is interrupted (Thread#raise,
+ * Thread#kill, Ctrl+C); it must make +func+ return soon, and may be NULL.
+ */
+template<typename T>
+static inline Status
+gdip_call_without_gvl_ubf(T func, void (*ubf)(void *), void *ubf_data, void *obj1, void *obj2=NULL, void *obj3=NULL, void *obj4=NULL)
+{
+    gdip_nogvl_call call;
+    call.func = func;
+    call.status = GenericError;
+    call.stats = gdip_stats_enabled;
+    call.ticks = 0;
+    gdip_busy_enter(obj1, obj2, obj3, obj4);
+    _rb_ensure(
+        [&]() -> VALUE {
+#if RUBY_API_VERSION_CODE >= 20000
+            rb_thread_call_without_gvl(gdip_nogvl_call_run, &call, ubf, ubf_data);
+#else
+            gdip_nogvl_call_run(&call);
+#endif
+            return Qnil;
+        },
+        [&]() -> VALUE {
+            gdip_busy_leave(obj1, obj2, obj3, obj4);
+            return Qnil;
+        });
+    if (call.stats) {
+        gdip_stats_record(call.ticks, call.status);
+    }
+    return call.status;
+}
+
+template<typename T>
+static inline Status
+gdip_call_without_gvl(T func, void *obj1, void *obj2=NULL, void *obj3=NULL, void *obj4=NULL)
+{
+    return gdip_call_without_gvl_ubf(func, NULL, NULL, obj1, obj2, obj3, obj4);
+}
 
 #endif /* RUBY_GDIPLUS_H */
@@ -10,6 +10,52 @@
 #include <string.h>
 #include <utility>
 
+/*
+ * Static tables sorted by key in the source. Nothing is built at load time
+ * and find() is a plain binary search without virtual calls.
+ * sorted() is constexpr so that a static_assert can check the order:
+ *
+ *   static_assert(FlatMap<Entry, const char *, &Entry::name>::sorted(table), "...");
+ */
+static inline constexpr int
+flatmap_compare(const char *a, const char *b)
+{
+    return *a != *b ? (static_cast<unsigned char>(*a) < static_cast<unsigned char>(*b) ? -1 : 1)
+                    : (*a == 0 ? 0 : flatmap_compare(a + 1, b + 1));
+}
+
+template<typename T>
+static inline constexpr int
+flatmap_compare(T a, T b)
+{
+    return a == b ? 0 : (a < b ? -1 : 1);
+}
+
+template<typename TEntry, typename TKey, TKey TEntry::*Key>
+struct FlatMap {
+    template<size_t N>
+    static constexpr bool sorted(const TEntry (&table)[N]) {
+        return sorted(table, N);
+    }
+    static constexpr bool sorted(const TEntry *table, size_t n) {
+        return n < 2 || (flatmap_compare(table[0].*Key, table[1].*Key) < 0 && sorted(table + 1, n - 1));
+    }
+
+    template<size_t N>
+    static inline const TEntry *find(const TEntry (&table)[N], TKey key) {
+        size_t lo = 0;
+        size_t hi = N;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int c = flatmap_compare(table[mid].*Key, key);
+            if (c == 0) return &table[mid];
+            if (c < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return NULL;
+    }
+};
+
 
 class MapBase {
 public:
@@ -48,14 +94,14 @@ protected:
     }
 public:
     ArrayMap(int capa) {
-        dp("ArrayMap(%d)", capa);
+        GDIP_TRACE(TraceMapNew, "ArrayMap", this);
         Capa = capa;
         Len = 0;
         KeyTable = static_cast<TKey *>(ruby_xcalloc(capa, sizeof(TKey)));
         ValTable = static_cast<TVal *>(ruby_xcalloc(capa, sizeof(TVal)));
     }
     virtual ~ArrayMap() {
-        dp("~ArrayMap() Capa=%d, Len=%d", Capa, Len);
+        GDIP_TRACE(TraceMapDelete, "ArrayMap", this);
         ruby_xfree(KeyTable);
         ruby_xfree(ValTable);
     }
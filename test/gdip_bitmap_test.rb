@@ -12,6 +12,218 @@ class GdiplusBitmapTest < Test::Unit::TestCase
     assert_kind_of(Bitmap, Bitmap.new("test/gdip_bitmap_test1.png", true))
     assert_kind_of(Bitmap, Bitmap.new("test/gdip_bitmap_test2♥.png"))
   end
+
+  def test_bitmap_from_bytes
+    bytes = File.binread("test/gdip_bitmap_test1.png")
+    bmp = Bitmap.from_bytes(bytes)
+    assert_kind_of(Bitmap, bmp)
+    assert_equal(Bitmap.new("test/gdip_bitmap_test1.png").Width, bmp.Width)
+    bytes.replace("") # the bitmap keeps its own reference
+    assert_kind_of(Bitmap, Bitmap.FromBytes(File.binread("test/gdip_bitmap_test1.png"), true))
+    assert_raise(GdiplusError) { Bitmap.from_bytes("not an image") }
+    assert_raise(TypeError) { Bitmap.from_bytes(nil) }
+  end
+
+  def test_bitmap_from_io
+    File.open("test/gdip_bitmap_test1.png", "rb") {|f|
+      assert_kind_of(Bitmap, Bitmap.new(f))
+    }
+    File.open("test/gdip_bitmap_test1.png", "rb") {|f|
+      assert_kind_of(Bitmap, Bitmap.new(f, true))
+    }
+  end
+
+  def test_lock_bits
+    bmp = Bitmap.new(4, 3)
+    bmpdata = bmp.LockBits(nil, ImageLockMode.ReadWrite, PixelFormat.Format32bppARGB)
+    assert_kind_of(BitmapData, bmpdata)
+    assert_equal(4, bmpdata.Width)
+    assert_equal(3, bmpdata.Height)
+    assert_equal(16, bmpdata.Stride)
+    assert_equal(PixelFormat.Format32bppARGB, bmpdata.PixelFormat)
+    assert_kind_of(Integer, bmpdata.Scan0)
+    bytes = bmpdata.bytes
+    assert_equal(48, bytes.bytesize)
+    bmpdata.write(0, [0xff112233].pack('V'))
+    assert_equal([0xff112233], bmpdata.bytes.unpack('V1'))
+    # bytes is a copy that stays valid after UnlockBits
+    assert_not_equal([0xff112233], bytes.unpack('V1'))
+    assert_equal(bmp, bmp.UnlockBits(bmpdata))
+    assert(!bmpdata.locked?)
+    assert_equal(48, bytes.bytesize)
+    assert_raise(GdiplusError) { bmpdata.bytes }
+    assert_raise(GdiplusError) { bmp.UnlockBits(bmpdata) }
+  end
+
+  def test_lock_bits_block
+    bmp = Bitmap.new(4, 4)
+    data = nil
+    r = bmp.LockBits(Rectangle.new(1, 1, 2, 2), ImageLockMode.ReadOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+      data = bmpdata
+      assert_equal(2, bmpdata.Width)
+      assert_raise(GdiplusError) { bmpdata.write(0, "\0") }
+      bmpdata.bytes.unpack('C*')
+    }
+    assert_equal(16, r.size)
+    assert(!data.locked?)
+    if defined?(IO::Buffer)
+      bmp.LockBits(nil, ImageLockMode.ReadOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+        assert_equal(64, bmpdata.buffer.size)
+      }
+    end
+  end
+
+  def lock_bits_buffer(bmp)
+    bmpdata = bmp.LockBits(nil, ImageLockMode.ReadWrite, PixelFormat.Format32bppARGB)
+    [bmpdata.buffer, WeakRef.new(bmpdata)]
+  end
+
+  def test_lock_bits_buffer_after_gc
+    return unless defined?(IO::Buffer)
+    require 'weakref'
+    bmp = Bitmap.new(4, 4)
+    buffer, ref = lock_bits_buffer(bmp)
+    assert_equal(64, buffer.size)
+    3.times {
+      GC.start
+      Thread.pass
+    }
+    # the stack may still hold the BitmapData; then it is not collected
+    return if ref.weakref_alive?
+    assert(buffer.null?)
+    assert_raise_kind_of(StandardError) { buffer.get_value(:U8, 0) }
+    # the pixels are unlocked
+    bmp.LockBits(nil, ImageLockMode.ReadOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+      assert_equal(64, bmpdata.bytes.bytesize)
+    }
+    bmp.dispose
+  end
+
+  def pixel_bitmap(pixels)
+    bmp = Bitmap.new(pixels.size, 1)
+    bmp.LockBits(nil, ImageLockMode.WriteOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+      bmpdata.write(0, pixels.pack('V*'))
+    }
+    bmp
+  end
+
+  def pixels_of(bmp)
+    bmp.LockBits(nil, ImageLockMode.ReadOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+      bmpdata.bytes.unpack('V*')
+    }
+  end
+
+  def test_pixel_ops
+    assert(%w(avx2 sse2 scalar).include?(Bitmap::PixelKernels))
+    # 9 pixels: the vector loops and the scalar tail
+    src = [0xff000000, 0xffffffff, 0x80ff0000, 0xff00ff00, 0x400000ff, 0xff102030, 0x00ffffff, 0xff808080, 0xff7f7f7f]
+
+    bmp = pixel_bitmap(src)
+    assert_same(bmp, bmp.grayscale!)
+    assert_equal([0xff000000, 0xffffffff, 0x804d4d4d, 0xff959595, 0x401d1d1d, 0xff1d1d1d, 0x00ffffff, 0xff808080, 0xff7f7f7f], pixels_of(bmp))
+
+    bmp = pixel_bitmap(src)
+    assert_same(bmp, bmp.threshold!(0.5))
+    assert_equal([0xff000000, 0xffffffff, 0x80ff0000, 0xff00ff00, 0x400000ff, 0xff000000, 0x00ffffff, 0xffffffff, 0xff000000], pixels_of(bmp))
+
+    bmp = pixel_bitmap(src)
+    assert_same(bmp, bmp.premultiply!)
+    assert_equal([0xff000000, 0xffffffff, 0x80800000, 0xff00ff00, 0x40000040, 0xff102030, 0x00000000, 0xff808080, 0xff7f7f7f], pixels_of(bmp))
+
+    bmp = pixel_bitmap(src)
+    assert_same(bmp, bmp.gamma!(1.0))
+    assert_equal(src, pixels_of(bmp))
+
+    bmp = pixel_bitmap(src)
+    assert_same(bmp, bmp.remap!(Color.new(0xff, 0, 0xff, 0) => Color.new(0xff, 0, 0, 0xff)))
+    assert_equal(0xff0000ff, pixels_of(bmp)[3])
+    assert_raise(TypeError) { bmp.remap!([]) }
+    bmp = pixel_bitmap([0xffff0000, 0xff00ff00])
+    assert_raise(TypeError) { bmp.remap!(Color.Red => Color.Blue, Color.Lime => "oops") }
+    assert_equal([0xffff0000, 0xff00ff00], pixels_of(bmp))
+
+    swap_rb = ColorMatrix.new([
+      0.0, 0.0, 1.0, 0.0, 0.0,
+      0.0, 1.0, 0.0, 0.0, 0.0,
+      1.0, 0.0, 0.0, 0.0, 0.0,
+      0.0, 0.0, 0.0, 1.0, 0.0,
+      0.0, 0.0, 0.0, 0.0, 1.0,
+    ])
+    bmp = pixel_bitmap(src)
+    assert_same(bmp, bmp.apply_color_matrix!(swap_rb))
+    assert_equal([0xff000000, 0xffffffff, 0x800000ff, 0xff00ff00, 0x40ff0000, 0xff302010, 0x00ffffff, 0xff808080, 0xff7f7f7f], pixels_of(bmp))
+    assert_raise(TypeError) { bmp.apply_color_matrix!([]) }
+  end
+
+  # A scanline of one pixel never reaches the vector loops, so a column of the
+  # same pixels runs the scalar kernel on each of them.
+  def test_pixel_ops_vector_matches_scalar
+    rng = Random.new(1)
+    pixels = Array.new(67) { rng.rand(0x100000000) }
+    column = lambda {
+      bmp = Bitmap.new(1, pixels.size)
+      bmp.LockBits(nil, ImageLockMode.WriteOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+        pixels.each_with_index {|px, y| bmpdata.write(y * bmpdata.Stride, [px].pack('V')) }
+      }
+      bmp
+    }
+    sepia = ColorMatrix.new([
+      0.393, 0.349, 0.272, 0.0, 0.0,
+      0.769, 0.686, 0.534, 0.0, 0.0,
+      0.189, 0.168, 0.131, 0.0, 0.0,
+      0.0, 0.0, 0.0, 1.0, 0.0,
+      0.1, 0.0, -0.1, 0.0, 1.0,
+    ])
+    ops = {
+      grayscale!: [],
+      threshold!: [0.3],
+      premultiply!: [],
+      gamma!: [2.2],
+      apply_color_matrix!: [sepia],
+    }
+    ops.each {|op, args|
+      row = pixel_bitmap(pixels)
+      row.send(op, *args)
+      col = column.call
+      col.send(op, *args)
+      assert_equal(pixels_of(col), pixels_of(row), op.to_s)
+    }
+
+    frozen = pixel_bitmap(pixels).freeze
+    ops.each {|op, args|
+      assert_raise_kind_of(RuntimeError) { frozen.send(op, *args) }
+    }
+    assert_raise_kind_of(RuntimeError) { frozen.remap!(Color.Red => Color.Blue) }
+  end
+
+  def test_resize
+    src = Bitmap.new(64, 48)
+    src.draw {|g|
+      g.FillRectangle(Brushes.Red, 0, 0, 32, 48)
+      g.FillEllipse(Brushes.Blue, 8, 4, 48, 40)
+    }
+    bmp = src.resize(160, 256)
+    assert_instance_of(Bitmap, bmp)
+    assert_equal(160, bmp.Width)
+    assert_equal(256, bmp.Height)
+    assert_equal(PixelFormat.Format32bppPARGB, bmp.PixelFormat)
+
+    # the bands join without seams
+    one = src.resize(160, 256, InterpolationMode.HighQualityBicubic, 1)
+    assert_equal(pixels_of(one), pixels_of(src.resize(160, 256, InterpolationMode.HighQualityBicubic, 4)))
+    assert_equal(pixels_of(one), pixels_of(bmp))
+
+    small = src.resize(16, 12, InterpolationMode.NearestNeighbor)
+    assert_equal([16, 12], [small.Width, small.Height])
+    assert_raise(ArgumentError) { src.resize(0, 10) }
+  end
+
+  def test_memsize
+    require 'objspace'
+    assert_operator(ObjectSpace.memsize_of(Bitmap.new(100, 100, PixelFormat.Format32bppARGB)), :>=, 100 * 100 * 4)
+    assert_operator(ObjectSpace.memsize_of(Bitmap.new(100, 100, PixelFormat.Format24bppRGB)), :>=, 100 * 100 * 3)
+    assert_operator(ObjectSpace.memsize_of(Bitmap.new(100, 100, PixelFormat.Format24bppRGB)), :<, 100 * 100 * 4)
+  end
 end
 
 __END__
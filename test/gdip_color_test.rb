@@ -361,6 +361,30 @@ class GdiplusColorTest < Test::Unit::TestCase
     assert_equal(0xFF9ACD32, Color.YellowGreen.to_i)
   end
 
+  def test_color_flyweight
+    assert(Color.Red.frozen?)
+    assert_raise(defined?(FrozenError) ? FrozenError : RuntimeError) { Color.Red.send(:initialize, 0) }
+    assert_same(Color.Red, Pen.new(Color.new(255, 0, 0)).Color)
+    assert_same(Color.Aqua, SolidBrush.new(Color.Cyan).Color)
+    color = Pen.new(Color.new(1, 2, 3)).Color
+    assert(!color.frozen?)
+    assert_equal(Color.new(1, 2, 3), color)
+  end
+
+  def test_color_symbol
+    assert_same(Color.Red, Pen.new(:Red, 2).Color)
+    assert_same(Color.Aqua, SolidBrush.new(:Cyan).Color)
+  end
+
+  def test_color_lazy_constant
+    assert(Color.respond_to?(:MediumOrchid))
+    assert_same(Color::MediumOrchid, Color.MediumOrchid)
+    assert(Color.const_defined?(:MediumOrchid))
+    assert_same(Color.const_get(:Orchid), Color.Orchid)
+    assert_raise(NameError) { Color::NoSuchColor }
+    assert_raise(NoMethodError) { Color.NoSuchColor }
+  end
+
 
 end
 
@@ -0,0 +1,63 @@
+# coding: utf-8
+require 'test_helper'
+
+class GdiplusCommandBufferTest < Test::Unit::TestCase
+  include Gdiplus
+
+  def test_command_buffer
+    buf = Graphics::CommandBuffer.new
+    assert_equal(0, buf.size)
+    assert_same(buf, buf.DrawLine(Pens.Red, 0, 0, 100, 100))
+    assert_same(buf, buf.DrawRectangle(Pens.Blue, 10, 10, 50.5, 50))
+    assert_same(buf, buf.FillRectangle(Brushes.Green, 10, 10, 20, 20))
+    assert_same(buf, buf.DrawEllipse(Pens.Red, 10, 10, 20, 20))
+    assert_same(buf, buf.FillEllipse(Brushes.Red, 10, 10, 20, 20))
+    assert_same(buf, buf.DrawArc(Pens.Red, 10, 10, 20, 20, 0, 90))
+    assert_same(buf, buf.DrawPie(Pens.Red, 10, 10, 20, 20, 0, 90))
+    assert_same(buf, buf.FillPie(Brushes.Red, 10, 10, 20, 20, 0, 90))
+    assert_equal(8, buf.size)
+
+    assert_raise(TypeError) { buf.DrawLine(Brushes.Red, 0, 0, 1, 1) }
+    assert_raise(TypeError) { buf.FillRectangle(Pens.Red, 0, 0, 1, 1) }
+    assert_raise(ArgumentError) { buf.DrawLine(Pens.Red, 0, 0, 1) }
+    assert_raise(TypeError) { buf.DrawLine(Pens.Red, 0, 0, 1, "1") }
+    assert_equal(8, buf.size)
+
+    bmp = Bitmap.new(100, 100)
+    bmp.draw {|g|
+      assert_same(g, g.execute(buf))
+      assert_raise(TypeError) { g.execute([]) }
+    }
+
+    assert_same(buf, buf.clear)
+    assert_equal(0, buf.size)
+    bmp.draw {|g|
+      assert_same(g, g.execute(buf))
+    }
+  end
+end
+
+__END__
+#assert_equal(expected, actual, message=nil)
+#assert_raise(expected_exception_klass, message="") { ... }
+#assert_not_equal(expected, actual, message="")
+#assert_instance_of(klass, object, message="")
+#assert_kind_of(klass, object, message="")
+#assert_nil(object, message="")
+#assert_not_nil(object, message="")
+#assert_respond_to(object, method, message="")
+#assert_match(regexp, string, message="")
+#assert_no_match(regexp, string, message="")
+#_assert_output(stdout=nil, stderr=nil, verbose=nil) { ... }
+#_assert_silent(verbose=nil) { ... }
+#_assert_stderr(stderr, verbose=nil) { ... }
+#_assert_stderr_silent(verbose=nil) { ... }
+#_assert_stdout(stdout, verbose=nil) { ... }
+#_assert_stdout_silent(verbose=nil) { ... }
+#assert_same(expected, actual, message="")
+#assert_not_same(expected, actual, message="")
+#assert_operator(object1, operator, object2, message="")
+#assert_nothing_raised(klass1, klass2, ..., message = "") { ... } # klass1, klass2, ... => fail / others => error
+#assert_block(message="assert_block failed.") { ... } # (block -> true) => pass
+#assert_throws(expected_symbol, message="") { ... }
+#assert_nothing_thrown(message="") { ... }
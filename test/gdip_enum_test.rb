@@ -774,6 +774,41 @@ class GdiplusEnumIntTest < Test::Unit::TestCase
     assert_match(/AltGray/, ColorMatrixFlag.AltGray.inspect)
   end
 
+  def test_ImageLockMode
+    assert_equal(1, ImageLockMode.ReadOnly.to_i)
+    assert_match(/ReadOnly/, ImageLockMode.ReadOnly.inspect)
+    assert_equal(2, ImageLockMode.WriteOnly.to_i)
+    assert_match(/WriteOnly/, ImageLockMode.WriteOnly.inspect)
+    assert_equal(3, ImageLockMode.ReadWrite.to_i)
+    assert_match(/ReadWrite/, ImageLockMode.ReadWrite.inspect)
+    assert_equal(4, ImageLockMode.UserInputBuffer.to_i)
+    assert_match(/UserInputBuffer/, ImageLockMode.UserInputBuffer.inspect)
+  end
+
+  def test_interned
+    assert(SmoothingMode.AntiAlias.frozen?)
+    pen = Pen.new(Color.Red)
+    pen.LineJoin = LineJoin.Round
+    assert_same(LineJoin.Round, pen.LineJoin)
+    assert_same(PixelFormat.Format32bppARGB, Bitmap.new(1, 1).PixelFormat)
+    bold_italic = FontStyle.Bold | FontStyle.Italic
+    assert(bold_italic.frozen?)
+    assert_same(bold_italic, FontStyle.Italic | FontStyle.Bold)
+    assert_same(FontStyle.Bold, bold_italic & FontStyle.Bold)
+    assert_equal(3, bold_italic.to_i)
+  end
+
+  def test_symbol_argument
+    pen = Pen.new(Color.Red)
+    pen.LineJoin = :Bevel
+    assert_same(LineJoin.Bevel, pen.LineJoin)
+    Bitmap.new(1, 1).draw {|g|
+      g.SmoothingMode = :AntiAlias8x4
+      assert_equal(SmoothingMode.AntiAlias8x4, g.SmoothingMode)
+    }
+    assert_raise(TypeError) { pen.LineJoin = :NoSuchJoin }
+  end
+
 end
 
 __END__
@@ -0,0 +1,111 @@
+# coding: utf-8
+require 'test_helper'
+
+class GdiplusGeometryArrayTest < Test::Unit::TestCase
+  include Gdiplus
+
+  def test_pointf_array
+    points = PointFArray.new
+    assert_equal(0, points.size)
+    assert_nil(points.bounds)
+    assert_same(points, points << PointF.new(1.0, 2.0))
+    assert_same(points, points << Point.new(3, 4))
+    assert_same(points, points.concat([5.0, 6.0, 7, 8]))
+    assert_same(points, points.concat([9.0, 10.0].pack('f*')))
+    assert_equal(5, points.length)
+    assert_raise(TypeError) { points << 1.0 }
+    assert_raise(ArgumentError) { points.concat([1.0, 2.0, 3.0]) }
+    assert_raise(TypeError) { points.concat([PointF.new(1.0, 2.0), :bad]) }
+    assert_equal(5, points.length)
+
+    assert_equal(PointF.new(1.0, 2.0), points[0])
+    assert_equal(PointF.new(9.0, 10.0), points[-1])
+    assert_nil(points[5])
+    assert_equal([PointF.new(3.0, 4.0), PointF.new(5.0, 6.0)], points[1, 2].to_a)
+    assert_equal([PointF.new(7.0, 8.0), PointF.new(9.0, 10.0)], points[3..-1].to_a)
+    points[0] = PointF.new(0.0, 0.0)
+    assert_equal(PointF.new(0.0, 0.0), points.first)
+    assert_raise(IndexError) { points[10] = PointF.new(0.0, 0.0) }
+    assert_equal([0.0, 0.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0], points.bytes.unpack('f*'))
+    assert_equal(5, points.map { |po| po.x }.size)
+
+    assert_same(points, points.Translate(1, 1))
+    assert_same(points, points.scale(2.0, 3.0))
+    assert_equal(PointF.new(2.0, 3.0), points[0])
+    assert_equal(RectangleF.new(2.0, 3.0, 18.0, 30.0), points.GetBounds)
+
+    copy = PointFArray.new(points)
+    assert_same(copy, copy.clear)
+    assert_equal(0, copy.size)
+    assert_equal(5, points.size)
+  end
+
+  def test_pointf_array_drawing
+    points = PointFArray.new([10.0, 10.0, 100.0, 20.0, 50.0, 90.0, 10.0, 10.0])
+    bmp = Bitmap.new(100, 100)
+    bmp.draw { |g|
+      assert_same(g, g.DrawLines(Pens.Black, points))
+      assert_same(g, g.DrawPolygon(Pens.Black, points))
+      assert_same(g, g.FillPolygon(Brushes.Red, points))
+      assert_same(g, g.DrawBeziers(Pens.Black, points))
+      assert_same(g, g.DrawCurve(Pens.Black, points))
+    }
+    gp = GraphicsPath.new
+    assert_same(gp, gp.AddLines(points))
+    assert_equal(4, gp.PointCount)
+
+    matrix = Matrix.new.Translate(10, 20)
+    moved = matrix.TransformPoints(points)
+    assert_instance_of(PointFArray, moved)
+    assert_equal(PointF.new(20.0, 30.0), moved[0])
+    assert_equal(PointF.new(10.0, 10.0), points[0])
+    assert_same(points, matrix.TransformPoints!(points))
+    assert_equal(PointF.new(20.0, 30.0), points[0])
+    assert_raise(TypeError) { matrix.TransformPoints!([PointF.new(0.0, 0.0)]) }
+  end
+
+  def test_rectf_array
+    rects = RectFArray.new([RectangleF.new(0.0, 0.0, 10.0, 10.0), Rectangle.new(20, 20, 5, 5)])
+    assert_same(rects, rects.concat([30.0, 0.0, 10.0, 40.0]))
+    assert_equal(3, rects.size)
+    assert_raise(ArgumentError) { rects.concat([1.0, 2.0]) }
+    assert_equal(RectangleF.new(20.0, 20.0, 5.0, 5.0), rects[1])
+    assert_equal(RectangleF.new(0.0, 0.0, 40.0, 40.0), rects.bounds)
+    rects.Translate(1, 2)
+    assert_equal(RectangleF.new(1.0, 2.0, 10.0, 10.0), rects[0])
+
+    bmp = Bitmap.new(100, 100)
+    bmp.draw { |g|
+      assert_same(g, g.DrawRectangles(Pens.Black, rects))
+      assert_same(g, g.FillRectangles(Brushes.Red, rects))
+    }
+    gp = GraphicsPath.new
+    assert_same(gp, gp.AddRectangles(rects))
+    assert_equal(12, gp.PointCount)
+  end
+end
+
+__END__
+#assert_equal(expected, actual, message=nil)
+#assert_raise(expected_exception_klass, message="") { ... }
+#assert_not_equal(expected, actual, message="")
+#assert_instance_of(klass, object, message="")
+#assert_kind_of(klass, object, message="")
+#assert_nil(object, message="")
+#assert_not_nil(object, message="")
+#assert_respond_to(object, method, message="")
+#assert_match(regexp, string, message="")
+#assert_no_match(regexp, string, message="")
+#_assert_output(stdout=nil, stderr=nil, verbose=nil) { ... }
+#_assert_silent(verbose=nil) { ... }
+#_assert_stderr(stderr, verbose=nil) { ... }
+#_assert_stderr_silent(verbose=nil) { ... }
+#_assert_stdout(stdout, verbose=nil) { ... }
+#_assert_stdout_silent(verbose=nil) { ... }
+#assert_same(expected, actual, message="")
+#assert_not_same(expected, actual, message="")
+#assert_operator(object1, operator, object2, message="")
+#assert_nothing_raised(klass1, klass2, ..., message = "") { ... } # klass1, klass2, ... => fail / others => error
+#assert_block(message="assert_block failed.") { ... } # (block -> true) => pass
+#assert_throws(expected_symbol, message="") { ... }
+#assert_nothing_thrown(message="") { ... }
@@ -281,6 +281,14 @@ class GdiplusGraphicsTest < Test::Unit::TestCase
     draw("DrawLinesF") { |g|
       assert_same(g, g.DrawLines(Pens.Black, pointsF))
     }
+    draw("DrawLinesPacked") { |g|
+      assert_same(g, g.DrawLines(Pens.Black, pointsI.flat_map { |po| [po.x, po.y] }))
+      assert_same(g, g.DrawLines(Pens.Black, pointsF.flat_map { |po| [po.x, po.y] }.pack('f*')))
+      assert_same(g, g.DrawPolygon(Pens.Black, pointsF.flat_map { |po| [po.x, po.y] }))
+      assert_same(g, g.FillPolygon(Brushes.Red, pointsI.flat_map { |po| [po.x, po.y] }))
+    }
+    assert_raise(ArgumentError) { Bitmap.new(10, 10).draw { |g| g.DrawLines(Pens.Black, [0, 0, 1]) } }
+    assert_raise(ArgumentError) { Bitmap.new(10, 10).draw { |g| g.DrawLines(Pens.Black, "\0" * 12) } }
 
     # DrawPath
     path = GraphicsPath.new
@@ -1171,6 +1179,49 @@ class GdiplusGraphicsTest < Test::Unit::TestCase
 
   end
 
+  def test_disposed_brush
+    brush = SolidBrush.new(Color.Red)
+    brush.dispose
+    font = Font.new("Arial", 20)
+    draw { |g|
+      assert_raise_message(/Brush object does not exist/i) { g.FillEllipse(brush, 10, 10, 50, 50) }
+      assert_raise_message(/Brush object does not exist/i) { g.DrawString("TEST", font, brush, 20, 20) }
+    }
+  end
+
+  def test_draw_image_threads
+    # a source used by a DrawImage running without the GVL is busy, so each thread has its own
+    srcs = Array.new(4) { bmp2 }
+    threads = srcs.map {|src|
+      Thread.new {
+        dst = Bitmap.new(128, 128)
+        dst.draw {|g|
+          g.DrawImage(src, Rectangle.new(0, 0, 128, 128), Rectangle.new(0, 0, 512, 512), GraphicsUnit.Pixel)
+        }
+        dst.to_blob(ImageFormat.Png)
+      }
+    }
+    threads.each {|t|
+      assert_match(/\A\x89PNG/n, t.value)
+    }
+
+    src = srcs.first
+    shared = Array.new(4) {
+      Thread.new {
+        begin
+          dst = Bitmap.new(128, 128)
+          dst.draw {|g| g.DrawImage(src, Rectangle.new(0, 0, 128, 128), Rectangle.new(0, 0, 512, 512), GraphicsUnit.Pixel) }
+          :ok
+        rescue GdiplusError => e
+          e.message
+        end
+      }
+    }
+    shared.each {|t|
+      assert_include([:ok, "The object is being used by another thread."], t.value)
+    }
+  end
+
 end
 
 __END__
@@ -123,6 +123,10 @@ class GdiplusGraphicsPathTest < Test::Unit::TestCase
     gp = GraphicsPath.new
     assert_same(gp, gp.AddLines(POINTS1))
     assert_same(gp, gp.add_lines(POINTS1))
+    gp = GraphicsPath.new
+    assert_same(gp, gp.AddLines([0, 0, 100, 0, 100, 100]))
+    assert_same(gp, gp.AddLines([0.0, 0.0, 50.0, 50.0].pack('f*')))
+    assert_equal(5, gp.PointCount)
 
     # AddPath
     gp2 = GraphicsPath.new
@@ -298,6 +302,14 @@ class GdiplusGraphicsPathTest < Test::Unit::TestCase
     assert_same(gp, gp.Flatten(nil, 3.0))
   end
 
+  def test_memsize
+    require 'objspace'
+    path = GraphicsPath.new
+    empty = ObjectSpace.memsize_of(path)
+    path.AddLines((0...100).map {|i| Point.new(i, i * 2) })
+    assert_operator(ObjectSpace.memsize_of(path), :>=, empty + 100 * 9)
+  end
+
 end
 
 __END__
@@ -92,6 +92,73 @@ class GdiplusImageTest < Test::Unit::TestCase
     end
   end
 
+  def test_image_to_blob
+    bmp = Bitmap.new(2, 2)
+    IMGFMT_SIGPAT_MAP.each {|imgfmt, patterns|
+      blob = bmp.to_blob(imgfmt)
+      assert(patterns.any?{|pat| blob[0, pat.size] == pat })
+    }
+    encprms = EncoderParameters.new
+    encprms.add(EncoderParameterQuality.new(80))
+    buf = String.new
+    blob = bmp.to_blob(ImageFormat.Jpeg, encprms, buf)
+    assert_same(buf, blob)
+    assert_equal(Encoding::ASCII_8BIT, blob.encoding) if blob.respond_to?(:encoding)
+    assert_equal(bmp.Width, Bitmap.from_bytes(blob).Width)
+    assert_same(buf, bmp.to_blob(ImageFormat.Png, nil, buf))
+    assert_equal(IMGFMT_SIGPAT_MAP[ImageFormat.Png].first, buf[0, 8])
+    assert_raise(TypeError) { bmp.to_blob(encprms) }
+    assert_raise(ArgumentError) { bmp.to_blob }
+
+    # a String made by to_blob is trimmed; a given buffer keeps its capacity
+    require 'objspace'
+    assert_operator(ObjectSpace.memsize_of(bmp.to_blob(ImageFormat.Png)), :<, 0x1000)
+    assert_operator(ObjectSpace.memsize_of(buf), :>=, 0x1000)
+  end
+
+  def test_image_to_blob_shared_buffer
+    images = Array.new(2) { Bitmap.new(1000, 1000) }
+    buf = String.new
+    results = images.map {|img|
+      Thread.new {
+        begin
+          img.to_blob(ImageFormat.Png, nil, buf)
+          :ok
+        rescue RuntimeError => e
+          assert_match(/locked/, e.message)
+          :locked
+        end
+      }
+    }.map(&:value)
+    assert(results.include?(:ok))
+
+    t = Thread.new { images[0].to_blob(ImageFormat.Png, nil, buf) }
+    begin
+      buf.replace("x" * 100)
+    rescue RuntimeError => e
+      assert_match(/locked/, e.message)
+    end
+    t.join
+    assert_equal(1000, Bitmap.from_bytes(buf).Width) if buf.bytesize > 100
+  end
+
+  def test_image_save_io
+    bmp = Bitmap.new(1, 1)
+    savename = "test_image_save_io.png"
+    File.open(savename, "wb") {|f| bmp.save(f) }
+    begin
+      head = File.open(savename, "rb") {|f| f.read(8) }
+      assert_equal(IMGFMT_SIGPAT_MAP[ImageFormat.Png].first, head)
+    ensure
+      File.delete(savename)
+    end
+    require 'stringio'
+    io = StringIO.new(String.new)
+    bmp.save(io, ImageFormat.Gif)
+    assert_match(/\AGIF8/n, io.string)
+    assert_raise(ArgumentError) { bmp.save(StringIO.new(String.new)) }
+  end
+
   def test_image_properties
     bmp = Bitmap.new(40, 30)
     assert_equal(40, bmp.Width)
@@ -102,6 +169,52 @@ class GdiplusImageTest < Test::Unit::TestCase
     assert_equal(ImageFormat.MemoryBmp, bmp.RawFormat)
   end
 
+  def test_image_draw
+    bmp = Bitmap.new(8, 8)
+    saved = nil
+    assert_same(bmp, bmp.draw {|g| saved = g; g.Clear(Color.Red) })
+    # the Graphics is deleted when the block exits
+    assert_raise(GdiplusError) { saved.Clear(Color.Blue) }
+    assert_same(bmp, bmp.draw)
+
+    g1 = g2 = mode = nil
+    bmp.draw(keep_graphics: true) {|g|
+      g1 = g
+      mode = g.SmoothingMode
+      g.SmoothingMode = SmoothingMode.AntiAlias
+    }
+    bmp.draw(keep_graphics: true) {|g|
+      g2 = g
+      # the state of the previous frame is restored
+      assert_equal(mode, g.SmoothingMode)
+    }
+    assert_same(g1, g2)
+    assert_nothing_raised { g1.Clear(Color.Blue) }
+
+    # drawing without keep_graphics releases the kept one
+    bmp.draw {|g| assert_same(g1, g) }
+    assert_raise(GdiplusError) { g1.Clear(Color.Blue) }
+    bmp.draw {|g| assert_not_same(g1, g) }
+  end
+
+  def test_image_dispose_in_use
+    bmp = Bitmap.new(8, 8)
+    g = Graphics.FromImage(bmp)
+    assert_raise(GdiplusError) { bmp.dispose }
+    assert_nothing_raised { g.dispose }
+
+    bmp.draw { assert_raise(GdiplusError) { bmp.dispose } }
+    bmp.draw(keep_graphics: true) {}
+    bmp.dispose
+    assert_raise(GdiplusError) { bmp.Width }
+
+    bmp = Bitmap.new(8, 8)
+    bmpdata = bmp.LockBits(nil, ImageLockMode.ReadOnly, PixelFormat.Format32bppARGB)
+    assert_raise(GdiplusError) { bmp.dispose }
+    bmp.UnlockBits(bmpdata)
+    assert_nothing_raised { bmp.dispose }
+  end
+
 
 
 end
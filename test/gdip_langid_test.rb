@@ -1416,4 +1416,14 @@ class GdiplusLangIdTest < Test::Unit::TestCase
     assert_equal(0x7c04, LangId.new("zh-CHT").to_i)
   end
 
+  def test_lazy_method
+    assert(LangId.respond_to?(:ja_JP))
+    assert(!LangId.respond_to?(:ja_jp))
+    assert_equal(0x0411, LangId.ja_JP.to_i)
+    assert(LangId.singleton_methods.include?(:ja_JP)) if RUBY_VERSION >= "1.9"
+    assert_equal(0x0411, LangId.ja_JP.to_i)
+    assert_raise(NoMethodError) { LangId.ja_jp }
+    assert_raise(NoMethodError) { LangId.no_SUCH }
+  end
+
 end
@@ -0,0 +1,85 @@
+# coding: utf-8
+require 'test_helper'
+
+class GdiplusLiveObjectsTest < Test::Unit::TestCase
+  include Gdiplus
+
+  def teardown
+    Gdiplus.track_objects = false
+  end
+
+  def test_track_objects
+    assert(!Gdiplus.track_objects?)
+    bmp = Bitmap.new(10, 10)
+    assert(Gdiplus.live_objects.none? {|obj| obj[:address] >> 1 == bmp.gdiplus_id })
+
+    Gdiplus.track_objects = true
+    assert(Gdiplus.track_objects?)
+    bmp = Bitmap.new(10, 10)
+    obj = Gdiplus.live_objects.last
+    assert_equal("Bitmap", obj[:type])
+    assert_equal(bmp.gdiplus_id, obj[:address] >> 1)
+    assert_operator(obj[:size], :>=, 10 * 10 * 4)
+    assert_kind_of(Time, obj[:created_at])
+    assert_match(/#{File.basename(__FILE__)}:#{__LINE__ - 6}/, obj[:backtrace].join("\n"))
+
+    count = Gdiplus.live_objects.size
+    bmp.dispose
+    assert_equal(count - 1, Gdiplus.live_objects.size)
+  end
+
+  def test_group_by
+    Gdiplus.track_objects = true
+    pens = Array.new(3) { Pen.new(Color.Red, 2) }
+    by_type = Gdiplus.live_objects(group_by: :type)
+    assert_operator(by_type["Pen"][:count], :>=, 3)
+    assert_kind_of(Integer, by_type["Pen"][:size])
+
+    by_backtrace = Gdiplus.live_objects(group_by: :backtrace)
+    assert(by_backtrace.any? {|bt, group| bt.first =~ /#{File.basename(__FILE__)}/ && group[:count] == 3 })
+    assert_raise(ArgumentError) { Gdiplus.live_objects(group_by: :size) }
+    pens.each(&:dispose)
+  end
+
+  def test_dump_live_objects
+    require 'json'
+    require 'stringio'
+    Gdiplus.track_objects = true
+    bmp = Bitmap.new(10, 10)
+    lines = Gdiplus.dump_live_objects.lines
+    obj = JSON.parse(lines.last)
+    assert_equal("Bitmap", obj["type"])
+    assert_match(/\A0x\h+\z/, obj["address"])
+    assert_kind_of(Array, obj["backtrace"])
+
+    io = StringIO.new
+    assert_same(io, Gdiplus.dump_live_objects(io))
+    assert_equal(lines.join, io.string)
+    bmp.dispose
+  end
+end
+
+__END__
+#assert_equal(expected, actual, message=nil)
+#assert_raise(expected_exception_klass, message="") { ... }
+#assert_not_equal(expected, actual, message="")
+#assert_instance_of(klass, object, message="")
+#assert_kind_of(klass, object, message="")
+#assert_nil(object, message="")
+#assert_not_nil(object, message="")
+#assert_respond_to(object, method, message="")
+#assert_match(regexp, string, message="")
+#assert_no_match(regexp, string, message="")
+#_assert_output(stdout=nil, stderr=nil, verbose=nil) { ... }
+#_assert_silent(verbose=nil) { ... }
+#_assert_stderr(stderr, verbose=nil) { ... }
+#_assert_stderr_silent(verbose=nil) { ... }
+#_assert_stdout(stdout, verbose=nil) { ... }
+#_assert_stdout_silent(verbose=nil) { ... }
+#assert_same(expected, actual, message="")
+#assert_not_same(expected, actual, message="")
+#assert_operator(object1, operator, object2, message="")
+#assert_nothing_raised(klass1, klass2, ..., message = "") { ... } # klass1, klass2, ... => fail / others => error
+#assert_block(message="assert_block failed.") { ... } # (block -> true) => pass
+#assert_throws(expected_symbol, message="") { ... }
+#assert_nothing_thrown(message="") { ... }
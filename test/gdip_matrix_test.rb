@@ -144,6 +144,14 @@ class GdiplusMatrixTest < Test::Unit::TestCase
     r = 100.0 * sqrt(2)
     compare_single_array(points2.map { |po| po.x }, [200.0, 200.0 + r, 200.0, 200.0 - r], 0.0001)
 
+    packed = points.flat_map { |po| [po.x, po.y] }
+    compare_single_array(points2.flat_map { |po| [po.x, po.y] }, matrix.TransformPoints(packed), 0.0001)
+    compare_single_array(points2.flat_map { |po| [po.x, po.y] }, matrix.TransformPoints(packed.pack('f*')).unpack('f*'), 0.0001)
+    assert_equal([10, 20], Matrix.new.Translate(10, 20).TransformPoints([0, 0]))
+    # any Float makes the packed points PointF, not only the first element
+    assert_equal([10.5, 20.0], Matrix.new.Translate(10.5, 20).TransformPoints([0, 0.0]).map { |v| v.round(3) })
+    assert_raise(TypeError) { Matrix.new.TransformPoints([0, 0, 1, "1"]) }
+
     # VectorTransformPoints (TransformVectors)
     points = []
     points << PointF.new(100.0, 100.0)
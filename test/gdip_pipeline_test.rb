@@ -0,0 +1,78 @@
+# coding: utf-8
+require 'test_helper'
+
+class GdiplusPipelineTest < Test::Unit::TestCase
+  include Gdiplus
+
+  SRC = "test/gdip_bitmap_test1.png"
+
+  def test_thumbnail_files
+    outputs = ["test_pipeline1.png", "test_pipeline2.jpg"]
+    results = Pipeline.thumbnail([[SRC, outputs[0]], [SRC, outputs[1]], ["not_found.png", "test_pipeline3.png"]], size: 100, threads: 2)
+    begin
+      assert_equal(3, results.size)
+      assert_instance_of(Pipeline::Result, results[0])
+      assert(results[0].ok?)
+      assert_equal(SRC, results[0].input)
+      assert_equal(outputs[0], results[0].output)
+      assert_equal(:Ok, results[1].status)
+      assert_nil(results[0].data)
+      assert_kind_of(Float, results[0].decode_time)
+      assert_kind_of(Float, results[0].resize_time)
+      assert_kind_of(Float, results[0].encode_time)
+      assert(!results[2].ok?)
+      assert(!FileTest.exist?("test_pipeline3.png"))
+
+      bmp = Bitmap.FromBytes(File.binread(outputs[0]))
+      assert_equal([100, 100], [bmp.Width, bmp.Height])
+      assert(FileTest.exist?(outputs[1]))
+    ensure
+      outputs.each {|f| File.delete(f) if FileTest.exist?(f) }
+    end
+  end
+
+  def test_thumbnail_blob
+    results = Pipeline.thumbnail([SRC] * 5, size: [40, 20], format: ImageFormat.Png, threads: 3)
+    assert_equal(5, results.size)
+    results.each {|r|
+      assert(r.ok?)
+      assert_nil(r.output)
+      assert_equal(Encoding::ASCII_8BIT, r.data.encoding)
+      bmp = Bitmap.FromBytes(r.data)
+      assert_equal([20, 20], [bmp.Width, bmp.Height])
+    }
+    jpg = Pipeline.thumbnail([SRC], size: 50, format: ImageFormat.Jpeg, quality: 50).first
+    assert_equal("\xFF\xD8".force_encoding(Encoding::ASCII_8BIT), jpg.data[0, 2])
+
+    assert_equal([], Pipeline.thumbnail([], size: 10))
+    assert_raise(ArgumentError) { Pipeline.thumbnail([SRC]) }
+    assert_raise(ArgumentError) { Pipeline.thumbnail([SRC], size: 10) }
+    assert_raise(ArgumentError) { Pipeline.thumbnail([SRC], size: 0, format: ImageFormat.Png) }
+    assert_raise(TypeError) { Pipeline.thumbnail([1], size: 10, format: ImageFormat.Png) }
+  end
+end
+
+__END__
+#assert_equal(expected, actual, message=nil)
+#assert_raise(expected_exception_klass, message="") { ... }
+#assert_not_equal(expected, actual, message="")
+#assert_instance_of(klass, object, message="")
+#assert_kind_of(klass, object, message="")
+#assert_nil(object, message="")
+#assert_not_nil(object, message="")
+#assert_respond_to(object, method, message="")
+#assert_match(regexp, string, message="")
+#assert_no_match(regexp, string, message="")
+#_assert_output(stdout=nil, stderr=nil, verbose=nil) { ... }
+#_assert_silent(verbose=nil) { ... }
+#_assert_stderr(stderr, verbose=nil) { ... }
+#_assert_stderr_silent(verbose=nil) { ... }
+#_assert_stdout(stdout, verbose=nil) { ... }
+#_assert_stdout_silent(verbose=nil) { ... }
+#assert_same(expected, actual, message="")
+#assert_not_same(expected, actual, message="")
+#assert_operator(object1, operator, object2, message="")
+#assert_nothing_raised(klass1, klass2, ..., message = "") { ... } # klass1, klass2, ... => fail / others => error
+#assert_block(message="assert_block failed.") { ... } # (block -> true) => pass
+#assert_throws(expected_symbol, message="") { ... }
+#assert_nothing_thrown(message="") { ... }
@@ -20,6 +20,17 @@ class GdiplusRectangleTest < Test::Unit::TestCase
     assert_not_equal(0, po)
   end
 
+  def test_value_objects_gc
+    points = Array.new(1000) {|i| PointF.new(i.to_f, -i.to_f) }
+    rects = Array.new(1000) {|i| Rectangle.new(i, i, 2, 3) }
+    GC.start
+    GC.compact if GC.respond_to?(:compact)
+    assert_equal(PointF.new(999.0, -999.0), points.last)
+    assert_equal(Rectangle.new(500, 500, 2, 3), rects[500])
+    rects[1].X = 7
+    assert_equal(7, rects[1].X)
+  end
+
   def test_PointF
     assert_instance_of(PointF, PointF.new)
     assert_instance_of(PointF, PointF.new(100.0, -100.0))
@@ -0,0 +1,87 @@
+# coding: utf-8
+require 'test_helper'
+
+class GdiplusStatsTest < Test::Unit::TestCase
+  include Gdiplus
+
+  def setup
+    Stats.reset
+  end
+
+  def teardown
+    Stats.disable
+    Stats.reset
+  end
+
+  def test_disabled
+    assert(!Stats.enabled?)
+    bmp = Bitmap.new(10, 10)
+    bmp.draw {|g| g.DrawImage(Bitmap.new(5, 5), 0, 0) }
+    assert_equal({}, Stats.to_h)
+  end
+
+  def test_to_h
+    Stats.enable
+    assert(Stats.enabled?)
+    bmp = Bitmap.new(10, 10)
+    src = Bitmap.new(5, 5)
+    bmp.draw {|g|
+      g.DrawImage(src, 0, 0)
+      g.draw_image(src, 1, 1)
+    }
+    Stats.disable
+    bmp.draw {|g| g.DrawImage(src, 0, 0) }
+
+    stats = Stats.to_h
+    draw = stats["Gdiplus::Graphics#DrawImage"]
+    assert_equal(2, draw[:calls])
+    assert_kind_of(Float, draw[:time])
+    assert_equal(Stats::BUCKET_USEC.size, draw[:histogram].size)
+    assert_equal(2, draw[:histogram].inject(:+))
+    assert_equal({}, draw[:failures])
+    assert_equal(2, stats["Gdiplus::Bitmap#initialize"][:calls])
+  end
+
+  def test_failures
+    Stats.enable
+    assert_raise(GdiplusError) { Bitmap.new("not_found.png") }
+    init = Stats.to_h["Gdiplus::Bitmap#initialize"]
+    assert_equal(1, init[:calls])
+    assert_equal(1, init[:failures].values.inject(:+))
+  end
+
+  def test_to_prometheus
+    Stats.enable
+    Bitmap.new(10, 10).draw {|g| g.DrawImage(Bitmap.new(5, 5), 0, 0) }
+    text = Stats.to_prometheus
+    assert_match(/^# TYPE gdiplus_call_duration_seconds histogram$/, text)
+    assert_match(/^gdiplus_call_duration_seconds_bucket\{binding="Gdiplus::Graphics#DrawImage",le="\+Inf"\} 1$/, text)
+    assert_match(/^gdiplus_call_duration_seconds_count\{binding="Gdiplus::Graphics#DrawImage"\} 1$/, text)
+    assert_match(/^# TYPE gdiplus_call_failures_total counter$/, text)
+  end
+end
+
+__END__
+#assert_equal(expected, actual, message=nil)
+#assert_raise(expected_exception_klass, message="") { ... }
+#assert_not_equal(expected, actual, message="")
+#assert_instance_of(klass, object, message="")
+#assert_kind_of(klass, object, message="")
+#assert_nil(object, message="")
+#assert_not_nil(object, message="")
+#assert_respond_to(object, method, message="")
+#assert_match(regexp, string, message="")
+#assert_no_match(regexp, string, message="")
+#_assert_output(stdout=nil, stderr=nil, verbose=nil) { ... }
+#_assert_silent(verbose=nil) { ... }
+#_assert_stderr(stderr, verbose=nil) { ... }
+#_assert_stderr_silent(verbose=nil) { ... }
+#_assert_stdout(stdout, verbose=nil) { ... }
+#_assert_stdout_silent(verbose=nil) { ... }
+#assert_same(expected, actual, message="")
+#assert_not_same(expected, actual, message="")
+#assert_operator(object1, operator, object2, message="")
+#assert_nothing_raised(klass1, klass2, ..., message = "") { ... } # klass1, klass2, ... => fail / others => error
+#assert_block(message="assert_block failed.") { ... } # (block -> true) => pass
+#assert_throws(expected_symbol, message="") { ... }
+#assert_nothing_thrown(message="") { ... }
@@ -12,6 +12,113 @@ class GdiplusTest < Test::Unit::TestCase
     assert_not_nil(::Gdiplus::GdiplusError)
     #
   end
+
+  def test_dispose
+    bmp = Bitmap.new(10, 10)
+    assert(!bmp.disposed?)
+    assert_nil(bmp.dispose)
+    assert(bmp.disposed?)
+    assert_nothing_raised { bmp.close }
+    assert_raise(GdiplusError) { bmp.Width }
+    assert_raise(GdiplusError) { Bitmap.new(10, 10).draw {|g| g.DrawImage(bmp, 0, 0) } }
+
+    pen = Pen.new(Color.Red)
+    pen.Dispose
+    assert_raise(GdiplusError) { Bitmap.new(10, 10).draw {|g| g.DrawLine(pen, 0, 0, 5, 5) } }
+    assert_raise(defined?(FrozenError) ? FrozenError : RuntimeError) { Pens.Red.dispose }
+
+    bmp = Bitmap.new(10, 10)
+    bmp.draw(keep_graphics: true) {|g| }
+    bmp.dispose
+    assert(bmp.disposed?)
+  end
+
+  def test_open
+    saved = nil
+    r = Bitmap.open(20, 10) {|bmp|
+      saved = bmp
+      assert_equal(20, bmp.Width)
+      :result
+    }
+    assert_equal(:result, r)
+    assert(saved.disposed?)
+    assert(!Bitmap.open(20, 10).disposed?)
+
+    font = nil
+    Font.open("Arial", 12) {|f| font = f }
+    assert(font.disposed?)
+
+    Graphics.FromImage(Bitmap.new(10, 10)) {|g|
+      saved = g
+      g.Clear(Color.Red)
+    }
+    assert(saved.disposed?)
+    assert_kind_of(Graphics, Graphics.from_image(Bitmap.new(10, 10)))
+  end
+
+  def test_gc_compact
+    return unless GC.respond_to?(:compact)
+    png = File.binread("test/gdip_bitmap_test1.png")
+    width = Bitmap.new("test/gdip_bitmap_test1.png").Width
+    path = GraphicsPath.new
+    path.AddRectangle(Rectangle.new(0, 0, 10, 10))
+    pathdata = path.PathData
+    buf = Graphics::CommandBuffer.new
+    buf.DrawLine(Pens.Red, 0, 0, 10, 10)
+    buf.FillRectangle(Brushes.Blue, 0, 0, 5, 5)
+    prms = EncoderParameters.new
+    prms.add(EncoderParameter.new(Encoder.Quality, 50))
+    tiny = Bitmap.new(1, 1).to_blob(ImageFormat.Gif)
+
+    compactor = Thread.new { 10.times { GC.compact; Thread.pass } }
+    30.times {|i|
+      Array.new(100) { "garbage" * (i % 5) }
+      bmp = Bitmap.new(20, 20)
+      bmp.draw {|g| g.execute(buf) }
+      pixel = bmp.LockBits(Rectangle.new(1, 3, 1, 1), ImageLockMode.ReadOnly, PixelFormat.Format32bppARGB) {|bmpdata|
+        bmpdata.bytes.unpack('V')
+      }
+      assert_equal([0xff0000ff], pixel)
+      assert_equal(width, Bitmap.from_bytes(png.dup).Width)
+      assert_equal(1, Bitmap.from_bytes(tiny.dup).Width)
+      assert_kind_of(String, bmp.to_blob(ImageFormat.Jpeg, prms))
+    }
+    compactor.join
+    GC.compact
+
+    assert_equal(4, pathdata.Points.size)
+    assert_equal(1, prms.Param.size)
+    assert_equal(2, buf.size)
+  end
+
+  def test_init_profile
+    Bitmap.new(1, 1)
+    prof = Gdiplus.init_profile
+    assert_equal("Init_codec", prof.keys.first) if RUBY_VERSION >= "1.9"
+    %w(Init_codec Init_enum Init_color Init_langid Init_pipeline GdiplusStartup).each {|name|
+      assert(prof.key?(name), name)
+      assert_kind_of(Float, prof[name][:usec])
+      assert_operator(prof[name][:usec], :>=, 0)
+      assert_kind_of(Integer, prof[name][:objects])
+    }
+  end
+
+  def test_trace
+    assert(!Gdiplus.trace?)
+    if Gdiplus::TRACE_BUILD
+      Gdiplus.trace = true
+      begin
+        assert(Gdiplus.trace?)
+        Pen.new(Color.Red, 2).dispose
+        Matrix.new.dispose
+      ensure
+        Gdiplus.trace = false
+      end
+    else
+      _assert_stderr(/--enable-trace/, false) { Gdiplus.trace = true }
+      assert(!Gdiplus.trace?)
+    end
+  end
 end
 
 __END__